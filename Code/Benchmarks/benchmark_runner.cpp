@@ -0,0 +1,129 @@
+/**
+ * benchmark_runner.cpp
+ * Implementation of BenchmarkRunner class.
+ */
+
+#include "benchmark_runner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+namespace zpr {
+
+    /**
+     * Parametrized constructor of BenchmarkRunner class.
+     * @param min_time - Minimal time of one repetition in milliseconds.
+     * @param repetitions - Number of measured repetitions of every case.
+     */
+    BenchmarkRunner::BenchmarkRunner(double min_time, int repetitions) : minTime_(min_time), repetitions_(std::max(1, repetitions)) {}
+
+    /**
+     * Method registering benchmark case.
+     * @param name - Name of the measured operation.
+     * @param params - Parameters of the case.
+     * @param items - Units of work done in one iteration.
+     * @param setup - Function preparing data of the case and returning measured operation.
+     */
+    void BenchmarkRunner::add(const std::string& name, const BenchmarkParams& params, long items, std::function<BenchmarkBody()> setup)
+    {
+        this->cases_.push_back(BenchmarkCase{name, params, items, setup});
+    }
+
+    /**
+     * Method returning name of the case with its parameters, eg. "vehicle_move/grid:64/vehicles:128".
+     * @param name - Name of the measured operation.
+     * @param params - Parameters of the case.
+     * @return - Full name of the case.
+     */
+    std::string BenchmarkRunner::getFullName(const std::string& name, const BenchmarkParams& params)
+    {
+        std::string full_name = name;
+        for (const std::pair<std::string, int>& param : params) {
+            full_name += "/" + param.first + ":" + std::to_string(param.second);
+        }
+        return full_name;
+    }
+
+    /**
+     * Method running every case which full name contains the filter and printing results.
+     * @param filter - Part of the full name, empty runs every case.
+     * @param log - Stream for human readable results.
+     */
+    void BenchmarkRunner::run(const std::string& filter, std::ostream& log)
+    {
+        log << std::left << std::setw(52) << "Benchmark" << std::right << std::setw(14) << "ns/iter"
+            << std::setw(14) << "ns/item" << std::setw(12) << "iterations" << "\n";
+        for (const BenchmarkCase& benchmark_case : this->cases_) {
+            std::string full_name = getFullName(benchmark_case.name_, benchmark_case.params_);
+            if (full_name.find(filter) == std::string::npos) {
+                continue;
+            }
+            BenchmarkResult result = this->runCase(benchmark_case);
+            log << std::left << std::setw(52) << full_name << std::right << std::fixed << std::setprecision(1)
+                << std::setw(14) << result.median_ << std::setw(14) << result.median_ / std::max(1L, result.items_)
+                << std::setw(12) << result.iterations_ << std::endl;
+            this->results_.push_back(result);
+        }
+    }
+
+    /**
+     * Method measuring one case.
+     * @param benchmark_case - Measured case.
+     * @return - Result of the case.
+     */
+    BenchmarkResult BenchmarkRunner::runCase(const BenchmarkCase& benchmark_case)
+    {
+        BenchmarkBody body = benchmark_case.setup_();
+        auto measure = [&](long iterations) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            body(iterations);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count();
+        };
+        long iterations = 1;
+        double elapsed = measure(iterations);
+        while (elapsed < this->minTime_ && iterations < (1L << 40)) {
+            double scale = elapsed > 0 ? this->minTime_ / elapsed * 1.2 : 10.0;
+            iterations = static_cast<long>(iterations * std::min(10.0, std::max(2.0, scale)));
+            elapsed = measure(iterations);
+        }
+        std::vector<double> times;
+        for (int i = 0; i < this->repetitions_; i++) {
+            times.push_back(measure(iterations) * 1e6 / iterations);
+        }
+        std::sort(times.begin(), times.end());
+        return BenchmarkResult{benchmark_case.name_, benchmark_case.params_, iterations, benchmark_case.items_,
+                               times[times.size() / 2], times.front(), times.back()};
+    }
+
+    /**
+     * Method writing results as JSON.
+     * @param stream - Output stream.
+     */
+    void BenchmarkRunner::writeJson(std::ostream& stream) const
+    {
+        stream << "{\"benchmarks\":[";
+        for (std::size_t i = 0; i < this->results_.size(); i++) {
+            const BenchmarkResult& result = this->results_[i];
+            stream << (i == 0 ? "" : ",") << "\n{\"name\":\"" << getFullName(result.name_, result.params_)
+                   << "\",\"operation\":\"" << result.name_ << "\",\"params\":{";
+            for (std::size_t j = 0; j < result.params_.size(); j++) {
+                stream << (j == 0 ? "" : ",") << "\"" << result.params_[j].first << "\":" << result.params_[j].second;
+            }
+            stream << std::fixed << std::setprecision(3) << "},\"iterations\":" << result.iterations_
+                   << ",\"items_per_iteration\":" << result.items_ << ",\"ns_per_iteration\":" << result.median_
+                   << ",\"ns_per_iteration_min\":" << result.min_ << ",\"ns_per_iteration_max\":" << result.max_
+                   << ",\"ns_per_item\":" << result.median_ / std::max(1L, result.items_) << "}";
+        }
+        stream << "\n]}\n";
+    }
+
+    /**
+     * Method returning results of cases which already ran.
+     * @return - Results.
+     */
+    const std::vector<BenchmarkResult>& BenchmarkRunner::getResults() const
+    {
+        return this->results_;
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * benchmark_runner.hpp
+ * Header of BenchmarkRunner class and doNotOptimize function.
+ */
+
+#pragma once
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace zpr {
+
+    /**
+     * Function which makes the compiler think value is used, so measured code is not removed.
+     * @param value - Value computed by measured code.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * Parameters of one benchmark case, eg. {"grid", 64}, {"vehicles", 128}.
+     */
+    using BenchmarkParams = std::vector<std::pair<std::string, int>>;
+
+    /**
+     * Measured operation. It is called with number of iterations to run.
+     */
+    using BenchmarkBody = std::function<void(long iterations)>;
+
+    /**
+     * Struct with result of one benchmark case. Times are nanoseconds per iteration, items are units of work
+     * (eg. vehicles moved) done in one iteration.
+     */
+    struct BenchmarkResult {
+        std::string name_;
+        BenchmarkParams params_;
+        long iterations_;
+        long items_;
+        double median_, min_, max_;
+    };
+
+    /**
+     * Class responsible for running registered benchmark cases. Every case is prepared only when it runs, its number
+     * of iterations is raised until one repetition takes at least minimal time, then median of repetitions is reported.
+     */
+    class BenchmarkRunner {
+    public:
+        BenchmarkRunner(double min_time, int repetitions);
+        void add(const std::string& name, const BenchmarkParams& params, long items, std::function<BenchmarkBody()> setup);
+        void run(const std::string& filter, std::ostream& log);
+        void writeJson(std::ostream& stream) const;
+        const std::vector<BenchmarkResult>& getResults() const;
+    private:
+        struct BenchmarkCase {
+            std::string name_;
+            BenchmarkParams params_;
+            long items_;
+            std::function<BenchmarkBody()> setup_;
+        };
+        static std::string getFullName(const std::string& name, const BenchmarkParams& params);
+        BenchmarkResult runCase(const BenchmarkCase& benchmark_case);
+        double minTime_;
+        int repetitions_;
+        std::vector<BenchmarkCase> cases_;
+        std::vector<BenchmarkResult> results_;
+    };
+}
@@ -0,0 +1,366 @@
+/**
+ * micro_benchmarks.cpp
+ * Microbenchmarks of simulation and editor hot paths.
+ */
+
+#include "benchmark_runner.hpp"
+#include "../vehicles/car.hpp"
+#include "../components/camera.hpp"
+#include "../components/cell.hpp"
+#include "../components/packed_vehicles.hpp"
+#include "../helpers/converter.hpp"
+#include "../helpers/road_builder_helper.hpp"
+#include "../helpers/command_line.hpp"
+#include "../subjects/creator_subject.hpp"
+#include "../simulator.hpp"
+#include "../definitions.hpp"
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+
+namespace {
+
+    const int SEED = 2021;
+    const char* DIRECTIONS[] = {"North", "South", "East", "West"};
+
+    /**
+     * Struct with road network covering whole grid and vehicles standing on random roads, in world units.
+     */
+    struct Traffic {
+        Traffic(int grid_size, int vehicles_count) : gridSize_(grid_size), engine_(SEED)
+        {
+            zpr::Converter converter(grid_size, WORLD_CELL_SIZE);
+            for (int row = 0; row < grid_size; row++) {
+                for (int col = 0; col < grid_size; col++) {
+                    this->roads_.push_back(converter.convertCellToCenteredBox(zpr::Cell(row, col), "User"));
+                }
+            }
+            for (int i = 0; i < vehicles_count; i++) {
+                std::shared_ptr<zpr::Vehicle> vehicle = std::make_shared<zpr::Car>(0, 0, WORLD_CELL_SIZE, this->roads_, "East");
+                this->respawn(*vehicle);
+                this->vehicles_.push_back(vehicle);
+            }
+        }
+
+        /**
+         * Method putting vehicle in the center of random road.
+         * @param vehicle - Vehicle to put.
+         */
+        void respawn(zpr::Vehicle& vehicle)
+        {
+            std::uniform_int_distribution<std::size_t> road_dist(0, this->roads_.size() - 1);
+            std::uniform_int_distribution<int> direction_dist(0, 3);
+            sf::Vector2f center = this->roads_[road_dist(this->engine_)].getPosition();
+            vehicle.reset(center.x, center.y, DIRECTIONS[direction_dist(this->engine_)], this->engine_());
+        }
+
+        /**
+         * Method checking if vehicle left the road network.
+         * @param vehicle - Vehicle to check.
+         * @return - True if vehicle is outside the grid, false otherwise.
+         */
+        bool isOutside(const zpr::Vehicle& vehicle) const
+        {
+            int size = this->gridSize_ * WORLD_CELL_SIZE;
+            return vehicle.x_ < 0 || vehicle.y_ < 0 || vehicle.x_ >= size || vehicle.y_ >= size;
+        }
+
+        int gridSize_;
+        std::mt19937 engine_;
+        std::vector<zpr::AABB> roads_;
+        std::vector<std::shared_ptr<zpr::Vehicle>> vehicles_;
+    };
+
+    /**
+     * Struct with cells of the grid, every second one (in random order) contains road.
+     */
+    struct Cells {
+        Cells(int grid_size)
+        {
+            std::mt19937 engine(SEED);
+            std::bernoulli_distribution has_road(0.5);
+            for (int row = 0; row < grid_size; row++) {
+                for (int col = 0; col < grid_size; col++) {
+                    zpr::Cell cell(row, col);
+                    cell.containsRoad_ = has_road(engine);
+                    this->cells_.push_back(cell);
+                    if (cell.containsRoad_) {
+                        this->roadCells_.push_back(cell);
+                    }
+                }
+            }
+        }
+        std::vector<zpr::Cell> cells_, roadCells_;
+    };
+
+    /**
+     * Observer which only counts received cells, like the cheapest possible view.
+     */
+    struct CellsCounter : public zpr::CreatorObserver {
+        void updateCells(std::vector<zpr::Cell> cells) override
+        {
+            this->count_ += cells.size();
+        }
+        std::size_t count_ = 0;
+    };
+
+    /**
+     * Function registering moving vehicles: finding current road, moving and choosing turns.
+     * @param runner - Benchmark runner.
+     */
+    void addVehicleMoveBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 64, 256}) {
+            for (int vehicles_count : {16, 128, 1024}) {
+                runner.add("vehicle_move", {{"grid", grid_size}, {"vehicles", vehicles_count}}, vehicles_count, [=]() {
+                    std::shared_ptr<Traffic> traffic = std::make_shared<Traffic>(grid_size, vehicles_count);
+                    return [traffic](long iterations) {
+                        for (long i = 0; i < iterations; i++) {
+                            for (const std::shared_ptr<zpr::Vehicle>& vehicle : traffic->vehicles_) {
+                                vehicle->checkOnWhichCell();
+                                vehicle->move();
+                                vehicle->checkTurn();
+                                if (traffic->isOutside(*vehicle)) {
+                                    traffic->respawn(*vehicle);
+                                }
+                            }
+                        }
+                    };
+                });
+            }
+        }
+    }
+
+    /**
+     * Function registering checking collisions of every pair of vehicles.
+     * @param runner - Benchmark runner.
+     */
+    void addCollisionBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 64}) {
+            for (int vehicles_count : {16, 128, 1024}) {
+                long pairs = static_cast<long>(vehicles_count) * vehicles_count;
+                runner.add("pairwise_collision", {{"grid", grid_size}, {"vehicles", vehicles_count}}, pairs, [=]() {
+                    std::shared_ptr<Traffic> traffic = std::make_shared<Traffic>(grid_size, vehicles_count);
+                    return [traffic](long iterations) {
+                        int collisions = 0;
+                        for (long i = 0; i < iterations; i++) {
+                            for (const std::shared_ptr<zpr::Vehicle>& vehicle : traffic->vehicles_) {
+                                for (const std::shared_ptr<zpr::Vehicle>& other : traffic->vehicles_) {
+                                    collisions += vehicle->checkColision(other);
+                                }
+                            }
+                        }
+                        zpr::doNotOptimize(collisions);
+                    };
+                });
+            }
+        }
+    }
+
+    /**
+     * Function registering checking collisions of every vehicle with shapes kept in packed arrays, with AVX2 kernels
+     * (where the processor has them) and with plain loops.
+     * @param runner - Benchmark runner.
+     */
+    void addPackedCollisionBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int is_avx2 : {1, 0}) {
+            for (int vehicles_count : {16, 128, 1024}) {
+                long pairs = static_cast<long>(vehicles_count) * vehicles_count;
+                runner.add("packed_collision", {{"avx2", is_avx2}, {"vehicles", vehicles_count}}, pairs, [=]() {
+                    std::shared_ptr<Traffic> traffic = std::make_shared<Traffic>(64, vehicles_count);
+                    std::shared_ptr<zpr::PackedVehicles> packed = std::make_shared<zpr::PackedVehicles>();
+                    packed->setAvx2(is_avx2);
+                    packed->resize(traffic->vehicles_.size());
+                    for (std::size_t i = 0; i < traffic->vehicles_.size(); i++) {
+                        packed->setShape(i, traffic->vehicles_[i]->getShape());
+                    }
+                    return [traffic, packed](long iterations) {
+                        std::size_t collisions = 0;
+                        for (long i = 0; i < iterations; i++) {
+                            for (const std::shared_ptr<zpr::Vehicle>& vehicle : traffic->vehicles_) {
+                                collisions += packed->findColision(vehicle->colisionBox_, vehicle->getShape().getPosition());
+                            }
+                        }
+                        zpr::doNotOptimize(collisions);
+                    };
+                });
+            }
+        }
+    }
+
+    /**
+     * Function registering checking which of three cameras see vehicles.
+     * @param runner - Benchmark runner.
+     */
+    void addCameraBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 64}) {
+            for (int vehicles_count : {16, 128, 1024}) {
+                runner.add("camera_check", {{"grid", grid_size}, {"vehicles", vehicles_count}}, 3L * vehicles_count, [=]() {
+                    std::shared_ptr<Traffic> traffic = std::make_shared<Traffic>(grid_size, vehicles_count);
+                    std::shared_ptr<std::vector<zpr::Camera>> cameras = std::make_shared<std::vector<zpr::Camera>>();
+                    for (int i = 1; i <= 3; i++) {
+                        cameras->push_back(zpr::Camera(i, traffic->roads_[traffic->roads_.size() * i / 4]));
+                    }
+                    return [traffic, cameras](long iterations) {
+                        int seen = 0;
+                        for (long i = 0; i < iterations; i++) {
+                            for (const std::shared_ptr<zpr::Vehicle>& vehicle : traffic->vehicles_) {
+                                for (const zpr::Camera& camera : *cameras) {
+                                    seen += camera.checkColision(vehicle);
+                                }
+                            }
+                        }
+                        zpr::doNotOptimize(seen);
+                    };
+                });
+            }
+        }
+    }
+
+    /**
+     * Function registering choosing textures of roads drawn in the editor.
+     * @param runner - Benchmark runner.
+     */
+    void addRoadTexturesBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 32, 64}) {
+            Cells cells(grid_size);
+            long roads_count = cells.roadCells_.size();
+            runner.add("road_textures", {{"grid", grid_size}, {"roads", static_cast<int>(roads_count)}}, roads_count, [=]() {
+                zpr::SimulatorDataRef data = std::make_shared<zpr::SimulatorData>();
+                data->assets_.loadTexture("Road", STREET_TEXTURE);
+                data->assets_.loadTexture("Turn", TURN_TEXTURE);
+                data->assets_.loadTexture("T_Intersection", T_INTERSECTION_TEXTURE);
+                data->assets_.loadTexture("Intersection", INTERSECTION_TEXTURE);
+                std::shared_ptr<zpr::RoadBuilderHelper> helper = std::make_shared<zpr::RoadBuilderHelper>(data, grid_size);
+                std::shared_ptr<std::vector<sf::RectangleShape>> roads = std::make_shared<std::vector<sf::RectangleShape>>();
+                zpr::Converter converter(grid_size);
+                for (const zpr::Cell& cell : cells.roadCells_) {
+                    roads->push_back(converter.convertCellToCenteredRectShape(cell, "User"));
+                }
+                return [data, helper, roads](long iterations) {
+                    for (long i = 0; i < iterations; i++) {
+                        helper->checkRoadsTexture(*roads);
+                    }
+                };
+            });
+        }
+    }
+
+    /**
+     * Function registering conversions between cells, pixels and boxes.
+     * @param runner - Benchmark runner.
+     */
+    void addConverterBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 64, 256, 1024}) {
+            long cells_count = static_cast<long>(grid_size) * grid_size;
+            runner.add("converter", {{"grid", grid_size}}, cells_count, [=]() {
+                std::shared_ptr<zpr::Converter> converter = std::make_shared<zpr::Converter>(grid_size);
+                return [converter, grid_size](long iterations) {
+                    float sum = 0;
+                    for (long i = 0; i < iterations; i++) {
+                        for (int row = 0; row < grid_size; row++) {
+                            for (int col = 0; col < grid_size; col++) {
+                                sf::Vector2f pixels = converter->transformRowColToPixels(sf::Vector2i(col, row));
+                                sum += converter->transformPixelsToRowCol(pixels.x);
+                                sum += converter->convertCellToCenteredBox(zpr::Cell(row, col), "User").left_;
+                            }
+                        }
+                    }
+                    zpr::doNotOptimize(sum);
+                };
+            });
+        }
+    }
+
+    /**
+     * Function registering saving cells to stream and loading them back, as done with map files.
+     * @param runner - Benchmark runner.
+     */
+    void addCellStreamBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 64, 256}) {
+            long cells_count = static_cast<long>(grid_size) * grid_size;
+            runner.add("cell_stream", {{"grid", grid_size}}, cells_count, [=]() {
+                std::shared_ptr<Cells> cells = std::make_shared<Cells>(grid_size);
+                return [cells](long iterations) {
+                    std::size_t loaded = 0;
+                    for (long i = 0; i < iterations; i++) {
+                        std::stringstream stream;
+                        for (const zpr::Cell& cell : cells->cells_) {
+                            stream << cell;
+                        }
+                        zpr::Cell cell;
+                        while (stream >> cell) {
+                            loaded++;
+                        }
+                    }
+                    zpr::doNotOptimize(loaded);
+                };
+            });
+        }
+    }
+
+    /**
+     * Function registering sending cells of the grid to every observer of the editor.
+     * @param runner - Benchmark runner.
+     */
+    void addNotifyCellsBenchmarks(zpr::BenchmarkRunner& runner)
+    {
+        for (int grid_size : {16, 64, 256}) {
+            for (int observers_count : {1, 4, 16}) {
+                runner.add("notify_cells", {{"grid", grid_size}, {"observers", observers_count}}, observers_count, [=]() {
+                    std::shared_ptr<Cells> cells = std::make_shared<Cells>(grid_size);
+                    std::shared_ptr<zpr::CreatorSubject> subject = std::make_shared<zpr::CreatorSubject>();
+                    for (int i = 0; i < observers_count; i++) {
+                        subject->add(std::make_shared<CellsCounter>());
+                    }
+                    return [cells, subject](long iterations) {
+                        for (long i = 0; i < iterations; i++) {
+                            subject->notifyCells(cells->roadCells_);
+                        }
+                    };
+                });
+            }
+        }
+    }
+}
+
+/**
+ * Main function of microbenchmarks. Options: "--filter <text>" runs only cases which names contain the text,
+ * "--json <file>" writes results to the file, "--min-time <ms>" and "--repetitions <n>" change measuring.
+ */
+int main(int argc, char* argv[])
+{
+    std::string filter = zpr::CommandLine::getOptionValue(argc, argv, "--filter", "ZPR_BENCHMARK_FILTER");
+    std::string json_path = zpr::CommandLine::getOptionValue(argc, argv, "--json", "ZPR_BENCHMARK_JSON");
+    std::string min_time = zpr::CommandLine::getOptionValue(argc, argv, "--min-time", "ZPR_BENCHMARK_MIN_TIME");
+    std::string repetitions = zpr::CommandLine::getOptionValue(argc, argv, "--repetitions", "ZPR_BENCHMARK_REPETITIONS");
+
+    zpr::BenchmarkRunner runner(min_time.empty() ? 100.0 : std::stod(min_time), repetitions.empty() ? 5 : std::stoi(repetitions));
+    addVehicleMoveBenchmarks(runner);
+    addCollisionBenchmarks(runner);
+    addPackedCollisionBenchmarks(runner);
+    addCameraBenchmarks(runner);
+    addRoadTexturesBenchmarks(runner);
+    addConverterBenchmarks(runner);
+    addCellStreamBenchmarks(runner);
+    addNotifyCellsBenchmarks(runner);
+    runner.run(filter, std::cout);
+
+    if (!json_path.empty()) {
+        std::ofstream file(json_path);
+        runner.writeJson(file);
+        if (!file) {
+            std::cerr << "Could not write benchmark results to " << json_path << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
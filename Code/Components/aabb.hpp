@@ -0,0 +1,106 @@
+/**
+ * aabb.hpp
+ * Header of AABB structure.
+ */
+
+#pragma once
+#include <type_traits>
+#include <algorithm>
+#include "SFML/System.hpp"
+
+namespace zpr {
+
+    /**
+     * Plain axis-aligned box used by the simulation instead of sf::RectangleShape. It has the same rules as sf::Rect:
+     * left and top edges belong to the box, right and bottom ones do not. SFML shapes are made from it only when drawing.
+     */
+    struct AABB
+    {
+        AABB() = default;
+
+        /**
+         * Parametrized constructor of AABB struct.
+         * @param left - Left edge.
+         * @param top - Top edge.
+         * @param right - Right edge.
+         * @param bottom - Bottom edge.
+         */
+        AABB(float left, float top, float right, float bottom) : left_(left), top_(top), right_(right), bottom_(bottom) {}
+
+        /**
+         * Method creating box with given center and size.
+         * @param center_x - Position x of the center.
+         * @param center_y - Position y of the center.
+         * @param width - Width of the box.
+         * @param height - Height of the box.
+         * @return - Created box.
+         */
+        static AABB fromCenter(float center_x, float center_y, float width, float height)
+        {
+            return AABB(center_x - width / 2, center_y - height / 2, center_x + width / 2, center_y + height / 2);
+        }
+
+        /**
+         * Method returning center of the box (the same point as position of centered sf::RectangleShape).
+         * @return - Center of the box.
+         */
+        sf::Vector2f getPosition() const
+        {
+            return sf::Vector2f((this->left_ + this->right_) / 2, (this->top_ + this->bottom_) / 2);
+        }
+
+        /**
+         * Method returning size of the box.
+         * @return - Width and height of the box.
+         */
+        sf::Vector2f getSize() const
+        {
+            return sf::Vector2f(this->right_ - this->left_, this->bottom_ - this->top_);
+        }
+
+        /**
+         * Method moving the box so that its center is in given point. Size is not changed.
+         * @param center_x - New position x of the center.
+         * @param center_y - New position y of the center.
+         */
+        void moveCenterTo(float center_x, float center_y)
+        {
+            *this = fromCenter(center_x, center_y, this->right_ - this->left_, this->bottom_ - this->top_);
+        }
+
+        /**
+         * Method checking if point is inside the box.
+         * @param point - Point to check.
+         * @return - True if point is inside, false otherwise.
+         */
+        bool contains(sf::Vector2f point) const
+        {
+            return point.x >= this->left_ && point.x < this->right_ && point.y >= this->top_ && point.y < this->bottom_;
+        }
+
+        /**
+         * Method checking if two boxes overlap. Boxes which only touch each other do not overlap.
+         * @param other - Second box.
+         * @return - True if boxes overlap, false otherwise.
+         */
+        bool intersects(const AABB& other) const
+        {
+            return std::max(this->left_, other.left_) < std::min(this->right_, other.right_)
+                && std::max(this->top_, other.top_) < std::min(this->bottom_, other.bottom_);
+        }
+
+        bool operator==(const AABB& other) const
+        {
+            return this->left_ == other.left_ && this->top_ == other.top_ && this->right_ == other.right_ && this->bottom_ == other.bottom_;
+        }
+
+        bool operator!=(const AABB& other) const
+        {
+            return !(*this == other);
+        }
+
+        float left_, top_, right_, bottom_;
+    };
+
+    static_assert(std::is_trivial<AABB>::value && std::is_standard_layout<AABB>::value, "AABB has to stay a POD type");
+}
@@ -11,20 +11,29 @@ namespace zpr {
      * @param camera_number - Camera number.
      * @param detection_box - Area which camera sees.
      */
-    Camera::Camera(int camera_number, sf::RectangleShape detection_box) : cameraNumber_(camera_number), cameraDetectionBox_(detection_box) {}
+    Camera::Camera(int camera_number, AABB detection_box) : cameraNumber_(camera_number), cameraDetectionBox_(detection_box) {}
 
     /**
      * Method which checks if a vehicle is visible for camera.
      * @param vehicle - Vehicle which method is checking.
      * @return - True if camera detects vehicle, false otherwise.
      */
-    bool Camera::checkColision(std::shared_ptr<Vehicle> vehicle)
+    bool Camera::checkColision(const std::shared_ptr<Vehicle>& vehicle) const
     {
-        if(this->cameraDetectionBox_.getGlobalBounds().contains(vehicle->getShape().getPosition())) {
+        if(this->cameraDetectionBox_.contains(vehicle->getShape().getPosition())) {
             return true;
         }
         else {
             return false;
         }
     }
+
+    /**
+     * Method returning area which camera sees.
+     * @return - Detection box of the camera.
+     */
+    const AABB& Camera::getDetectionBox() const
+    {
+        return this->cameraDetectionBox_;
+    }
 }
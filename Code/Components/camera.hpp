@@ -16,11 +16,12 @@ namespace zpr {
 	class Camera
 	{
 	public:
-		Camera(int camera_number, sf::RectangleShape detection_box);
-		bool checkColision(std::shared_ptr<Vehicle> vehicle);
+		Camera(int camera_number, AABB detection_box);
+		bool checkColision(const std::shared_ptr<Vehicle>& vehicle) const;
+		const AABB& getDetectionBox() const;
 		int cameraNumber_;
 	private:
-		sf::RectangleShape cameraDetectionBox_;
+		AABB cameraDetectionBox_;
 	};
 }
 
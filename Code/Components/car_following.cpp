@@ -0,0 +1,101 @@
+/**
+ * car_following.cpp
+ * Implementation of CarFollowing class.
+ */
+
+#include "car_following.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace zpr {
+
+    /**
+     * Parametrized constructor of CarFollowing class. It prepares room for every vehicle of the simulation, so
+     * updates do not allocate memory.
+     * @param max_vehicles - Maximal number of vehicles in the simulation.
+     */
+    CarFollowing::CarFollowing(std::size_t max_vehicles)
+    {
+        for (std::vector<float>* field : {&this->speeds_, &this->maxSpeeds_, &this->gaps_, &this->leaderSpeeds_, &this->distances_}) {
+            field->reserve(max_vehicles);
+        }
+    }
+
+    /**
+     * Method setting number of vehicles of the next update.
+     * @param count - Number of vehicles.
+     */
+    void CarFollowing::resize(std::size_t count)
+    {
+        for (std::vector<float>* field : {&this->speeds_, &this->maxSpeeds_, &this->gaps_, &this->leaderSpeeds_, &this->distances_}) {
+            field->resize(count);
+        }
+    }
+
+    /**
+     * Method setting state of the vehicle before the update.
+     * @param vehicle - Index of the vehicle.
+     * @param speed - Current speed in world units per tick.
+     * @param max_speed - Speed the vehicle wants to drive with on a free road.
+     * @param gap - Distance to the leader in world units, a big number if there is none.
+     * @param leader_speed - Speed of the leader along the direction of the vehicle.
+     */
+    void CarFollowing::setVehicle(std::size_t vehicle, float speed, float max_speed, float gap, float leader_speed)
+    {
+        this->speeds_[vehicle] = speed;
+        this->maxSpeeds_[vehicle] = max_speed;
+        this->gaps_[vehicle] = gap;
+        this->leaderSpeeds_[vehicle] = leader_speed;
+    }
+
+    /**
+     * Method computing new speeds of all vehicles and distances they drive in the time step. Speed changes by the
+     * acceleration of the model times the time step, but stays between 0 and the maximal speed, and the distance
+     * is cut to the gap, in which case the speed drops to what covers that distance.
+     * @param time_step - Time step in ticks.
+     */
+    void CarFollowing::update(float time_step)
+    {
+        const float braking = 2 * std::sqrt(IDM_ACCELERATION * IDM_DECELERATION);
+        std::size_t count = this->speeds_.size();
+        float* speeds = this->speeds_.data();
+        const float* max_speeds = this->maxSpeeds_.data();
+        const float* gaps = this->gaps_.data();
+        const float* leader_speeds = this->leaderSpeeds_.data();
+        float* distances = this->distances_.data();
+        for (std::size_t i = 0; i < count; i++) {
+            float speed = speeds[i];
+            float max_speed = std::max(max_speeds[i], 0.01f);
+            float gap = std::max(gaps[i], 0.0f);
+            float desired_gap = IDM_MIN_GAP + std::max(speed * IDM_TIME_HEADWAY + speed * (speed - leader_speeds[i]) / braking, 0.0f);
+            float speed_ratio = speed / max_speed;
+            speed_ratio *= speed_ratio;
+            float gap_ratio = desired_gap / std::max(gap, 0.01f);
+            float acceleration = IDM_ACCELERATION * (1 - speed_ratio * speed_ratio - gap_ratio * gap_ratio);
+            float new_speed = std::min(std::max(speed + acceleration * time_step, 0.0f), max_speed);
+            float distance = (speed + new_speed) * 0.5f * time_step;
+            speeds[i] = distance > gap ? gap / time_step : new_speed;
+            distances[i] = std::min(distance, gap);
+        }
+    }
+
+    /**
+     * Method returning speed of the vehicle after the update.
+     * @param vehicle - Index of the vehicle.
+     * @return - Speed in world units per tick.
+     */
+    float CarFollowing::getSpeed(std::size_t vehicle) const
+    {
+        return this->speeds_[vehicle];
+    }
+
+    /**
+     * Method returning distance driven by the vehicle in the update.
+     * @param vehicle - Index of the vehicle.
+     * @return - Distance in world units.
+     */
+    float CarFollowing::getDistance(std::size_t vehicle) const
+    {
+        return this->distances_[vehicle];
+    }
+}
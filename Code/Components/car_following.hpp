@@ -0,0 +1,32 @@
+/**
+ * car_following.hpp
+ * Header of CarFollowing class.
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Class computing speeds of vehicles with the Intelligent Driver Model. A vehicle speeds up with IDM_ACCELERATION
+     * on a free road and brakes as the gap to its leader gets close to the desired gap: IDM_MIN_GAP plus
+     * IDM_TIME_HEADWAY ticks of driving, plus more when it is faster than the leader. Speeds are integrated over the
+     * time step and a vehicle never drives further than its gap, so long time steps do not make vehicles overlap
+     * or oscillate. Fields of vehicles are kept in separate arrays and update() is one loop without branches, which
+     * the compiler vectorises.
+     */
+    class CarFollowing {
+    public:
+        CarFollowing(std::size_t max_vehicles);
+        void resize(std::size_t count);
+        void setVehicle(std::size_t vehicle, float speed, float max_speed, float gap, float leader_speed);
+        void update(float time_step);
+        float getSpeed(std::size_t vehicle) const;
+        float getDistance(std::size_t vehicle) const;
+    private:
+        std::vector<float> speeds_, maxSpeeds_, gaps_, leaderSpeeds_, distances_;
+    };
+}
@@ -27,11 +27,20 @@ namespace zpr {
      * Method returning cell position with row and column.
      * @return - Cell position presented by row and column.
      */
-	sf::Vector2i Cell::getPosition()
+	sf::Vector2i Cell::getPosition() const
 	{
 		return sf::Vector2i(this->row_, this->column_);
 	}
     
+    /**
+     * Method checking if cell holds anything worth storing (road, camera, pending deletion or starting cell).
+     * @return - True if cell is in its default state, false otherwise.
+     */
+    bool Cell::isEmpty() const
+    {
+        return !(this->containsRoad_ || this->toDelete_ || this->isStartingCell_ || this->containsCamera_ || this->cameraToDelete_);
+    }
+    
     /**
      * Method handling data from istream.
      * @param in - Istream from which data is taken.
@@ -60,7 +69,7 @@ namespace zpr {
      * @return - Ofstream to where data is passed.
      */
     std::ofstream& operator<< (std::ofstream& os, const Cell& current_cell){
-        os << current_cell.row_ <<" "<< current_cell.column_<<" "<<current_cell.containsRoad_<<std::endl;
+        os << current_cell.row_ <<" "<< current_cell.column_<<" "<<current_cell.containsRoad_<<"\n";
         return os;
     }
 
@@ -71,7 +80,7 @@ namespace zpr {
      * @return - Ofstream to where data is passed.
      */
     std::ostream& operator<< (std::ostream& os, const Cell& current_cell){
-        os << current_cell.row_ <<" "<< current_cell.column_<<" "<<current_cell.containsRoad_<<std::endl;
+        os << current_cell.row_ <<" "<< current_cell.column_<<" "<<current_cell.containsRoad_<<"\n";
         return os;
     }
 
@@ -17,7 +17,8 @@ namespace zpr {
 	public:
 		Cell(int row, int column);
         Cell();
-		sf::Vector2i getPosition();
+		sf::Vector2i getPosition() const;
+        bool isEmpty() const;
         bool containsRoad_, toDelete_, roadDrawn_, isStartingCell_, containsCamera_, cameraDrawn_, cameraToDelete_;
         int whichCamera_;
         std::istream& load(std::istream& is);
@@ -0,0 +1,452 @@
+/**
+ * cellular_automaton.cpp
+ * Implementation of CellularAutomaton class.
+ */
+
+#include "cellular_automaton.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Opposite directions of directions North, South, East and West.
+         */
+        const int oppositeDirections[4] = {1, 0, 3, 2};
+
+        /**
+         * Moves by one unit in directions North, South, East and West.
+         */
+        const sf::Vector2f directionSteps[4] = {sf::Vector2f(0, -1), sf::Vector2f(0, 1), sf::Vector2f(1, 0), sf::Vector2f(-1, 0)};
+    }
+
+    /**
+     * Parametrized constructor of CellularAutomaton class. It finds neighbouring roads of every road, cameras watching
+     * roads and roads with exit sites, and prepares room for every vehicle of the simulation, so ticks do not
+     * allocate memory.
+     * @param roads - Roads of the simulation (not copied, they have to outlive the automaton).
+     * @param cameras - Cameras of the simulation, a camera watches the road in its detection box.
+     * @param exit_sites - Boxes in which vehicles leave the city.
+     * @param cell_size - Size of a cell in world units.
+     * @param lane_offset - Distance of lanes from the middle of the road, in world units.
+     * @param speed - Speed of vehicles in world units per tick.
+     * @param unblock_ticks - Number of ticks a vehicle stands before it turns back.
+     * @param max_vehicles - Maximal number of vehicles in the simulation.
+     * @param seed - Seed of random slowdowns and directions drawn by vehicles.
+     */
+    CellularAutomaton::CellularAutomaton(const std::vector<AABB>& roads, const std::vector<Camera>& cameras, const std::vector<AABB>& exit_sites,
+                                         int cell_size, int lane_offset, int speed, int unblock_ticks, std::size_t max_vehicles, unsigned seed) :
+        roads_(&roads), cellSize_(cell_size), laneOffset_(lane_offset),
+        stepTicks_(std::max(1, static_cast<int>(std::lround(CA_MAX_SPEED * cell_size / static_cast<double>(CA_CELL_SITES * std::max(speed, 1)))))),
+        engine_(seed), exitSites_(exit_sites)
+    {
+        this->unblockSteps_ = std::max(1, unblock_ticks / this->stepTicks_);
+        std::map<std::pair<float, float>, int> cells;
+        for (std::size_t i = 0; i < roads.size(); i++) {
+            cells.emplace(std::make_pair(roads[i].getPosition().x, roads[i].getPosition().y), i);
+        }
+        this->neighbours_.assign(roads.size(), {-1, -1, -1, -1});
+        this->roadCameras_.assign(roads.size(), 0);
+        this->isExitRoad_.assign(roads.size(), false);
+        for (std::size_t i = 0; i < roads.size(); i++) {
+            for (int direction = 0; direction < 4; direction++) {
+                sf::Vector2f position = roads[i].getPosition() + directionSteps[direction] * static_cast<float>(cell_size);
+                std::map<std::pair<float, float>, int>::const_iterator cell = cells.find(std::make_pair(position.x, position.y));
+                if (cell != cells.end()) {
+                    this->neighbours_[i][direction] = cell->second;
+                }
+            }
+            for (const Camera& camera : cameras) {
+                if (camera.getDetectionBox().contains(roads[i].getPosition())) {
+                    this->roadCameras_[i] = camera.cameraNumber_;
+                }
+            }
+            for (const AABB& exit_site : exit_sites) {
+                if (exit_site.intersects(roads[i])) {
+                    this->isExitRoad_[i] = true;
+                }
+            }
+        }
+        this->sites_.assign(4 * CA_CELL_SITES * roads.size(), 0);
+        for (std::vector<int>* field : {&this->vehicleRoads_, &this->directions_, &this->nextDirections_, &this->positions_,
+                                        &this->speeds_, &this->gaps_, &this->slowdowns_, &this->stopCounts_}) {
+            field->reserve(max_vehicles);
+        }
+        this->isTruck_.reserve(max_vehicles);
+        this->spawnTicks_.reserve(max_vehicles);
+        this->sightings_.reserve(max_vehicles);
+        this->exitedSpawnTicks_.reserve(max_vehicles);
+    }
+
+    /**
+     * Method adding vehicle in the site of the lane under given position, if the site is free.
+     * @param position - Position of the vehicle in world units.
+     * @param direction - Direction of the vehicle.
+     * @param is_truck - True if the vehicle is a truck.
+     * @param spawn_tick - Tick in which the vehicle appeared in the city.
+     * @return - True if the vehicle was added, false if there is no road under the position or its site is taken.
+     */
+    bool CellularAutomaton::add(sf::Vector2f position, int direction, bool is_truck, std::uint64_t spawn_tick)
+    {
+        int road = this->findRoad(position);
+        if (road < 0) {
+            return false;
+        }
+        const AABB& box = (*this->roads_)[road];
+        const float distances[4] = {box.bottom_ - position.y, position.y - box.top_, position.x - box.left_, box.right_ - position.x};
+        int site = std::min(std::max(static_cast<int>(distances[direction] * CA_CELL_SITES / this->cellSize_), 0), CA_CELL_SITES - 1);
+        int site_index = this->getSiteIndex(road, direction, site);
+        if (this->sites_[site_index] != 0) {
+            return false;
+        }
+        std::size_t vehicle = this->vehicleRoads_.size();
+        this->vehicleRoads_.push_back(road);
+        this->directions_.push_back(direction);
+        this->nextDirections_.push_back(direction);
+        this->positions_.push_back(site);
+        this->speeds_.push_back(0);
+        this->gaps_.push_back(0);
+        this->slowdowns_.push_back(0);
+        this->stopCounts_.push_back(0);
+        this->isTruck_.push_back(is_truck);
+        this->spawnTicks_.push_back(spawn_tick);
+        this->enterLane(vehicle, road, direction);
+        this->sites_[site_index] = vehicle + 1;
+        return true;
+    }
+
+    /**
+     * Method removing vehicle from the automaton. The last vehicle takes its index.
+     * @param vehicle - Index of the vehicle.
+     */
+    void CellularAutomaton::remove(std::size_t vehicle)
+    {
+        this->sites_[this->getSiteIndex(this->vehicleRoads_[vehicle], this->directions_[vehicle], this->positions_[vehicle])] = 0;
+        std::size_t last = this->vehicleRoads_.size() - 1;
+        if (vehicle != last) {
+            this->vehicleRoads_[vehicle] = this->vehicleRoads_[last];
+            this->directions_[vehicle] = this->directions_[last];
+            this->nextDirections_[vehicle] = this->nextDirections_[last];
+            this->positions_[vehicle] = this->positions_[last];
+            this->speeds_[vehicle] = this->speeds_[last];
+            this->stopCounts_[vehicle] = this->stopCounts_[last];
+            this->isTruck_[vehicle] = this->isTruck_[last];
+            this->spawnTicks_[vehicle] = this->spawnTicks_[last];
+            this->sites_[this->getSiteIndex(this->vehicleRoads_[vehicle], this->directions_[vehicle], this->positions_[vehicle])] = vehicle + 1;
+        }
+        for (std::vector<int>* field : {&this->vehicleRoads_, &this->directions_, &this->nextDirections_, &this->positions_,
+                                        &this->speeds_, &this->gaps_, &this->slowdowns_, &this->stopCounts_}) {
+            field->pop_back();
+        }
+        this->isTruck_.pop_back();
+        this->spawnTicks_.pop_back();
+    }
+
+    /**
+     * Method which makes one tick of the automaton: a step is made in every getStepTicks() tick. Sightings and exited
+     * vehicles of the previous tick are forgotten.
+     * @param tick - Number of the current tick.
+     */
+    void CellularAutomaton::tick(std::uint64_t tick)
+    {
+        this->sightings_.clear();
+        this->exitedSpawnTicks_.clear();
+        if (tick % this->stepTicks_ == 0) {
+            this->step();
+        }
+    }
+
+    /**
+     * Method which makes one step of the automaton. Free sites ahead and random slowdowns are found first, so new
+     * speeds of all vehicles are computed in one loop. Vehicles then move site by site in order of their indexes,
+     * so of two vehicles merging into one lane the first one takes the site and the other one stops behind it.
+     * Vehicles which reached exit sites leave the city.
+     */
+    void CellularAutomaton::step()
+    {
+        std::size_t count = this->vehicleRoads_.size();
+        std::uniform_int_distribution<> dist(1, 100);
+        for (std::size_t i = 0; i < count; i++) {
+            this->gaps_[i] = this->countFreeSites(i);
+            this->slowdowns_[i] = dist(this->engine_) <= CA_SLOWDOWN_PERCENT;
+        }
+        int* speeds = this->speeds_.data();
+        const int* gaps = this->gaps_.data();
+        const int* slowdowns = this->slowdowns_.data();
+        for (std::size_t i = 0; i < count; i++) {
+            int speed = std::min(std::min(speeds[i] + 1, CA_MAX_SPEED), gaps[i]);
+            speeds[i] = std::max(speed - slowdowns[i], 0);
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            this->moveVehicle(i);
+        }
+        for (std::size_t i = count; i-- > 0;) {
+            if (!this->isExitRoad_[this->vehicleRoads_[i]]) {
+                continue;
+            }
+            sf::Vector2f position = this->getPosition(i);
+            for (const AABB& exit_site : this->exitSites_) {
+                if (exit_site.contains(position)) {
+                    this->exitedSpawnTicks_.push_back(this->spawnTicks_[i]);
+                    this->remove(i);
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Method moving the vehicle by its speed, or turning it back if it has stood too long. The vehicle stops before
+     * a site taken in this step. A camera sees the vehicle when it enters a road watched by the camera from a road
+     * which is not.
+     * @param vehicle - Index of the vehicle.
+     */
+    void CellularAutomaton::moveVehicle(std::size_t vehicle)
+    {
+        if (this->speeds_[vehicle] == 0) {
+            if (++this->stopCounts_[vehicle] >= this->unblockSteps_) {
+                this->turnBack(vehicle);
+            }
+            return;
+        }
+        this->stopCounts_[vehicle] = 0;
+        for (int moved = 0; moved < this->speeds_[vehicle]; moved++) {
+            int road = this->vehicleRoads_[vehicle];
+            int site = this->positions_[vehicle] + 1;
+            int next_road = site < CA_CELL_SITES ? road : this->getNextRoad(vehicle);
+            int next_direction = site < CA_CELL_SITES ? this->directions_[vehicle] : this->nextDirections_[vehicle];
+            int next_site = site % CA_CELL_SITES;
+            int site_index = this->getSiteIndex(next_road, next_direction, next_site);
+            if (this->sites_[site_index] != 0) {
+                this->speeds_[vehicle] = moved;
+                return;
+            }
+            this->sites_[this->getSiteIndex(road, this->directions_[vehicle], this->positions_[vehicle])] = 0;
+            this->sites_[site_index] = vehicle + 1;
+            this->positions_[vehicle] = next_site;
+            if (next_site == 0) {
+                this->enterLane(vehicle, next_road, next_direction);
+                int camera = this->roadCameras_[next_road];
+                if (camera != 0 && camera != this->roadCameras_[road]) {
+                    this->sightings_.emplace_back(camera, this->isTruck_[vehicle] != 0);
+                }
+            }
+        }
+    }
+
+    /**
+     * Method putting the vehicle in the lane and drawing the lane it takes on the next road.
+     * @param vehicle - Index of the vehicle.
+     * @param road - Index of the road.
+     * @param direction - Direction of the lane.
+     */
+    void CellularAutomaton::enterLane(std::size_t vehicle, int road, int direction)
+    {
+        this->vehicleRoads_[vehicle] = road;
+        this->directions_[vehicle] = direction;
+        int next_road = this->neighbours_[road][direction];
+        this->nextDirections_[vehicle] = next_road < 0 ? oppositeDirections[direction] : this->drawDirection(next_road, direction);
+    }
+
+    /**
+     * Method turning the vehicle back to the opposite lane of its road, if the site next to it is free.
+     * @param vehicle - Index of the vehicle.
+     */
+    void CellularAutomaton::turnBack(std::size_t vehicle)
+    {
+        int road = this->vehicleRoads_[vehicle];
+        int direction = oppositeDirections[this->directions_[vehicle]];
+        int site = CA_CELL_SITES - 1 - this->positions_[vehicle];
+        int site_index = this->getSiteIndex(road, direction, site);
+        if (this->sites_[site_index] != 0) {
+            return;
+        }
+        this->sites_[this->getSiteIndex(road, this->directions_[vehicle], this->positions_[vehicle])] = 0;
+        this->sites_[site_index] = vehicle + 1;
+        this->positions_[vehicle] = site;
+        this->stopCounts_[vehicle] = 0;
+        this->enterLane(vehicle, road, direction);
+    }
+
+    /**
+     * Method drawing direction in which vehicle entering the road leaves it. Roads other than the one it came from
+     * are drawn equally often. At dead ends the vehicle keeps its direction, so it drives to the end of the road and
+     * turns back there.
+     * @param road - Index of the road.
+     * @param direction - Direction in which the vehicle entered the road.
+     * @return - Drawn direction.
+     */
+    int CellularAutomaton::drawDirection(int road, int direction)
+    {
+        int directions[3];
+        int count = 0;
+        for (int next = 0; next < 4; next++) {
+            if (next != oppositeDirections[direction] && this->neighbours_[road][next] >= 0) {
+                directions[count++] = next;
+            }
+        }
+        if (count == 0) {
+            return direction;
+        }
+        return directions[std::uniform_int_distribution<>(0, count - 1)(this->engine_)];
+    }
+
+    /**
+     * Method returning road which the vehicle enters at the end of its lane: the next road in its direction, or its
+     * own road at a dead end.
+     * @param vehicle - Index of the vehicle.
+     * @return - Index of the road.
+     */
+    int CellularAutomaton::getNextRoad(std::size_t vehicle) const
+    {
+        int next_road = this->neighbours_[this->vehicleRoads_[vehicle]][this->directions_[vehicle]];
+        return next_road < 0 ? this->vehicleRoads_[vehicle] : next_road;
+    }
+
+    /**
+     * Method returning index of the site in the array of sites.
+     * @param road - Index of the road.
+     * @param direction - Direction of the lane.
+     * @param site - Number of the site in the lane, 0 at the edge where vehicles enter it.
+     * @return - Index of the site.
+     */
+    int CellularAutomaton::getSiteIndex(int road, int direction, int site) const
+    {
+        return (4 * road + direction) * CA_CELL_SITES + site;
+    }
+
+    /**
+     * Method counting free sites ahead of the vehicle, in its lane and the lane it takes next, up to CA_MAX_SPEED.
+     * @param vehicle - Index of the vehicle.
+     * @return - Number of free sites.
+     */
+    int CellularAutomaton::countFreeSites(std::size_t vehicle) const
+    {
+        int road = this->vehicleRoads_[vehicle];
+        for (int gap = 0; gap < CA_MAX_SPEED; gap++) {
+            int site = this->positions_[vehicle] + gap + 1;
+            int site_index = site < CA_CELL_SITES ? this->getSiteIndex(road, this->directions_[vehicle], site)
+                                                  : this->getSiteIndex(this->getNextRoad(vehicle), this->nextDirections_[vehicle], site - CA_CELL_SITES);
+            if (this->sites_[site_index] != 0) {
+                return gap;
+            }
+        }
+        return CA_MAX_SPEED;
+    }
+
+    /**
+     * Method finding road which contains the position.
+     * @param position - Position in world units.
+     * @return - Index of the first road containing the position, -1 if there is none.
+     */
+    int CellularAutomaton::findRoad(sf::Vector2f position) const
+    {
+        for (std::size_t i = 0; i < this->roads_->size(); i++) {
+            if ((*this->roads_)[i].contains(position)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Method returning number of vehicles in the automaton.
+     * @return - Number of vehicles.
+     */
+    std::size_t CellularAutomaton::getVehiclesCount() const
+    {
+        return this->vehicleRoads_.size();
+    }
+
+    /**
+     * Method returning position of the middle of the vehicle's site, in its lane.
+     * @param vehicle - Index of the vehicle.
+     * @return - Position in world units.
+     */
+    sf::Vector2f CellularAutomaton::getPosition(std::size_t vehicle) const
+    {
+        const AABB& box = (*this->roads_)[this->vehicleRoads_[vehicle]];
+        sf::Vector2f middle = box.getPosition();
+        float distance = (this->positions_[vehicle] + 0.5f) * this->cellSize_ / CA_CELL_SITES;
+        switch (this->directions_[vehicle]) {
+            case 0:
+                return sf::Vector2f(middle.x + this->laneOffset_, box.bottom_ - distance);
+            case 1:
+                return sf::Vector2f(middle.x - this->laneOffset_, box.top_ + distance);
+            case 2:
+                return sf::Vector2f(box.left_ + distance, middle.y + this->laneOffset_);
+            default:
+                return sf::Vector2f(box.right_ - distance, middle.y - this->laneOffset_);
+        }
+    }
+
+    /**
+     * Method returning road of the vehicle.
+     * @param vehicle - Index of the vehicle.
+     * @return - Index of the road.
+     */
+    int CellularAutomaton::getRoad(std::size_t vehicle) const
+    {
+        return this->vehicleRoads_[vehicle];
+    }
+
+    /**
+     * Method returning direction of the vehicle.
+     * @param vehicle - Index of the vehicle.
+     * @return - Index of the direction.
+     */
+    int CellularAutomaton::getDirection(std::size_t vehicle) const
+    {
+        return this->directions_[vehicle];
+    }
+
+    /**
+     * Method telling if the vehicle is a truck.
+     * @param vehicle - Index of the vehicle.
+     * @return - True for trucks, false for cars.
+     */
+    bool CellularAutomaton::isTruck(std::size_t vehicle) const
+    {
+        return this->isTruck_[vehicle] != 0;
+    }
+
+    /**
+     * Method returning tick in which the vehicle appeared in the city.
+     * @param vehicle - Index of the vehicle.
+     * @return - Number of the tick.
+     */
+    std::uint64_t CellularAutomaton::getSpawnTick(std::size_t vehicle) const
+    {
+        return this->spawnTicks_[vehicle];
+    }
+
+    /**
+     * Method returning number of ticks between steps of the automaton.
+     * @return - Number of ticks.
+     */
+    int CellularAutomaton::getStepTicks() const
+    {
+        return this->stepTicks_;
+    }
+
+    /**
+     * Method returning sightings of the last tick: number of the camera and true if it saw a truck.
+     * @return - Sightings in order of vehicles.
+     */
+    const std::vector<std::pair<int, bool>>& CellularAutomaton::getSightings() const
+    {
+        return this->sightings_;
+    }
+
+    /**
+     * Method returning spawn ticks of vehicles which left the city in the last tick.
+     * @return - Spawn ticks of exited vehicles.
+     */
+    const std::vector<std::uint64_t>& CellularAutomaton::getExitedSpawnTicks() const
+    {
+        return this->exitedSpawnTicks_;
+    }
+}
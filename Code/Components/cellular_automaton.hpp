@@ -0,0 +1,69 @@
+/**
+ * cellular_automaton.hpp
+ * Header of CellularAutomaton class.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "SFML/Graphics.hpp"
+#include "aabb.hpp"
+#include "camera.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Class simulating traffic with the Nagel-Schreckenberg cellular automaton. Every road has one lane for every
+     * side through which vehicles leave it, split into CA_CELL_SITES sites holding at most one vehicle. In every step
+     * each vehicle speeds up by one site per step up to CA_MAX_SPEED, slows down to the number of free sites ahead,
+     * slows down by one more with CA_SLOWDOWN_PERCENT chance and moves. Steps are made every few ticks, so vehicles at
+     * full speed are about as fast as Vehicle objects. Entering a road, a vehicle draws the lane of the next road it
+     * takes among the roads other than the one it came from, so it sees sites behind the end of its lane; it turns
+     * back at the end of a dead end and after standing as long as a blocked Vehicle. Fields of vehicles are kept in
+     * separate arrays, so speed rules are plain loops the compiler vectorises.
+     * Directions are numbered: North 0, South 1, East 2, West 3.
+     */
+    class CellularAutomaton {
+    public:
+        CellularAutomaton(const std::vector<AABB>& roads, const std::vector<Camera>& cameras, const std::vector<AABB>& exit_sites,
+                          int cell_size, int lane_offset, int speed, int unblock_ticks, std::size_t max_vehicles, unsigned seed);
+        bool add(sf::Vector2f position, int direction, bool is_truck, std::uint64_t spawn_tick);
+        void remove(std::size_t vehicle);
+        void tick(std::uint64_t tick);
+        std::size_t getVehiclesCount() const;
+        sf::Vector2f getPosition(std::size_t vehicle) const;
+        int getRoad(std::size_t vehicle) const;
+        int getDirection(std::size_t vehicle) const;
+        bool isTruck(std::size_t vehicle) const;
+        std::uint64_t getSpawnTick(std::size_t vehicle) const;
+        int getStepTicks() const;
+        const std::vector<std::pair<int, bool>>& getSightings() const;
+        const std::vector<std::uint64_t>& getExitedSpawnTicks() const;
+    private:
+        void step();
+        void moveVehicle(std::size_t vehicle);
+        void enterLane(std::size_t vehicle, int road, int direction);
+        void turnBack(std::size_t vehicle);
+        int drawDirection(int road, int direction);
+        int getNextRoad(std::size_t vehicle) const;
+        int getSiteIndex(int road, int direction, int site) const;
+        int countFreeSites(std::size_t vehicle) const;
+        int findRoad(sf::Vector2f position) const;
+        const std::vector<AABB>* roads_;
+        int cellSize_, laneOffset_, stepTicks_, unblockSteps_;
+        std::minstd_rand engine_;
+        std::vector<std::array<int, 4>> neighbours_;
+        std::vector<int> roadCameras_, sites_;
+        std::vector<bool> isExitRoad_;
+        std::vector<AABB> exitSites_;
+        std::vector<int> vehicleRoads_, directions_, nextDirections_, positions_, speeds_, gaps_, slowdowns_, stopCounts_;
+        std::vector<std::uint8_t> isTruck_;
+        std::vector<std::uint64_t> spawnTicks_;
+        std::vector<std::pair<int, bool>> sightings_;
+        std::vector<std::uint64_t> exitedSpawnTicks_;
+    };
+}
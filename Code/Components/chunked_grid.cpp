@@ -0,0 +1,180 @@
+/**
+ * chunked_grid.cpp
+ * Implementation of ChunkedGrid class and GridChunk structure.
+ */
+
+#include "chunked_grid.hpp"
+#include <stdexcept>
+
+namespace zpr {
+
+    /**
+     * Parametrized constructor of GridChunk struct. It creates every cell of the chunk with its global position.
+     * @param chunk_row - Row of the chunk in the chunk table.
+     * @param chunk_column - Column of the chunk in the chunk table.
+     */
+    GridChunk::GridChunk(int chunk_row, int chunk_column) : chunkRow_(chunk_row), chunkColumn_(chunk_column)
+    {
+        this->cells_.reserve(GRID_CHUNK_SIZE * GRID_CHUNK_SIZE);
+        for (int i = 0; i < GRID_CHUNK_SIZE * GRID_CHUNK_SIZE; i++) {
+            this->cells_.push_back(Cell(chunk_row * GRID_CHUNK_SIZE + i / GRID_CHUNK_SIZE, chunk_column * GRID_CHUNK_SIZE + i % GRID_CHUNK_SIZE));
+        }
+    }
+
+    /**
+     * Method returning reference to cell at certain position inside the chunk.
+     * @param local_row - Row of the cell counted from the chunk origin.
+     * @param local_column - Column of the cell counted from the chunk origin.
+     * @return - Reference to the cell.
+     */
+    Cell& GridChunk::getCell(int local_row, int local_column)
+    {
+        return this->cells_[local_row * GRID_CHUNK_SIZE + local_column];
+    }
+
+    /**
+     * Method checking if no cell of the chunk holds anything.
+     * @return - True if every cell is empty, false otherwise.
+     */
+    bool GridChunk::isEmpty() const
+    {
+        for (const Cell& cell : this->cells_) {
+            if (!cell.isEmpty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Parametrized constructor of ChunkedGrid class. No chunk is allocated.
+     * @param size - Size of the grid.
+     */
+    ChunkedGrid::ChunkedGrid(int size) : size_(size)
+    {
+        this->chunksPerSide_ = (size + GRID_CHUNK_SIZE - 1) / GRID_CHUNK_SIZE;
+        this->chunks_.resize(this->chunksPerSide_ * this->chunksPerSide_);
+    }
+
+    /**
+     * Parametrized constructor of ChunkedGrid class. Only not empty cells are stored, on their own positions.
+     * @param cells - Vector of cells (dense or sparse) from which grid will be built.
+     * @param size - Size of the grid.
+     */
+    ChunkedGrid::ChunkedGrid(const std::vector<Cell>& cells, int size) : ChunkedGrid(size)
+    {
+        for (const Cell& cell : cells) {
+            if (!cell.isEmpty()) {
+                this->getCell(cell.getPosition().x, cell.getPosition().y) = cell;
+            }
+        }
+    }
+
+    /**
+     * Method calculating index of the chunk containing given cell.
+     * @param row - Row where the cell is at.
+     * @param column - Column where the cell is at.
+     * @return - Index in the chunk table.
+     */
+    int ChunkedGrid::chunkIndex(int row, int column) const
+    {
+        if (row < 0 || column < 0 || row >= this->size_ || column >= this->size_) {
+            throw std::out_of_range("ChunkedGrid: cell outside of the grid");
+        }
+        return (row / GRID_CHUNK_SIZE) * this->chunksPerSide_ + column / GRID_CHUNK_SIZE;
+    }
+
+    /**
+     * Method returning reference to cell at certain position. Chunk holding the cell is allocated if needed.
+     * @param row - Row where the cell is at.
+     * @param column - Column where the cell is at.
+     * @return - Reference to the cell.
+     */
+    Cell& ChunkedGrid::getCell(int row, int column)
+    {
+        std::unique_ptr<GridChunk>& chunk = this->chunks_[this->chunkIndex(row, column)];
+        if (!chunk) {
+            chunk = std::make_unique<GridChunk>(row / GRID_CHUNK_SIZE, column / GRID_CHUNK_SIZE);
+        }
+        return chunk->getCell(row % GRID_CHUNK_SIZE, column % GRID_CHUNK_SIZE);
+    }
+
+    /**
+     * Method returning pointer to cell at certain position without allocating anything.
+     * @param row - Row where the cell is at.
+     * @param column - Column where the cell is at.
+     * @return - Pointer to the cell or nullptr if its chunk was never allocated.
+     */
+    const Cell* ChunkedGrid::findCell(int row, int column) const
+    {
+        if (row < 0 || column < 0 || row >= this->size_ || column >= this->size_) {
+            return nullptr;
+        }
+        const std::unique_ptr<GridChunk>& chunk = this->chunks_[this->chunkIndex(row, column)];
+        if (!chunk) {
+            return nullptr;
+        }
+        return &chunk->cells_[(row % GRID_CHUNK_SIZE) * GRID_CHUNK_SIZE + column % GRID_CHUNK_SIZE];
+    }
+
+    /**
+     * Method checking if there is a road on given position.
+     * @param row - Row where the cell is at.
+     * @param column - Column where the cell is at.
+     * @return - True if cell exists and contains road, false otherwise.
+     */
+    bool ChunkedGrid::containsRoad(int row, int column) const
+    {
+        const Cell* cell = this->findCell(row, column);
+        return cell && cell->containsRoad_;
+    }
+
+    /**
+     * Method returning copies of all not empty cells, chunk by chunk.
+     * @return - Vector of occupied cells.
+     */
+    std::vector<Cell> ChunkedGrid::getOccupiedCells() const
+    {
+        std::vector<Cell> occupied_cells;
+        this->forEachChunk([&](const GridChunk& chunk) {
+            for (const Cell& cell : chunk.cells_) {
+                if (!cell.isEmpty()) {
+                    occupied_cells.push_back(cell);
+                }
+            }
+        });
+        return occupied_cells;
+    }
+
+    /**
+     * Method returning number of currently allocated chunks.
+     * @return - Number of allocated chunks.
+     */
+    int ChunkedGrid::getAllocatedChunksCount() const
+    {
+        int counter = 0;
+        this->forEachChunk([&](const GridChunk&) { counter++; });
+        return counter;
+    }
+
+    /**
+     * Method returning number of chunks in one row of the chunk table.
+     * @return - Number of chunks per side.
+     */
+    int ChunkedGrid::getChunksPerSide() const
+    {
+        return this->chunksPerSide_;
+    }
+
+    /**
+     * Method which frees chunks that do not hold anything anymore.
+     */
+    void ChunkedGrid::releaseEmptyChunks()
+    {
+        for (std::unique_ptr<GridChunk>& chunk : this->chunks_) {
+            if (chunk && chunk->isEmpty()) {
+                chunk.reset();
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * chunked_grid.hpp
+ * Header of ChunkedGrid class and GridChunk structure.
+ */
+
+#pragma once
+#include <vector>
+#include <memory>
+#include "cell.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Struct responsible for one square tile of GRID_CHUNK_SIZE x GRID_CHUNK_SIZE cells.
+     */
+    struct GridChunk
+    {
+        GridChunk(int chunk_row, int chunk_column);
+        Cell& getCell(int local_row, int local_column);
+        bool isEmpty() const;
+        int chunkRow_, chunkColumn_;
+        std::vector<Cell> cells_;
+    };
+
+    /**
+     * Class responsible for sparse grid storage. Chunks are allocated only when a cell inside them is written,
+     * so big maps with few roads take memory proportional to their roads, not to their area.
+     */
+    class ChunkedGrid
+    {
+    public:
+        ChunkedGrid(int size);
+        ChunkedGrid(const std::vector<Cell>& cells, int size);
+        Cell& getCell(int row, int column);
+        const Cell* findCell(int row, int column) const;
+        bool containsRoad(int row, int column) const;
+        std::vector<Cell> getOccupiedCells() const;
+        int getAllocatedChunksCount() const;
+        int getChunksPerSide() const;
+        void releaseEmptyChunks();
+
+        /**
+         * Template method which calls function for every allocated chunk.
+         * @param function - Function taking GridChunk& as a parameter.
+         */
+        template <typename Function>
+        void forEachChunk(Function function) {
+            for (std::unique_ptr<GridChunk>& chunk : this->chunks_) {
+                if (chunk) {
+                    function(*chunk);
+                }
+            }
+        }
+
+        /**
+         * Template method which calls function for every allocated chunk (read only).
+         * @param function - Function taking const GridChunk& as a parameter.
+         */
+        template <typename Function>
+        void forEachChunk(Function function) const {
+            for (const std::unique_ptr<GridChunk>& chunk : this->chunks_) {
+                if (chunk) {
+                    function(*chunk);
+                }
+            }
+        }
+
+        int size_;
+    private:
+        int chunkIndex(int row, int column) const;
+        int chunksPerSide_;
+        std::vector<std::unique_ptr<GridChunk>> chunks_;
+    };
+}
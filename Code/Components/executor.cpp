@@ -0,0 +1,294 @@
+/**
+ * executor.cpp
+ * Implementation of Executor and TaskGroup classes.
+ */
+
+#include "executor.hpp"
+#include <algorithm>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Index of the worker running on this thread, -1 for threads which are not workers.
+         */
+        thread_local int workerIndex = -1;
+    }
+
+    /**
+     * Method returning the only Executor object, shared by every thread.
+     * @return - Reference to the executor.
+     */
+    Executor& Executor::instance()
+    {
+        static Executor executor(std::max(1u, std::thread::hardware_concurrency()));
+        return executor;
+    }
+
+    /**
+     * Parametrized constructor of Executor class. It starts workers and the timer thread.
+     * @param workers - Number of workers.
+     */
+    Executor::Executor(int workers) : nextWorker_(0), pendingCount_(0), isStopping_(false), parkedCount_(0), waitingCount_(0)
+    {
+        for (int i = 0; i < workers; i++) {
+            this->workers_.push_back(std::make_unique<Worker>());
+        }
+        for (int i = 0; i < workers; i++) {
+            this->workers_[i]->thread_ = std::thread(&Executor::work, this, i);
+        }
+        this->timersThread_ = std::thread(&Executor::runTimers, this);
+    }
+
+    /**
+     * Destructor of Executor class. Running and pending tasks are finished, also tasks which they submit, so work
+     * such as saving a map is not lost when the application closes. Delayed tasks are dropped.
+     */
+    Executor::~Executor()
+    {
+        {
+            std::lock_guard<std::mutex> park_lock(this->parkMutex_);
+            std::lock_guard<std::mutex> timers_lock(this->timersMutex_);
+            this->isStopping_.store(true);
+        }
+        this->parkCondition_.notify_all();
+        this->timersCondition_.notify_all();
+        for (std::unique_ptr<Worker>& worker : this->workers_) {
+            worker->thread_.join();
+        }
+        this->timersThread_.join();
+    }
+
+    /**
+     * Method adding task. Workers put it on their own deque, other threads on deques of workers in turn.
+     * @param task - Task to run.
+     */
+    void Executor::submit(std::function<void()> task)
+    {
+        int index = workerIndex >= 0 ? workerIndex : this->nextWorker_.fetch_add(1, std::memory_order_relaxed) % this->workers_.size();
+        {
+            std::lock_guard<std::mutex> lock(this->workers_[index]->mutex_);
+            this->workers_[index]->tasks_.push_back(std::move(task));
+        }
+        this->pendingCount_.fetch_add(1, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(this->parkMutex_);
+        if (this->parkedCount_ > 0) {
+            this->parkCondition_.notify_one();
+        }
+        else if (this->waitingCount_ > 0) {
+            this->waitCondition_.notify_one();
+        }
+    }
+
+    /**
+     * Method adding task which is submitted after a delay.
+     * @param delay - Delay in milliseconds.
+     * @param task - Task to run.
+     */
+    void Executor::submitAfter(int delay, std::function<void()> task)
+    {
+        std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay);
+        {
+            std::lock_guard<std::mutex> lock(this->timersMutex_);
+            this->timers_.emplace(time, std::move(task));
+        }
+        this->timersCondition_.notify_one();
+    }
+
+    /**
+     * Method running one pending task on the calling thread, used while waiting for other tasks.
+     * @return - False if there was no pending task, true otherwise.
+     */
+    bool Executor::runPendingTask()
+    {
+        std::function<void()> task;
+        if (!this->takeTask(workerIndex, task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    /**
+     * Method waiting until the condition is met, running pending tasks in the meantime. When there are none, the thread
+     * sleeps until a task is submitted or notifyWaiting() is called, so the condition has to be changed before that.
+     * @param is_done - Condition, checked while the thread holds the lock of the executor, so it must not wait itself.
+     */
+    void Executor::wait(const std::function<bool()>& is_done)
+    {
+        while (!is_done()) {
+            if (this->runPendingTask()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(this->parkMutex_);
+            this->waitingCount_++;
+            this->waitCondition_.wait(lock, [&]() {
+                return is_done() || this->pendingCount_.load(std::memory_order_acquire) > 0;
+            });
+            this->waitingCount_--;
+        }
+    }
+
+    /**
+     * Method waking threads sleeping in wait(), so they check their conditions again.
+     */
+    void Executor::notifyWaiting()
+    {
+        std::lock_guard<std::mutex> lock(this->parkMutex_);
+        if (this->waitingCount_ > 0) {
+            this->waitCondition_.notify_all();
+        }
+    }
+
+    /**
+     * Method returning number of workers.
+     * @return - Number of workers.
+     */
+    int Executor::getWorkersCount() const
+    {
+        return this->workers_.size();
+    }
+
+    /**
+     * Method run by every worker: it runs tasks while there are any and sleeps otherwise. When the executor stops,
+     * the worker ends once there are no pending tasks.
+     * @param index - Index of the worker.
+     */
+    void Executor::work(int index)
+    {
+        workerIndex = index;
+        std::function<void()> task;
+        while (true) {
+            if (this->takeTask(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            if (this->isStopping_.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(this->parkMutex_);
+            this->parkedCount_++;
+            this->parkCondition_.wait(lock, [&]() {
+                return this->pendingCount_.load(std::memory_order_acquire) > 0 || this->isStopping_.load(std::memory_order_acquire);
+            });
+            this->parkedCount_--;
+        }
+    }
+
+    /**
+     * Method taking task: the newest one of the worker, or the oldest one of another worker.
+     * @param index - Index of the worker, -1 if the calling thread is not a worker.
+     * @param task - Taken task.
+     * @return - False if every deque is empty, true otherwise.
+     */
+    bool Executor::takeTask(int index, std::function<void()>& task)
+    {
+        if (this->pendingCount_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        if (index >= 0) {
+            Worker& worker = *this->workers_[index];
+            std::lock_guard<std::mutex> lock(worker.mutex_);
+            if (!worker.tasks_.empty()) {
+                task = std::move(worker.tasks_.back());
+                worker.tasks_.pop_back();
+                this->pendingCount_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        int count = this->workers_.size();
+        for (int i = 1; i <= count; i++) {
+            Worker& victim = *this->workers_[(std::max(index, 0) + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex_);
+            if (!victim.tasks_.empty()) {
+                task = std::move(victim.tasks_.front());
+                victim.tasks_.pop_front();
+                this->pendingCount_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Method run by the timer thread: it submits delayed tasks when they are due.
+     */
+    void Executor::runTimers()
+    {
+        std::unique_lock<std::mutex> lock(this->timersMutex_);
+        while (!this->isStopping_.load(std::memory_order_acquire)) {
+            if (this->timers_.empty()) {
+                this->timersCondition_.wait(lock);
+                continue;
+            }
+            std::chrono::steady_clock::time_point time = this->timers_.begin()->first;
+            if (std::chrono::steady_clock::now() < time) {
+                this->timersCondition_.wait_until(lock, time);
+                continue;
+            }
+            std::function<void()> task = std::move(this->timers_.begin()->second);
+            this->timers_.erase(this->timers_.begin());
+            lock.unlock();
+            this->submit(std::move(task));
+            lock.lock();
+        }
+    }
+
+    /**
+     * Default constructor of TaskGroup class.
+     */
+    TaskGroup::TaskGroup() : pendingCount_(0) {}
+
+    /**
+     * Destructor of TaskGroup class. It waits for tasks of the group, which use the group.
+     */
+    TaskGroup::~TaskGroup()
+    {
+        Executor::instance().wait([this]() {
+            return this->pendingCount_.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    /**
+     * Method submitting task of the group.
+     * @param task - Task to run.
+     */
+    void TaskGroup::run(std::function<void()> task)
+    {
+        this->pendingCount_.fetch_add(1, std::memory_order_relaxed);
+        Executor::instance().submit([this, task]() {
+            try {
+                task();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(this->exceptionMutex_);
+                if (!this->exception_) {
+                    this->exception_ = std::current_exception();
+                }
+            }
+            if (this->pendingCount_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Executor::instance().notifyWaiting();
+            }
+        });
+    }
+
+    /**
+     * Method waiting until every task of the group ends, running pending tasks in the meantime.
+     */
+    void TaskGroup::wait()
+    {
+        Executor::instance().wait([this]() {
+            return this->pendingCount_.load(std::memory_order_acquire) == 0;
+        });
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(this->exceptionMutex_);
+            std::swap(exception, this->exception_);
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
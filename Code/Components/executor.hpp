@@ -0,0 +1,86 @@
+/**
+ * executor.hpp
+ * Header of Executor and TaskGroup classes.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zpr {
+
+    /**
+     * Class running tasks of the whole application on one pool of threads, one per core. Every worker has its own
+     * deque: it takes its newest task first and, when the deque is empty, steals the oldest task of another worker.
+     * Workers with nothing to do sleep until a task is submitted. Threads waiting for other tasks run pending tasks
+     * and sleep when there are none, until a task is submitted or notifyWaiting() is called. Delayed tasks wait on one
+     * timer thread and are submitted when they are due.
+     */
+    class Executor {
+    public:
+        static Executor& instance();
+        ~Executor();
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+        void submit(std::function<void()> task);
+        void submitAfter(int delay, std::function<void()> task);
+        bool runPendingTask();
+        void wait(const std::function<bool()>& is_done);
+        void notifyWaiting();
+        int getWorkersCount() const;
+    private:
+        /**
+         * Struct with deque of one worker and its thread.
+         */
+        struct Worker {
+            std::mutex mutex_;
+            std::deque<std::function<void()>> tasks_;
+            std::thread thread_;
+        };
+        Executor(int workers);
+        void work(int index);
+        bool takeTask(int index, std::function<void()>& task);
+        void runTimers();
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::atomic<unsigned> nextWorker_;
+        std::atomic<int> pendingCount_;
+        std::atomic<bool> isStopping_;
+        std::mutex parkMutex_;
+        std::condition_variable parkCondition_;
+        std::condition_variable waitCondition_;
+        int parkedCount_, waitingCount_;
+        std::mutex timersMutex_;
+        std::condition_variable timersCondition_;
+        std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> timers_;
+        std::thread timersThread_;
+    };
+
+    /**
+     * Class waiting for a group of tasks submitted to the Executor. A thread waiting for the group runs other pending
+     * tasks in the meantime, so tasks may wait for groups without blocking workers, and sleeps when there are none
+     * until the last task of the group ends. The first exception thrown by
+     * a task is thrown again by wait().
+     */
+    class TaskGroup {
+    public:
+        TaskGroup();
+        ~TaskGroup();
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        void run(std::function<void()> task);
+        void wait();
+    private:
+        std::atomic<int> pendingCount_;
+        std::mutex exceptionMutex_;
+        std::exception_ptr exception_;
+    };
+}
@@ -0,0 +1,275 @@
+/**
+ * packed_vehicles.cpp
+ * Implementation of PackedVehicles class.
+ */
+
+#include "packed_vehicles.hpp"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ZPR_AVX2_KERNELS
+#include <immintrin.h>
+#define ZPR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace zpr {
+
+    /**
+     * Default constructor of PackedVehicles class. AVX2 kernels are used if the processor has them.
+     */
+    PackedVehicles::PackedVehicles() : isAvx2_(hasAvx2()) {}
+
+    /**
+     * Method setting number of vehicles. Arrays keep their memory, so setting it every tick does not allocate.
+     * @param count - Number of vehicles.
+     */
+    void PackedVehicles::resize(std::size_t count)
+    {
+        for (std::vector<float>* field : {&this->lefts_, &this->tops_, &this->rights_, &this->bottoms_, &this->xs_, &this->ys_, &this->halfWidths_,
+                                          &this->halfHeights_, &this->stepsX_, &this->stepsY_, &this->lanes_, &this->isVertical_}) {
+            field->resize(count);
+        }
+    }
+
+    /**
+     * Method setting shape of the vehicle. Its center is computed the same way as by AABB::getPosition.
+     * @param vehicle - Index of the vehicle.
+     * @param shape - Shape of the vehicle.
+     */
+    void PackedVehicles::setShape(std::size_t vehicle, const AABB& shape)
+    {
+        sf::Vector2f position = shape.getPosition();
+        sf::Vector2f size = shape.getSize();
+        this->lefts_[vehicle] = shape.left_;
+        this->tops_[vehicle] = shape.top_;
+        this->rights_[vehicle] = shape.right_;
+        this->bottoms_[vehicle] = shape.bottom_;
+        this->xs_[vehicle] = position.x;
+        this->ys_[vehicle] = position.y;
+        this->halfWidths_[vehicle] = size.x / 2;
+        this->halfHeights_[vehicle] = size.y / 2;
+    }
+
+    /**
+     * Method setting how the vehicle moves in move(), like Vehicle::move does: it drives the speed along its direction
+     * and keeps the other coordinate of its center in the lane.
+     * @param vehicle - Index of the vehicle.
+     * @param direction - Index of direction of the vehicle.
+     * @param speed - Distance driven in one move.
+     * @param lane_position - Coordinate of the lane across the direction.
+     */
+    void PackedVehicles::setMove(std::size_t vehicle, int direction, float speed, float lane_position)
+    {
+        const float steps_x[4] = {0, 0, speed, -speed};
+        const float steps_y[4] = {-speed, speed, 0, 0};
+        this->stepsX_[vehicle] = steps_x[direction];
+        this->stepsY_[vehicle] = steps_y[direction];
+        this->lanes_[vehicle] = lane_position;
+        this->isVertical_[vehicle] = direction < 2 ? 1.0f : 0.0f;
+    }
+
+    /**
+     * Method finding the first vehicle whose shape overlaps the colision box, skipping the ones standing in the given
+     * position, as Vehicle::checkColision does for the vehicle itself.
+     * @param colision_box - Colision box of the checked vehicle.
+     * @param position - Position of the checked vehicle.
+     * @return - Index of the first colliding vehicle, number of vehicles if there is none.
+     */
+    std::size_t PackedVehicles::findColision(const AABB& colision_box, sf::Vector2f position) const
+    {
+        if (this->isAvx2_) {
+            return this->findColisionAvx2(colision_box, position);
+        }
+        return this->findColisionScalar(colision_box, position, 0);
+    }
+
+    /**
+     * Method moving every vehicle once with the move set by setMove and updating its shape.
+     */
+    void PackedVehicles::move()
+    {
+        if (this->isAvx2_) {
+            this->moveAvx2();
+        }
+        else {
+            this->moveScalar(0);
+        }
+    }
+
+    /**
+     * Method returning shape of the vehicle.
+     * @param vehicle - Index of the vehicle.
+     * @return - Shape of the vehicle.
+     */
+    AABB PackedVehicles::getShape(std::size_t vehicle) const
+    {
+        return AABB(this->lefts_[vehicle], this->tops_[vehicle], this->rights_[vehicle], this->bottoms_[vehicle]);
+    }
+
+    /**
+     * Method returning number of vehicles.
+     * @return - Number of vehicles.
+     */
+    std::size_t PackedVehicles::getVehiclesCount() const
+    {
+        return this->lefts_.size();
+    }
+
+    /**
+     * Method choosing between AVX2 kernels and plain loops. AVX2 is used only if the processor has it.
+     * @param is_avx2 - True to use AVX2 kernels, false to use plain loops.
+     */
+    void PackedVehicles::setAvx2(bool is_avx2)
+    {
+        this->isAvx2_ = is_avx2 && hasAvx2();
+    }
+
+    /**
+     * Method checking if AVX2 kernels are used.
+     * @return - True if AVX2 kernels are used, false otherwise.
+     */
+    bool PackedVehicles::isAvx2() const
+    {
+        return this->isAvx2_;
+    }
+
+    /**
+     * Method checking if the program was built with AVX2 kernels and the processor can run them.
+     * @return - True if AVX2 kernels can be used, false otherwise.
+     */
+    bool PackedVehicles::hasAvx2()
+    {
+#ifdef ZPR_AVX2_KERNELS
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Method checking vehicles one by one, written like AABB::intersects, so edges which only touch do not collide.
+     * @param colision_box - Colision box of the checked vehicle.
+     * @param position - Position of the checked vehicle.
+     * @param first - Index of the first vehicle to check.
+     * @return - Index of the first colliding vehicle, number of vehicles if there is none.
+     */
+    std::size_t PackedVehicles::findColisionScalar(const AABB& colision_box, sf::Vector2f position, std::size_t first) const
+    {
+        std::size_t count = this->lefts_.size();
+        for (std::size_t i = first; i < count; i++) {
+            if ((this->xs_[i] != position.x || this->ys_[i] != position.y)
+                && std::max(colision_box.left_, this->lefts_[i]) < std::min(colision_box.right_, this->rights_[i])
+                && std::max(colision_box.top_, this->tops_[i]) < std::min(colision_box.bottom_, this->bottoms_[i])) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Method moving vehicles one by one.
+     * @param first - Index of the first vehicle to move.
+     */
+    void PackedVehicles::moveScalar(std::size_t first)
+    {
+        std::size_t count = this->lefts_.size();
+        for (std::size_t i = first; i < count; i++) {
+            float x = this->xs_[i] + this->stepsX_[i];
+            float y = this->ys_[i] + this->stepsY_[i];
+            if (this->isVertical_[i] != 0) {
+                x = this->lanes_[i];
+            }
+            else {
+                y = this->lanes_[i];
+            }
+            this->xs_[i] = x;
+            this->ys_[i] = y;
+            this->lefts_[i] = x - this->halfWidths_[i];
+            this->rights_[i] = x + this->halfWidths_[i];
+            this->tops_[i] = y - this->halfHeights_[i];
+            this->bottoms_[i] = y + this->halfHeights_[i];
+        }
+    }
+
+#ifdef ZPR_AVX2_KERNELS
+    /**
+     * Method checking eight vehicles at once and the rest one by one. Arguments of max and min are in the order
+     * which gives the same result as std::max and std::min, even for NaN. Upper halves of registers are cleared
+     * before plain code runs again, otherwise mixing AVX and SSE instructions slows it down.
+     * @param colision_box - Colision box of the checked vehicle.
+     * @param position - Position of the checked vehicle.
+     * @return - Index of the first colliding vehicle, number of vehicles if there is none.
+     */
+    ZPR_TARGET_AVX2 std::size_t PackedVehicles::findColisionAvx2(const AABB& colision_box, sf::Vector2f position) const
+    {
+        std::size_t count = this->lefts_.size();
+        const __m256 left = _mm256_set1_ps(colision_box.left_), top = _mm256_set1_ps(colision_box.top_);
+        const __m256 right = _mm256_set1_ps(colision_box.right_), bottom = _mm256_set1_ps(colision_box.bottom_);
+        const __m256 x = _mm256_set1_ps(position.x), y = _mm256_set1_ps(position.y);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 other_position = _mm256_or_ps(_mm256_cmp_ps(_mm256_loadu_ps(&this->xs_[i]), x, _CMP_NEQ_UQ),
+                                                 _mm256_cmp_ps(_mm256_loadu_ps(&this->ys_[i]), y, _CMP_NEQ_UQ));
+            __m256 overlap_x = _mm256_cmp_ps(_mm256_max_ps(_mm256_loadu_ps(&this->lefts_[i]), left),
+                                             _mm256_min_ps(_mm256_loadu_ps(&this->rights_[i]), right), _CMP_LT_OQ);
+            __m256 overlap_y = _mm256_cmp_ps(_mm256_max_ps(_mm256_loadu_ps(&this->tops_[i]), top),
+                                             _mm256_min_ps(_mm256_loadu_ps(&this->bottoms_[i]), bottom), _CMP_LT_OQ);
+            int mask = _mm256_movemask_ps(_mm256_and_ps(other_position, _mm256_and_ps(overlap_x, overlap_y)));
+            if (mask != 0) {
+                _mm256_zeroupper();
+                return i + __builtin_ctz(mask);
+            }
+        }
+        _mm256_zeroupper();
+        return this->findColisionScalar(colision_box, position, i);
+    }
+
+    /**
+     * Method moving eight vehicles at once and the rest one by one.
+     */
+    ZPR_TARGET_AVX2 void PackedVehicles::moveAvx2()
+    {
+        std::size_t count = this->lefts_.size();
+        const __m256 zero = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 lane = _mm256_loadu_ps(&this->lanes_[i]);
+            __m256 is_vertical = _mm256_cmp_ps(_mm256_loadu_ps(&this->isVertical_[i]), zero, _CMP_NEQ_UQ);
+            __m256 x = _mm256_add_ps(_mm256_loadu_ps(&this->xs_[i]), _mm256_loadu_ps(&this->stepsX_[i]));
+            __m256 y = _mm256_add_ps(_mm256_loadu_ps(&this->ys_[i]), _mm256_loadu_ps(&this->stepsY_[i]));
+            x = _mm256_blendv_ps(x, lane, is_vertical);
+            y = _mm256_blendv_ps(lane, y, is_vertical);
+            __m256 half_width = _mm256_loadu_ps(&this->halfWidths_[i]);
+            __m256 half_height = _mm256_loadu_ps(&this->halfHeights_[i]);
+            _mm256_storeu_ps(&this->xs_[i], x);
+            _mm256_storeu_ps(&this->ys_[i], y);
+            _mm256_storeu_ps(&this->lefts_[i], _mm256_sub_ps(x, half_width));
+            _mm256_storeu_ps(&this->rights_[i], _mm256_add_ps(x, half_width));
+            _mm256_storeu_ps(&this->tops_[i], _mm256_sub_ps(y, half_height));
+            _mm256_storeu_ps(&this->bottoms_[i], _mm256_add_ps(y, half_height));
+        }
+        _mm256_zeroupper();
+        this->moveScalar(i);
+    }
+#else
+    /**
+     * Method used when the program is built without AVX2 kernels.
+     * @param colision_box - Colision box of the checked vehicle.
+     * @param position - Position of the checked vehicle.
+     * @return - Index of the first colliding vehicle, number of vehicles if there is none.
+     */
+    std::size_t PackedVehicles::findColisionAvx2(const AABB& colision_box, sf::Vector2f position) const
+    {
+        return this->findColisionScalar(colision_box, position, 0);
+    }
+
+    /**
+     * Method used when the program is built without AVX2 kernels.
+     */
+    void PackedVehicles::moveAvx2()
+    {
+        this->moveScalar(0);
+    }
+#endif
+}
@@ -0,0 +1,44 @@
+/**
+ * packed_vehicles.hpp
+ * Header of PackedVehicles class.
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "SFML/Graphics.hpp"
+#include "aabb.hpp"
+
+namespace zpr {
+
+    /**
+     * Class keeping shapes of vehicles in separate arrays of floats (left, top, right and bottom edges, centers and
+     * half sizes), so the collision test of Vehicle::checkColision and the position update of Vehicle::move run over
+     * eight vehicles per instruction. Kernels written with AVX2 are used when the processor has it, checked once at
+     * run time; otherwise plain loops give the same results. Both paths compare and add in the same order, so their
+     * results are identical to the last bit.
+     * Directions are numbered: North 0, South 1, East 2, West 3.
+     */
+    class PackedVehicles {
+    public:
+        PackedVehicles();
+        void resize(std::size_t count);
+        void setShape(std::size_t vehicle, const AABB& shape);
+        void setMove(std::size_t vehicle, int direction, float speed, float lane_position);
+        std::size_t findColision(const AABB& colision_box, sf::Vector2f position) const;
+        void move();
+        AABB getShape(std::size_t vehicle) const;
+        std::size_t getVehiclesCount() const;
+        void setAvx2(bool is_avx2);
+        bool isAvx2() const;
+        static bool hasAvx2();
+    private:
+        std::size_t findColisionScalar(const AABB& colision_box, sf::Vector2f position, std::size_t first) const;
+        void moveScalar(std::size_t first);
+        std::size_t findColisionAvx2(const AABB& colision_box, sf::Vector2f position) const;
+        void moveAvx2();
+        bool isAvx2_;
+        std::vector<float> lefts_, tops_, rights_, bottoms_, xs_, ys_, halfWidths_, halfHeights_;
+        std::vector<float> stepsX_, stepsY_, lanes_, isVertical_;
+    };
+}
@@ -0,0 +1,248 @@
+/**
+ * queue_model.cpp
+ * Implementation of QueueModel class.
+ */
+
+#include "queue_model.hpp"
+#include <algorithm>
+#include <map>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Opposite directions of directions North, South, East and West.
+         */
+        const int oppositeDirections[4] = {1, 0, 3, 2};
+
+        /**
+         * Moves by one unit in directions North, South, East and West.
+         */
+        const sf::Vector2f directionSteps[4] = {sf::Vector2f(0, -1), sf::Vector2f(0, 1), sf::Vector2f(1, 0), sf::Vector2f(-1, 0)};
+    }
+
+    /**
+     * Parametrized constructor of QueueModel class. It finds neighbouring roads of every road and prepares room for
+     * every vehicle of the simulation, so ticks do not allocate memory. At first no road is detailed.
+     * @param roads - Roads of the simulation (not copied, they have to outlive the model).
+     * @param cell_size - Size of a cell in world units.
+     * @param speed - Speed of vehicles in world units per tick.
+     * @param max_vehicles - Maximal number of vehicles in the simulation.
+     * @param seed - Seed of directions drawn by vehicles.
+     */
+    QueueModel::QueueModel(const std::vector<AABB>& roads, int cell_size, int speed, std::size_t max_vehicles, unsigned seed) :
+        roads_(&roads), cellSize_(cell_size), speed_(std::max(speed, 1)), travelTicks_((cell_size + std::max(speed, 1) - 1) / std::max(speed, 1)),
+        vehiclesCount_(0), freeNode_(-1), engine_(seed)
+    {
+        std::map<std::pair<float, float>, int> cells;
+        for (std::size_t i = 0; i < roads.size(); i++) {
+            cells.emplace(std::make_pair(roads[i].getPosition().x, roads[i].getPosition().y), i);
+        }
+        this->neighbours_.assign(roads.size(), {-1, -1, -1, -1});
+        for (std::size_t i = 0; i < roads.size(); i++) {
+            for (int direction = 0; direction < 4; direction++) {
+                sf::Vector2f position = roads[i].getPosition() + directionSteps[direction] * static_cast<float>(cell_size);
+                std::map<std::pair<float, float>, int>::const_iterator cell = cells.find(std::make_pair(position.x, position.y));
+                if (cell != cells.end()) {
+                    this->neighbours_[i][direction] = cell->second;
+                }
+            }
+        }
+        this->nodes_.resize(max_vehicles);
+        for (std::size_t i = 0; i < max_vehicles; i++) {
+            this->nodes_[i].next_ = this->freeNode_;
+            this->freeNode_ = i;
+        }
+        this->firstNodes_.assign(4 * roads.size(), -1);
+        this->lastNodes_.assign(4 * roads.size(), -1);
+        this->linkSizes_.assign(4 * roads.size(), 0);
+        this->isActive_.assign(4 * roads.size(), false);
+        this->activeLinks_.reserve(4 * roads.size());
+        this->isDetailed_.assign(roads.size(), false);
+    }
+
+    /**
+     * Method which sets if the road is simulated in detail. Vehicles standing on a detailed road are promoted in the
+     * next tick.
+     * @param road - Index of the road.
+     * @param is_detailed - True if vehicles on the road are Vehicle objects.
+     */
+    void QueueModel::setDetailed(int road, bool is_detailed)
+    {
+        this->isDetailed_[road] = is_detailed;
+    }
+
+    /**
+     * Method telling if the road is simulated in detail.
+     * @param road - Index of the road.
+     * @return - True if vehicles on the road are Vehicle objects.
+     */
+    bool QueueModel::isDetailed(int road) const
+    {
+        return this->isDetailed_[road];
+    }
+
+    /**
+     * Method adding vehicle at the end of the link of the road.
+     * @param road - Index of the road.
+     * @param direction - Direction in which the vehicle leaves the road.
+     * @param vehicle - Vehicle to add.
+     * @return - False if the link is full, true otherwise.
+     */
+    bool QueueModel::push(int road, int direction, const QueuedVehicle& vehicle)
+    {
+        int link = 4 * road + direction;
+        if (this->linkSizes_[link] >= QUEUE_LINK_CAPACITY || this->freeNode_ < 0) {
+            return false;
+        }
+        int node = this->freeNode_;
+        this->freeNode_ = this->nodes_[node].next_;
+        this->nodes_[node].vehicle_ = vehicle;
+        this->nodes_[node].next_ = -1;
+        if (this->lastNodes_[link] >= 0) {
+            this->nodes_[this->lastNodes_[link]].next_ = node;
+        }
+        else {
+            this->firstNodes_[link] = node;
+        }
+        this->lastNodes_[link] = node;
+        this->linkSizes_[link]++;
+        this->vehiclesCount_++;
+        if (!this->isActive_[link]) {
+            this->isActive_[link] = true;
+            this->activeLinks_.push_back(link);
+        }
+        return true;
+    }
+
+    /**
+     * Method removing the first vehicle of the link.
+     * @param link - Index of the link.
+     */
+    void QueueModel::pop(int link)
+    {
+        int node = this->firstNodes_[link];
+        this->firstNodes_[link] = this->nodes_[node].next_;
+        if (this->firstNodes_[link] < 0) {
+            this->lastNodes_[link] = -1;
+        }
+        this->nodes_[node].next_ = this->freeNode_;
+        this->freeNode_ = node;
+        this->linkSizes_[link]--;
+        this->vehiclesCount_--;
+    }
+
+    /**
+     * Method which makes one step of the queue model. First vehicles of links go on to next roads when they reached
+     * the end of their links, vehicles on detailed roads and vehicles reaching them are promoted.
+     * @param tick - Number of the current tick.
+     * @param promote - Function turning queued vehicle into Vehicle object standing at given position of the road,
+     * coming from the other road, or returning false if there is no room for it yet.
+     */
+    void QueueModel::tick(std::uint64_t tick, const Promote& promote)
+    {
+        for (std::size_t i = 0; i < this->activeLinks_.size(); i++) {
+            int link = this->activeLinks_[i];
+            int road = link / 4;
+            int direction = link % 4;
+            while (this->linkSizes_[link] > 0) {
+                const QueuedVehicle& vehicle = this->nodes_[this->firstNodes_[link]].vehicle_;
+                if (this->isDetailed_[road]) {
+                    const AABB& box = (*this->roads_)[road];
+                    const sf::Vector2f exits[4] = {sf::Vector2f(box.getPosition().x, box.top_), sf::Vector2f(box.getPosition().x, box.bottom_ - 1),
+                                                   sf::Vector2f(box.right_ - 1, box.getPosition().y), sf::Vector2f(box.left_, box.getPosition().y)};
+                    float distance = std::min<float>(vehicle.readyTick_ > tick ? (vehicle.readyTick_ - tick) * this->speed_ : 0, this->cellSize_ - 1);
+                    if (!promote(vehicle, road, road, direction, exits[direction] - directionSteps[direction] * distance)) {
+                        break;
+                    }
+                    this->pop(link);
+                    continue;
+                }
+                if (vehicle.readyTick_ > tick) {
+                    break;
+                }
+                int next = this->neighbours_[road][direction];
+                QueuedVehicle moved = {tick + this->travelTicks_, vehicle.spawnTick_, vehicle.isTruck_};
+                if (next < 0) {
+                    if (!this->push(road, oppositeDirections[direction], moved)) {
+                        break;
+                    }
+                }
+                else if (this->isDetailed_[next]) {
+                    if (!promote(vehicle, next, road, direction, this->getEntryPosition(next, direction))) {
+                        break;
+                    }
+                }
+                else if (!this->push(next, this->drawDirection(next, direction), moved)) {
+                    break;
+                }
+                this->pop(link);
+            }
+        }
+        std::size_t active = 0;
+        for (int link : this->activeLinks_) {
+            if (this->linkSizes_[link] > 0) {
+                this->activeLinks_[active++] = link;
+            }
+            else {
+                this->isActive_[link] = false;
+            }
+        }
+        this->activeLinks_.resize(active);
+    }
+
+    /**
+     * Method drawing direction in which vehicle entering the road leaves it. Roads other than the one it came from
+     * are drawn equally often, at dead ends it turns back.
+     * @param road - Index of the road.
+     * @param direction - Direction in which the vehicle entered the road.
+     * @return - Drawn direction.
+     */
+    int QueueModel::drawDirection(int road, int direction)
+    {
+        int directions[3];
+        int count = 0;
+        for (int next = 0; next < 4; next++) {
+            if (next != oppositeDirections[direction] && this->neighbours_[road][next] >= 0) {
+                directions[count++] = next;
+            }
+        }
+        if (count == 0) {
+            return oppositeDirections[direction];
+        }
+        return directions[std::uniform_int_distribution<>(0, count - 1)(this->engine_)];
+    }
+
+    /**
+     * Method returning position in which vehicle going in the direction enters the road.
+     * @param road - Index of the road.
+     * @param direction - Direction of the vehicle.
+     * @return - Position at the edge of the road, inside it.
+     */
+    sf::Vector2f QueueModel::getEntryPosition(int road, int direction) const
+    {
+        const AABB& box = (*this->roads_)[road];
+        const sf::Vector2f entries[4] = {sf::Vector2f(box.getPosition().x, box.bottom_ - 1), sf::Vector2f(box.getPosition().x, box.top_),
+                                         sf::Vector2f(box.left_, box.getPosition().y), sf::Vector2f(box.right_ - 1, box.getPosition().y)};
+        return entries[direction];
+    }
+
+    /**
+     * Method returning number of queued vehicles.
+     * @return - Number of vehicles.
+     */
+    std::size_t QueueModel::getVehiclesCount() const
+    {
+        return this->vehiclesCount_;
+    }
+
+    /**
+     * Method returning number of ticks in which a vehicle drives through a road.
+     * @return - Number of ticks.
+     */
+    int QueueModel::getTravelTicks() const
+    {
+        return this->travelTicks_;
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ * queue_model.hpp
+ * Header of QueueModel class.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+#include "SFML/Graphics.hpp"
+#include "aabb.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Struct with vehicle simulated by the queue model: only the tick in which it reaches the end of its road, the
+     * tick in which it appeared in the city and its type are known.
+     */
+    struct QueuedVehicle {
+        std::uint64_t readyTick_, spawnTick_;
+        bool isTruck_;
+    };
+
+    /**
+     * Class simulating vehicles outside the part of the city which is simulated in detail. Every road is split into
+     * four links, one for every side through which vehicles leave it, and a link is a queue of at most
+     * QUEUE_LINK_CAPACITY vehicles. A vehicle reaches the end of the link after the time of driving through a cell at
+     * full speed. Then it enters the next road if the link it draws there has room, choosing among the roads other
+     * than the one it came from, and it turns back at dead ends. Vehicles which reach a detailed road, or stand on
+     * a road which became detailed, are handed to a function which turns them into Vehicle objects.
+     * Directions are numbered: North 0, South 1, East 2, West 3.
+     */
+    class QueueModel {
+    public:
+        using Promote = std::function<bool(const QueuedVehicle& vehicle, int road, int from_road, int direction, sf::Vector2f position)>;
+        QueueModel(const std::vector<AABB>& roads, int cell_size, int speed, std::size_t max_vehicles, unsigned seed);
+        void setDetailed(int road, bool is_detailed);
+        bool isDetailed(int road) const;
+        bool push(int road, int direction, const QueuedVehicle& vehicle);
+        void tick(std::uint64_t tick, const Promote& promote);
+        std::size_t getVehiclesCount() const;
+        int getTravelTicks() const;
+    private:
+        /**
+         * Struct with queued vehicle and index of the next vehicle of its link, -1 for the last one.
+         */
+        struct Node {
+            QueuedVehicle vehicle_;
+            int next_;
+        };
+        void pop(int link);
+        int drawDirection(int road, int direction);
+        sf::Vector2f getEntryPosition(int road, int direction) const;
+        const std::vector<AABB>* roads_;
+        int cellSize_, speed_, travelTicks_;
+        std::size_t vehiclesCount_;
+        int freeNode_;
+        std::vector<Node> nodes_;
+        std::vector<std::array<int, 4>> neighbours_;
+        std::vector<int> firstNodes_, lastNodes_, activeLinks_;
+        std::vector<std::uint8_t> linkSizes_;
+        std::vector<bool> isDetailed_, isActive_;
+        std::minstd_rand engine_;
+    };
+}
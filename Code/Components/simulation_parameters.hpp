@@ -0,0 +1,35 @@
+/**
+ * simulation_parameters.hpp
+ * Header of SimulationParameters structure.
+ */
+
+#pragma once
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Tunable parameters of traffic. Default values are the ones used by the application.
+     */
+    struct SimulationParameters
+    {
+        /**
+         * Default constructor of SimulationParameters struct.
+         */
+        SimulationParameters() : spawnPercent_(SPAWN_PERCENT), vehiclesPerRoadsPercent_(VEHICLES_PER_ROADS_PERCENT),
+            vehicleSpeed_(VEHICLE_SPEED), unblockTicks_(VEHICLE_UNBLOCK_TICKS) {}
+
+        /**
+         * Parametrized constructor of SimulationParameters struct.
+         * @param spawn_percent - Chance (1-100) that a vehicle appears in a tick when the starting cell is free.
+         * @param vehicles_per_roads_percent - Maximal number of vehicles as percent of the number of roads.
+         * @param vehicle_speed - Distance travelled by a vehicle in one tick, in world units.
+         * @param unblock_ticks - Number of ticks a vehicle waits before it turns back.
+         */
+        SimulationParameters(int spawn_percent, int vehicles_per_roads_percent, int vehicle_speed, int unblock_ticks)
+            : spawnPercent_(spawn_percent), vehiclesPerRoadsPercent_(vehicles_per_roads_percent),
+              vehicleSpeed_(vehicle_speed), unblockTicks_(unblock_ticks) {}
+
+        int spawnPercent_, vehiclesPerRoadsPercent_, vehicleSpeed_, unblockTicks_;
+    };
+}
@@ -0,0 +1,45 @@
+/**
+ * snapshot_buffer.cpp
+ * Implementation of SnapshotBuffer class.
+ */
+
+#include "snapshot_buffer.hpp"
+#include <utility>
+
+namespace zpr {
+
+    /**
+     * Default constructor of SnapshotBuffer class.
+     */
+    SnapshotBuffer::SnapshotBuffer() : isWritten_(false) {}
+
+    /**
+     * Method copying vehicles to the buffer which is not drawn, replacing an older snapshot not taken by the render
+     * thread yet. It is called by the thread which moves the vehicles.
+     * @param vehicles - Vehicles to draw.
+     */
+    void SnapshotBuffer::write(const std::vector<std::shared_ptr<Vehicle>>& vehicles)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->written_.clear();
+        for (const std::shared_ptr<Vehicle>& vehicle : vehicles) {
+            this->written_.push_back(vehicle->getSnapshot());
+        }
+        this->isWritten_ = true;
+    }
+
+    /**
+     * Method returning the latest snapshot. It swaps buffers if a newer snapshot was written, and it is called only
+     * by the render thread, so the returned vector does not change until the next call.
+     * @return - Snapshots of vehicles to draw.
+     */
+    const std::vector<VehicleSnapshot>& SnapshotBuffer::read()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->isWritten_) {
+            std::swap(this->written_, this->read_);
+            this->isWritten_ = false;
+        }
+        return this->read_;
+    }
+}
@@ -0,0 +1,30 @@
+/**
+ * snapshot_buffer.hpp
+ * Header of SnapshotBuffer class.
+ */
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../vehicles/vehicle.hpp"
+#include "../vehicles/vehicle_snapshot.hpp"
+
+namespace zpr {
+
+    /**
+     * Class passing snapshots of vehicles from the simulation thread to the render thread. It is double-buffered:
+     * the simulation thread copies vehicles to one buffer, the render thread draws the other one and takes the
+     * newer buffer only when it starts drawing, so it never sees vehicles changed during a tick.
+     */
+    class SnapshotBuffer {
+    public:
+        SnapshotBuffer();
+        void write(const std::vector<std::shared_ptr<Vehicle>>& vehicles);
+        const std::vector<VehicleSnapshot>& read();
+    private:
+        std::mutex mutex_;
+        std::vector<VehicleSnapshot> written_, read_;
+        bool isWritten_;
+    };
+}
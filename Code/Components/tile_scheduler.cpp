@@ -0,0 +1,307 @@
+/**
+ * tile_scheduler.cpp
+ * Implementation of TileScheduler class.
+ */
+
+#include "tile_scheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Seconds which this thread spent running workers, so a worker run by another worker while waiting is not
+         * counted twice.
+         */
+        thread_local double workersSeconds = 0;
+    }
+
+    /**
+     * Parametrized constructor of TileScheduler class. Before the first rebalancing every worker gets the same number
+     * of tiles.
+     * @param grid_size - Size of the grid.
+     * @param cell_size - Size of a cell in world units.
+     * @param prefix - Position of the first cell in world units.
+     * @param threads - Number of workers, at least 1.
+     */
+    TileScheduler::TileScheduler(int grid_size, int cell_size, int prefix, int threads) : gridSize_(grid_size),
+        cellSize_(cell_size), prefix_(prefix), tilesPerSide_((grid_size + TILE_CELLS - 1) / TILE_CELLS),
+        threads_(std::max(1, threads)), ticksCount_(0), vehicles_(nullptr), move_(nullptr), progress_(new Progress[std::max(1, threads)]),
+        waitingCount_(0)
+    {
+        int tiles_count = this->tilesPerSide_ * this->tilesPerSide_;
+        this->owners_.resize(tiles_count);
+        this->tileVehicles_.resize(tiles_count);
+        this->workerVehicles_.resize(this->threads_);
+        this->tileCosts_.assign(tiles_count, 1.0);
+        this->measuredCosts_.assign(tiles_count, 0.0);
+        this->rebalance();
+    }
+
+    /**
+     * Method assigning vehicles to tiles and workers, and remembering where they stand before the tick.
+     * @param vehicles - Vehicles of the simulation, in order of moving. They must not change until run() returns.
+     */
+    void TileScheduler::prepare(const std::vector<std::shared_ptr<Vehicle>>& vehicles)
+    {
+        this->vehicles_ = &vehicles;
+        for (int tile : this->occupiedTiles_) {
+            this->tileVehicles_[tile].clear();
+        }
+        this->occupiedTiles_.clear();
+        for (std::vector<std::size_t>& worker_vehicles : this->workerVehicles_) {
+            worker_vehicles.clear();
+        }
+        this->vehicleTiles_.resize(vehicles.size());
+        this->oldShapes_.resize(vehicles.size());
+        for (std::size_t i = 0; i < vehicles.size(); i++) {
+            const AABB& shape = vehicles[i]->getShape();
+            int tile = this->getTile(shape.getPosition());
+            if (this->tileVehicles_[tile].empty()) {
+                this->occupiedTiles_.push_back(tile);
+            }
+            this->vehicleTiles_[i] = tile;
+            this->oldShapes_[i] = shape;
+            this->tileVehicles_[tile].push_back(i);
+            this->workerVehicles_[this->owners_[tile]].push_back(i);
+        }
+    }
+
+    /**
+     * Method moving every vehicle prepared by prepare(). Workers are submitted to the Executor and the calling thread
+     * runs the ones no other thread took, until every worker ends.
+     * @param move - Function making one step of the vehicle with given index, called by the owning worker.
+     */
+    void TileScheduler::run(const std::function<void(std::size_t index, int worker)>& move)
+    {
+        this->move_ = &move;
+        for (int i = 0; i < this->threads_; i++) {
+            this->progress_[i].value_.store(this->workerVehicles_[i].empty() ? std::numeric_limits<std::size_t>::max() : 0, std::memory_order_relaxed);
+            this->progress_[i].isClaimed_.store(false, std::memory_order_relaxed);
+            this->progress_[i].next_ = 0;
+        }
+        auto run_workers = [this]() {
+            bool is_done = true;
+            for (int i = 0; i < this->threads_; i++) {
+                if (this->progress_[i].value_.load(std::memory_order_acquire) == std::numeric_limits<std::size_t>::max()) {
+                    continue;
+                }
+                is_done = false;
+                if (!this->progress_[i].isClaimed_.exchange(true, std::memory_order_acq_rel)) {
+                    this->runWorker(i, std::numeric_limits<std::size_t>::max());
+                }
+            }
+            return is_done;
+        };
+        TaskGroup task_group;
+        for (int i = 1; i < this->threads_; i++) {
+            task_group.run(run_workers);
+        }
+        while (!run_workers()) {
+            this->wait([this]() {
+                for (int i = 0; i < this->threads_; i++) {
+                    if (this->progress_[i].value_.load(std::memory_order_acquire) != std::numeric_limits<std::size_t>::max()) {
+                        return !this->progress_[i].isClaimed_.load(std::memory_order_acquire);
+                    }
+                }
+                return true;
+            });
+        }
+        task_group.wait();
+        this->ticksCount_++;
+        if (this->ticksCount_ % TILES_REBALANCE_TICKS == 0) {
+            this->rebalance();
+        }
+    }
+
+    /**
+     * Method moving vehicles of the worker in order, from the first one not moved yet, and measuring time spent on
+     * their tiles. The worker is released afterwards, so another thread can move its next vehicles.
+     * @param worker - Number of the worker, claimed by the calling thread.
+     * @param last - Index of the last vehicle to move.
+     */
+    void TileScheduler::runWorker(int worker, std::size_t last)
+    {
+        std::chrono::steady_clock::time_point worker_start = std::chrono::steady_clock::now();
+        Progress& progress = this->progress_[worker];
+        const std::vector<std::size_t>& worker_vehicles = this->workerVehicles_[worker];
+        for (; progress.next_ < worker_vehicles.size() && worker_vehicles[progress.next_] <= last; progress.next_++) {
+            std::size_t index = worker_vehicles[progress.next_];
+            double workers_seconds = workersSeconds;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            (*this->move_)(index, worker);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            this->measuredCosts_[this->vehicleTiles_[index]] += elapsed.count() - (workersSeconds - workers_seconds);
+            progress.value_.store(index + 1, std::memory_order_release);
+            this->notifyProgress();
+        }
+        if (progress.next_ == worker_vehicles.size()) {
+            progress.value_.store(std::numeric_limits<std::size_t>::max(), std::memory_order_release);
+        }
+        progress.isClaimed_.store(false, std::memory_order_release);
+        this->notifyProgress();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - worker_start;
+        workersSeconds += elapsed.count();
+    }
+
+    /**
+     * Method putting the thread to sleep until the condition is met. Threads which change progress of workers call
+     * notifyProgress() afterwards.
+     * @param is_ready - Condition on progress of workers.
+     */
+    template <typename Predicate>
+    void TileScheduler::wait(Predicate is_ready)
+    {
+        this->waitingCount_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(this->waitMutex_);
+            this->waitCondition_.wait(lock, is_ready);
+        }
+        this->waitingCount_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Method waking sleeping threads after progress of a worker changed. It only locks when a thread sleeps.
+     */
+    void TileScheduler::notifyProgress()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->waitingCount_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(this->waitMutex_);
+            this->waitCondition_.notify_all();
+        }
+    }
+
+    /**
+     * Method checking if the vehicle is going to hit another vehicle from its halo. Vehicles of other workers which
+     * appeared earlier are checked after they moved, younger ones where they stood before the tick. Progress of the
+     * worker is published first, as every earlier vehicle of the worker has moved, so workers waiting for it can go on.
+     * @param index - Index of the vehicle.
+     * @param worker - Worker moving the vehicle.
+     * @return - True if there is a collision, false otherwise.
+     */
+    bool TileScheduler::checkColision(std::size_t index, int worker)
+    {
+        this->progress_[worker].value_.store(index, std::memory_order_release);
+        this->notifyProgress();
+        const Vehicle& vehicle = *(*this->vehicles_)[index];
+        sf::Vector2f position = vehicle.getShape().getPosition();
+        int row = this->vehicleTiles_[index] / this->tilesPerSide_;
+        int column = this->vehicleTiles_[index] % this->tilesPerSide_;
+        for (int i = std::max(row - 1, 0); i <= std::min(row + 1, this->tilesPerSide_ - 1); i++) {
+            for (int j = std::max(column - 1, 0); j <= std::min(column + 1, this->tilesPerSide_ - 1); j++) {
+                int tile = i * this->tilesPerSide_ + j;
+                int owner = this->owners_[tile];
+                for (std::size_t colider : this->tileVehicles_[tile]) {
+                    const AABB* shape = &this->oldShapes_[colider];
+                    if (owner == worker || colider < index) {
+                        Progress& progress = this->progress_[owner];
+                        while (owner != worker && progress.value_.load(std::memory_order_acquire) <= colider) {
+                            if (!progress.isClaimed_.exchange(true, std::memory_order_acq_rel)) {
+                                this->runWorker(owner, colider);
+                                continue;
+                            }
+                            this->wait([&progress, colider]() {
+                                return progress.value_.load(std::memory_order_acquire) > colider || !progress.isClaimed_.load(std::memory_order_acquire);
+                            });
+                        }
+                        shape = &(*this->vehicles_)[colider]->getShape();
+                    }
+                    if (shape->getPosition() != position && vehicle.colisionBox_.intersects(*shape)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Method returning number of workers.
+     * @return - Number of workers.
+     */
+    int TileScheduler::getThreadsCount() const
+    {
+        return this->threads_;
+    }
+
+    /**
+     * Method returning number of tiles in a row.
+     * @return - Number of tiles along one side of the map.
+     */
+    int TileScheduler::getTilesPerSide() const
+    {
+        return this->tilesPerSide_;
+    }
+
+    /**
+     * Method returning worker owning the tile.
+     * @param tile - Number of the tile, row by row.
+     * @return - Number of the worker.
+     */
+    int TileScheduler::getOwner(int tile) const
+    {
+        return this->owners_[tile];
+    }
+
+    /**
+     * Method returning tile containing the point.
+     * @param point - Point in world units.
+     * @return - Number of the tile, row by row.
+     */
+    int TileScheduler::getTile(sf::Vector2f point) const
+    {
+        return this->getAxisTile(point.y) * this->tilesPerSide_ + this->getAxisTile(point.x);
+    }
+
+    /**
+     * Method returning tile containing the coordinate along one axis.
+     * @param coordinate - Coordinate in world units.
+     * @return - Number of the tile along the axis.
+     */
+    int TileScheduler::getAxisTile(float coordinate) const
+    {
+        int cell = static_cast<int>(std::floor((coordinate - this->prefix_) / this->cellSize_));
+        return std::min(std::max(cell, 0), this->gridSize_ - 1) / TILE_CELLS;
+    }
+
+    /**
+     * Method splitting tiles between workers by their cost. Until the first measurement every tile costs the same,
+     * later costs are smoothed with earlier measurements. Tiles are taken in serpentine order and cut into contiguous
+     * parts of equal cost, so neighbouring tiles mostly stay with the same worker.
+     */
+    void TileScheduler::rebalance()
+    {
+        double total = 0;
+        for (std::size_t i = 0; i < this->tileCosts_.size(); i++) {
+            if (this->ticksCount_ == TILES_REBALANCE_TICKS) {
+                this->tileCosts_[i] = this->measuredCosts_[i];
+            }
+            else if (this->ticksCount_ != 0) {
+                this->tileCosts_[i] = (this->tileCosts_[i] + this->measuredCosts_[i]) / 2;
+            }
+            this->measuredCosts_[i] = 0;
+            total += this->tileCosts_[i];
+        }
+        if (total == 0) {
+            return;
+        }
+        double accumulated = 0;
+        int worker = 0;
+        for (int row = 0; row < this->tilesPerSide_; row++) {
+            for (int i = 0; i < this->tilesPerSide_; i++) {
+                int tile = row * this->tilesPerSide_ + (row % 2 == 0 ? i : this->tilesPerSide_ - 1 - i);
+                while (worker < this->threads_ - 1 && accumulated >= total * (worker + 1) / this->threads_) {
+                    worker++;
+                }
+                this->owners_[tile] = worker;
+                accumulated += this->tileCosts_[tile];
+            }
+        }
+    }
+}
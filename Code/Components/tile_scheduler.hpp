@@ -0,0 +1,72 @@
+/**
+ * tile_scheduler.hpp
+ * Header of TileScheduler class.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "aabb.hpp"
+#include "executor.hpp"
+#include "../vehicles/vehicle.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Class moving vehicles of one tick on several workers run as Executor tasks. The map is split into square tiles
+     * of TILE_CELLS cells and every worker owns a contiguous part of the tiles, taken in serpentine order. Tiles at
+     * the edge reach to infinity, so the enter road above the city belongs to the first row of tiles.
+     * Vehicles are moved in the same order as by one thread: a vehicle checks collisions only with vehicles of its tile
+     * and the eight neighbouring ones (its halo), waits until other workers moved halo vehicles which appeared earlier
+     * and sees younger ones where they stood before the tick. A thread waiting for a worker which no thread runs
+     * moves its vehicles up to the awaited one itself, so workers never wait for tasks stuck in the Executor queue.
+     * Otherwise it sleeps until another thread moves a vehicle or releases a worker.
+     * Time spent on every tile is measured and every TILES_REBALANCE_TICKS ticks tiles are split again so that every
+     * worker gets the same part of the cost.
+     */
+    class TileScheduler {
+    public:
+        TileScheduler(int grid_size, int cell_size, int prefix, int threads);
+        void prepare(const std::vector<std::shared_ptr<Vehicle>>& vehicles);
+        void run(const std::function<void(std::size_t index, int worker)>& move);
+        bool checkColision(std::size_t index, int worker);
+        int getThreadsCount() const;
+        int getTilesPerSide() const;
+        int getOwner(int tile) const;
+    private:
+        /**
+         * Struct with index of the next vehicle which the worker moves, flag set by the thread which runs the worker
+         * and position in vehicles of the worker, on its own cache line.
+         */
+        struct alignas(64) Progress {
+            std::atomic<std::size_t> value_;
+            std::atomic<bool> isClaimed_;
+            std::size_t next_;
+        };
+        void runWorker(int worker, std::size_t last);
+        template <typename Predicate>
+        void wait(Predicate is_ready);
+        void notifyProgress();
+        int getTile(sf::Vector2f point) const;
+        int getAxisTile(float coordinate) const;
+        void rebalance();
+        int gridSize_, cellSize_, prefix_, tilesPerSide_, threads_;
+        std::uint64_t ticksCount_;
+        const std::vector<std::shared_ptr<Vehicle>>* vehicles_;
+        const std::function<void(std::size_t index, int worker)>* move_;
+        std::vector<int> vehicleTiles_, owners_, occupiedTiles_;
+        std::vector<AABB> oldShapes_;
+        std::vector<std::vector<std::size_t>> tileVehicles_, workerVehicles_;
+        std::vector<double> tileCosts_, measuredCosts_;
+        std::unique_ptr<Progress[]> progress_;
+        std::atomic<int> waitingCount_;
+        std::mutex waitMutex_;
+        std::condition_variable waitCondition_;
+    };
+}
@@ -5,24 +5,99 @@
 
 #pragma once
 
-#include <iostream>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
-#include <chrono>
+#include "executor.hpp"
 
 namespace zpr{
 
     /**
-     Class responsible for making new thread for vehicles simulation.
+     Class responsible for running functions later or periodically on the Executor.
      */
     class Timer {
-        bool clear_ = false;
+        /**
+         * State shared by the timer and its functions waiting in the Executor: whether the timer was stopped and
+         * whether one of its functions is running now, and on which thread.
+         */
+        struct State {
+            std::mutex mutex_;
+            std::condition_variable finished_;
+            bool isCleared_ = false;
+            int runningCount_ = 0;
+            std::thread::id runningThread_;
+        };
+        std::shared_ptr<State> state_ = std::make_shared<State>();
+
+        /**
+         * Template method which runs the function, unless the timer was stopped, and marks it as running meanwhile.
+         * @param function - Function which will be executed.
+         * @param state - State of the timer.
+         * @return - False if the timer was stopped and the function was not executed.
+         */
+        template <typename Function>
+        static bool runFunction(Function& function, const std::shared_ptr<State>& state) {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex_);
+                if(state->isCleared_) return false;
+                state->runningCount_++;
+                state->runningThread_ = std::this_thread::get_id();
+            }
+            try {
+                function();
+            }
+            catch (...) {
+                finishRun(*state);
+                throw;
+            }
+            finishRun(*state);
+            return true;
+        };
+
+        /**
+         * Method marking that a function of the timer ended and waking threads stopping the timer.
+         * @param state - State of the timer.
+         */
+        static void finishRun(State& state) {
+            std::lock_guard<std::mutex> lock(state.mutex_);
+            state.runningCount_--;
+            state.runningThread_ = std::thread::id();
+            state.finished_.notify_all();
+        };
+
+        /**
+         * Template method which submits next run of the periodic function, unless the timer was stopped.
+         * @param function - Function which will be executed.
+         * @param interval - Interval of time after function is executed.
+         * @param state - State of the timer.
+         */
+        template <typename Function>
+        static void scheduleInterval(Function function, int interval, std::shared_ptr<State> state) {
+            Executor::instance().submitAfter(interval, [=]() mutable {
+                if(!runFunction(function, state)) return;
+                scheduleInterval(function, interval, state);
+            });
+        };
 
     public:
         /**
-         * Method which stops the "timer" - deletes thread.
+         * Destructor of Timer class. It stops the timer, so functions still waiting in the Executor, which finishes
+         * pending tasks when the application closes, do not use destroyed objects.
+         */
+        ~Timer(){
+            this->stopTimer();
+        };
+        /**
+         * Method which stops the "timer" - functions waiting for their time are not executed. If a function of the
+         * timer is running, it waits until it ends, unless it is called by that function.
          */
         void stopTimer(){
-            this->clear_ = true;
+            std::unique_lock<std::mutex> lock(this->state_->mutex_);
+            this->state_->isCleared_ = true;
+            this->state_->finished_.wait(lock, [this]() {
+                return this->state_->runningCount_ == 0 || this->state_->runningThread_ == std::this_thread::get_id();
+            });
         };
         /**
          * Template method which allows to execute function after certain delay.
@@ -31,32 +106,22 @@ namespace zpr{
          */
         template <typename Function>
         void setTimeout(Function function, int delay) {
-            this->clear_ = false;
-            std::thread t([=]() {
-                if(this->clear_) return;
-                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-                if(this->clear_) return;
-                function();
-                });
-            t.detach();
+            this->state_ = std::make_shared<State>();
+            std::shared_ptr<State> state = this->state_;
+            Executor::instance().submitAfter(delay, [=]() mutable {
+                runFunction(function, state);
+            });
         };
         /**
-         * Template method which allows to execute function after certain delay.
+         * Template method which allows to execute function periodically. Next delay starts when the function ends,
+         * so runs of the function never overlap.
          * @param function - Function which will be executed.
          * @param interval - Interval of time after function is executed.
          */
         template <typename Function>
         void setInterval(Function function, int interval) {
-            this->clear_ = false;
-            std::thread t([=]() {
-                while(true) {
-                    if(this->clear_) return;
-                    std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-                    if(this->clear_) return;
-                    function();
-                }
-            });
-            t.detach();
+            this->state_ = std::make_shared<State>();
+            scheduleInterval(function, interval, this->state_);
         };
     };
 }
@@ -0,0 +1,32 @@
+/**
+ * camera_counter.cpp
+ * Implementation of CameraCounter class.
+ */
+
+#include "camera_counter.hpp"
+
+namespace zpr {
+
+    /**
+     * Default constructor of CameraCounter class. Every count is 0.
+     */
+    CameraCounter::CameraCounter() : cars_(), trucks_() {}
+
+    /**
+     * Method counting car seen by the camera.
+     * @param which_label - Number of the camera.
+     */
+    void CameraCounter::updateCarsLabel(int which_label)
+    {
+        this->cars_[which_label - 1]++;
+    }
+
+    /**
+     * Method counting truck seen by the camera.
+     * @param which_label - Number of the camera.
+     */
+    void CameraCounter::updateTrucksLabel(int which_label)
+    {
+        this->trucks_[which_label - 1]++;
+    }
+}
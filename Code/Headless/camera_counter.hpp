@@ -0,0 +1,24 @@
+/**
+ * camera_counter.hpp
+ * Header of CameraCounter class.
+ */
+
+#pragma once
+#include <array>
+#include "../observers/simulation_observer.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Class counting vehicles reported by cameras of one simulation. Every simulation gets its own counter,
+     * so counts are not shared between runs.
+     */
+    class CameraCounter : public SimulationObserver {
+    public:
+        CameraCounter();
+        void updateCarsLabel(int which_label) override;
+        void updateTrucksLabel(int which_label) override;
+        std::array<long, CAMERAS_COUNT> cars_, trucks_;
+    };
+}
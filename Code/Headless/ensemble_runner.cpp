@@ -0,0 +1,254 @@
+/**
+ * ensemble_runner.cpp
+ * Implementation of EnsembleRunner class.
+ */
+
+#include "ensemble_runner.hpp"
+#include "parallel_loop.hpp"
+#include "camera_counter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Function returning 97.5% quantile of Student's t-distribution, used for two-sided 95% confidence intervals.
+         * Above 30 degrees of freedom the Cornish-Fisher approximation is accurate to 0.003.
+         * @param degrees_of_freedom - Degrees of freedom, at least 1.
+         * @return - Quantile.
+         */
+        double getStudentQuantile(int degrees_of_freedom)
+        {
+            static const double quantiles[30] = {
+                12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+                2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+            };
+            if (degrees_of_freedom <= 30) {
+                return quantiles[degrees_of_freedom - 1];
+            }
+            const double z = 1.959964;
+            return z + (z * z * z + z) / (4.0 * degrees_of_freedom);
+        }
+
+        /**
+         * Function writing statistics as JSON object.
+         * @param stream - Output stream.
+         * @param stats - Statistics of every camera.
+         */
+        void writeStats(std::ostream& stream, const std::array<CountStats, CAMERAS_COUNT>& stats)
+        {
+            stream << "[";
+            for (std::size_t i = 0; i < stats.size(); i++) {
+                stream << (i == 0 ? "" : ",") << "{\"mean\":" << stats[i].mean_ << ",\"stddev\":" << stats[i].standardDeviation_
+                       << ",\"ci95\":" << stats[i].confidence_ << "}";
+            }
+            stream << "]";
+        }
+    }
+
+    /**
+     * Parametrized constructor of EnsembleRunner class.
+     * @param ticks - Number of simulation ticks of every run.
+     * @param first_seed - Seed of the first run, next runs use next seeds.
+     * @param runs - Number of runs.
+     * @param threads - Number of threads, 0 to use every core.
+     */
+    EnsembleRunner::EnsembleRunner(int ticks, unsigned first_seed, int runs, int threads) : ticks_(ticks), runs_(runs),
+        threads_(threads), firstSeed_(first_seed) {}
+
+    /**
+     * Method making every run of the scenario on the pool of threads.
+     * @param scenario - Scenario to run, it is only read.
+     * @return - Counts of every run, ordered by seed.
+     */
+    std::vector<EnsembleRun> EnsembleRunner::runAll(const Scenario& scenario) const
+    {
+        std::vector<EnsembleRun> runs(this->runs_);
+        ParallelLoop::run(this->runs_, this->threads_, [&](int run) {
+            runs[run] = this->runOne(scenario, this->firstSeed_ + run);
+        });
+        return runs;
+    }
+
+    /**
+     * Method making every run of the scenario and aggregating counts of cameras.
+     * @param scenario - Scenario to run.
+     * @return - Statistics of the ensemble.
+     */
+    EnsembleResult EnsembleRunner::run(const Scenario& scenario) const
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        EnsembleResult result = aggregate(scenario.name_, this->ticks_, this->runAll(scenario));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        result.seconds_ = elapsed.count();
+        return result;
+    }
+
+    /**
+     * Method making one seeded run on the calling thread.
+     * @param scenario - Scenario to run.
+     * @param seed - Seed of the run.
+     * @return - Counts of cameras.
+     */
+    EnsembleRun EnsembleRunner::runOne(const Scenario& scenario, unsigned seed) const
+    {
+        std::shared_ptr<SimulationHandler> simulation_handler = ScenarioRunner::createSimulation(scenario, seed);
+        std::shared_ptr<CameraCounter> counter = std::make_shared<CameraCounter>();
+        simulation_handler->add(counter);
+        for (int i = 0; i < this->ticks_; i++) {
+            simulation_handler->tick();
+        }
+        return EnsembleRun{seed, counter->cars_, counter->trucks_};
+    }
+
+    /**
+     * Method calculating statistics of cars and trucks seen by every camera.
+     * @param name - Name of the scenario.
+     * @param ticks - Number of ticks of every run.
+     * @param runs - Counts of every run.
+     * @return - Statistics of the ensemble.
+     */
+    EnsembleResult EnsembleRunner::aggregate(const std::string& name, int ticks, const std::vector<EnsembleRun>& runs)
+    {
+        EnsembleResult result{name, static_cast<int>(runs.size()), ticks, {}, {}, 0};
+        std::vector<double> cars(runs.size()), trucks(runs.size());
+        for (int camera = 0; camera < CAMERAS_COUNT; camera++) {
+            for (std::size_t i = 0; i < runs.size(); i++) {
+                cars[i] = runs[i].cars_[camera];
+                trucks[i] = runs[i].trucks_[camera];
+            }
+            result.cars_[camera] = getStats(cars);
+            result.trucks_[camera] = getStats(trucks);
+        }
+        return result;
+    }
+
+    /**
+     * Method calculating mean, sample standard deviation and 95% confidence interval of the mean (Student's t).
+     * @param values - Values, one per run.
+     * @return - Statistics, interval is 0 for less than two values.
+     */
+    CountStats EnsembleRunner::getStats(const std::vector<double>& values)
+    {
+        CountStats stats{0, 0, 0};
+        if (values.empty()) {
+            return stats;
+        }
+        for (double value : values) {
+            stats.mean_ += value;
+        }
+        stats.mean_ /= values.size();
+        if (values.size() < 2) {
+            return stats;
+        }
+        double squares = 0;
+        for (double value : values) {
+            squares += (value - stats.mean_) * (value - stats.mean_);
+        }
+        stats.standardDeviation_ = std::sqrt(squares / (values.size() - 1));
+        stats.confidence_ = getStudentQuantile(values.size() - 1) * stats.standardDeviation_ / std::sqrt(values.size());
+        return stats;
+    }
+
+    /**
+     * Method putting cameras on road cells of the scenario, in order of numbers.
+     * @param scenario - Scenario to change.
+     * @param positions - Positions as "row:column" separated by commas, at most CAMERAS_COUNT.
+     * @return - False if position is not a road of the scenario or there are too many positions, true otherwise.
+     */
+    bool EnsembleRunner::placeCameras(Scenario& scenario, const std::string& positions)
+    {
+        std::istringstream stream(positions);
+        std::string position;
+        int camera = 0;
+        while (std::getline(stream, position, ',')) {
+            std::size_t separator = position.find(':');
+            if (++camera > CAMERAS_COUNT || separator == std::string::npos) {
+                return false;
+            }
+            sf::Vector2i wanted(std::stoi(position.substr(0, separator)), std::stoi(position.substr(separator + 1)));
+            std::vector<Cell>::iterator cell = std::find_if(scenario.cells_.begin(), scenario.cells_.end(), [&](const Cell& cell) {
+                return cell.containsRoad_ && cell.getPosition() == wanted;
+            });
+            if (cell == scenario.cells_.end()) {
+                return false;
+            }
+            cell->containsCamera_ = true;
+            cell->whichCamera_ = camera;
+        }
+        return true;
+    }
+
+    /**
+     * Method putting cameras on roads which vehicles reach from the entrance: camera n stands on the first road found
+     * 4 * n cells away from the starting cell. Saved maps do not store cameras, so ensembles use these by default.
+     * @param scenario - Scenario to change.
+     */
+    void EnsembleRunner::placeDefaultCameras(Scenario& scenario)
+    {
+        const int camera_spacing = 4;
+        int grid_size = scenario.gridSize_;
+        std::vector<int> cell_index(grid_size * grid_size, -1);
+        for (std::size_t i = 0; i < scenario.cells_.size(); i++) {
+            sf::Vector2i position = scenario.cells_[i].getPosition();
+            if (scenario.cells_[i].containsRoad_) {
+                cell_index[position.x * grid_size + position.y] = i;
+            }
+        }
+        std::vector<int> distance(grid_size * grid_size, -1);
+        std::queue<sf::Vector2i> queue;
+        if (grid_size > 4 && cell_index[4] >= 0) {
+            queue.push(sf::Vector2i(0, 4));
+            distance[4] = 0;
+        }
+        int camera = 0;
+        while (!queue.empty() && camera < CAMERAS_COUNT) {
+            sf::Vector2i cell = queue.front();
+            queue.pop();
+            int current = distance[cell.x * grid_size + cell.y];
+            if (current == camera_spacing * (camera + 1)) {
+                Cell& camera_cell = scenario.cells_[cell_index[cell.x * grid_size + cell.y]];
+                camera_cell.containsCamera_ = true;
+                camera_cell.whichCamera_ = ++camera;
+            }
+            const sf::Vector2i steps[] = {sf::Vector2i(1, 0), sf::Vector2i(0, 1), sf::Vector2i(0, -1), sf::Vector2i(-1, 0)};
+            for (const sf::Vector2i& step : steps) {
+                sf::Vector2i next = cell + step;
+                if (next.x < 0 || next.y < 0 || next.x >= grid_size || next.y >= grid_size) {
+                    continue;
+                }
+                int index = next.x * grid_size + next.y;
+                if (cell_index[index] >= 0 && distance[index] < 0) {
+                    distance[index] = current + 1;
+                    queue.push(next);
+                }
+            }
+        }
+    }
+
+    /**
+     * Method writing results of ensembles as JSON, one scenario per line.
+     * @param stream - Output stream.
+     * @param results - Results of ensembles.
+     */
+    void EnsembleRunner::writeJson(std::ostream& stream, const std::vector<EnsembleResult>& results)
+    {
+        stream << "{\"ensembles\":[";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const EnsembleResult& result = results[i];
+            stream << (i == 0 ? "" : ",") << "\n{\"name\":\"" << result.name_ << "\",\"runs\":" << result.runs_
+                   << ",\"ticks\":" << result.ticks_ << std::fixed << std::setprecision(3) << ",\"cars\":";
+            writeStats(stream, result.cars_);
+            stream << ",\"trucks\":";
+            writeStats(stream, result.trucks_);
+            stream << ",\"seconds\":" << result.seconds_ << "}";
+        }
+        stream << "\n]}\n";
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * ensemble_runner.hpp
+ * Header of EnsembleRunner class.
+ */
+
+#pragma once
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "scenario_runner.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Struct with numbers of cars and trucks seen by every camera in one seeded run.
+     */
+    struct EnsembleRun {
+        unsigned seed_;
+        std::array<long, CAMERAS_COUNT> cars_, trucks_;
+    };
+
+    /**
+     * Struct with mean, sample standard deviation and half-width of 95% confidence interval of the mean.
+     */
+    struct CountStats {
+        double mean_, standardDeviation_, confidence_;
+    };
+
+    /**
+     * Struct with statistics of cars and trucks seen by every camera over every run of the ensemble.
+     */
+    struct EnsembleResult {
+        std::string name_;
+        int runs_, ticks_;
+        std::array<CountStats, CAMERAS_COUNT> cars_, trucks_;
+        double seconds_;
+    };
+
+    /**
+     * Class running the same scenario with consecutive seeds on a pool of threads. Every run owns its simulation and
+     * writes only its own EnsembleRun, so runs share nothing but the index of the next run to take.
+     */
+    class EnsembleRunner {
+    public:
+        EnsembleRunner(int ticks, unsigned first_seed, int runs, int threads);
+        std::vector<EnsembleRun> runAll(const Scenario& scenario) const;
+        EnsembleResult run(const Scenario& scenario) const;
+        static EnsembleResult aggregate(const std::string& name, int ticks, const std::vector<EnsembleRun>& runs);
+        static CountStats getStats(const std::vector<double>& values);
+        static bool placeCameras(Scenario& scenario, const std::string& positions);
+        static void placeDefaultCameras(Scenario& scenario);
+        static void writeJson(std::ostream& stream, const std::vector<EnsembleResult>& results);
+    private:
+        EnsembleRun runOne(const Scenario& scenario, unsigned seed) const;
+        int ticks_, runs_, threads_;
+        unsigned firstSeed_;
+    };
+}
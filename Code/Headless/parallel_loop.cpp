@@ -0,0 +1,46 @@
+/**
+ * parallel_loop.cpp
+ * Implementation of ParallelLoop class.
+ */
+
+#include "parallel_loop.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace zpr {
+
+    /**
+     * Method returning number of threads to use.
+     * @param threads - Wanted number of threads, 0 to use every core.
+     * @return - Number of threads, at least 1.
+     */
+    int ParallelLoop::getThreadsCount(int threads)
+    {
+        return threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * Method calling body for every iteration and waiting until all of them end.
+     * @param count - Number of iterations.
+     * @param threads - Number of threads, 0 to use every core.
+     * @param body - Function called with number of the iteration, from 0 to count - 1.
+     */
+    void ParallelLoop::run(int count, int threads, const std::function<void(int)>& body)
+    {
+        std::atomic<int> next(0);
+        std::vector<std::thread> workers;
+        int workers_count = std::min(getThreadsCount(threads), count);
+        for (int i = 0; i < workers_count; i++) {
+            workers.emplace_back([&]() {
+                for (int iteration = next.fetch_add(1); iteration < count; iteration = next.fetch_add(1)) {
+                    body(iteration);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * parallel_loop.hpp
+ * Header of ParallelLoop class.
+ */
+
+#pragma once
+#include <functional>
+
+namespace zpr {
+
+    /**
+     * Class running independent iterations on a pool of threads. Threads take iterations one by one, so long and short
+     * iterations even out; iterations share nothing but the index of the next one to take.
+     */
+    class ParallelLoop {
+    public:
+        static int getThreadsCount(int threads);
+        static void run(int count, int threads, const std::function<void(int)>& body);
+    };
+}
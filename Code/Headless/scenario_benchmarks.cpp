@@ -0,0 +1,256 @@
+/**
+ * scenario_benchmarks.cpp
+ * End-to-end scenario benchmarks run without window.
+ */
+
+#include "scenario_runner.hpp"
+#include "ensemble_runner.hpp"
+#include "sweep_runner.hpp"
+#include "sharded_runner.hpp"
+#include "../helpers/command_line.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+    /**
+     * Function printing result of one scenario.
+     * @param result - Result of the scenario.
+     */
+    void printResult(const zpr::ScenarioResult& result)
+    {
+        std::cout << std::left << std::setw(14) << result.name_ << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << result.ticksPerSecond_ << " ticks/s" << std::setw(10) << result.peakRss_ / 1024.0 << " MB peak RSS"
+                  << std::setw(8) << result.exitedVehicles_ << " vehicles exited" << std::endl;
+    }
+
+    /**
+     * Function printing result of one ensemble: mean and 95% confidence interval of vehicles seen by every camera.
+     * @param result - Result of the ensemble.
+     */
+    void printEnsembleResult(const zpr::EnsembleResult& result)
+    {
+        std::cout << result.name_ << ": " << result.runs_ << " runs of " << result.ticks_ << " ticks in " << std::fixed
+                  << std::setprecision(2) << result.seconds_ << " s" << std::endl;
+        for (int i = 0; i < CAMERAS_COUNT; i++) {
+            std::cout << "  camera " << i + 1 << std::setprecision(2) << std::setw(10) << result.cars_[i].mean_ << " +- "
+                      << std::left << std::setw(8) << result.cars_[i].confidence_ << std::right << " cars"
+                      << std::setw(10) << result.trucks_[i].mean_ << " +- " << std::left << std::setw(8)
+                      << result.trucks_[i].confidence_ << std::right << " trucks" << std::endl;
+        }
+    }
+
+    /**
+     * Function printing the best configurations of the sweep.
+     * @param configurations - Configurations, best first.
+     * @param count - Number of printed configurations.
+     */
+    void printSweepResult(const std::vector<zpr::SweepConfiguration>& configurations, std::size_t count)
+    {
+        std::cout << "  spawn %  vehicles %  speed  unblock     ticks  exits/1000 ticks  travel ticks" << std::endl;
+        for (std::size_t i = 0; i < configurations.size() && i < count; i++) {
+            const zpr::SweepConfiguration& configuration = configurations[i];
+            std::cout << std::setw(9) << configuration.parameters_.spawnPercent_ << std::setw(12)
+                      << configuration.parameters_.vehiclesPerRoadsPercent_ << std::setw(7) << configuration.parameters_.vehicleSpeed_
+                      << std::setw(9) << configuration.parameters_.unblockTicks_ << std::setw(10) << configuration.ticks_
+                      << std::fixed << std::setprecision(2) << std::setw(18) << configuration.throughput_
+                      << std::setw(14) << configuration.travelTicks_ << std::endl;
+        }
+    }
+
+    /**
+     * Function printing result of one simulation split into regions.
+     * @param result - Result of the simulation.
+     */
+    void printShardedResult(const zpr::ShardedResult& result)
+    {
+        std::cout << std::left << std::setw(14) << result.name_ << std::right << std::setw(4) << result.shards_ << " shards"
+                  << std::fixed << std::setprecision(1) << std::setw(12) << result.ticks_ / result.seconds_ << " ticks/s"
+                  << std::setw(8) << result.exitedVehicles_ << " vehicles exited" << std::setw(8) << result.vehicles_
+                  << " on map" << std::setw(10) << result.migrations_ << " migrations  digest " << std::hex
+                  << result.digest_ << std::dec << std::endl;
+    }
+}
+
+/**
+ * Main function of scenario benchmarks. It runs saved maps and generated dense and sparse cities for a fixed number of
+ * seeded ticks and prints ticks per second, peak memory and number of vehicles which left the city.
+ * Options: "--filter <text>" runs only scenarios which names contain the text, "--map <file>" runs only the given map
+ * (eg. made by the city generator), "--ticks <n>", "--seed <n>",
+ * "--json <file>" writes results, "--baseline <file>" compares results with earlier ones and fails when ticks per second
+ * drop or peak memory grows by more than "--threshold <percent>" (10 by default).
+ * "--ensemble <runs>" runs every scenario with seeds from "--seed" on, on "--threads <n>" threads (every core by
+ * default), and prints mean and 95% confidence interval of cars and trucks seen by every camera. Cameras stand on
+ * "--cameras <row:column,...>" or, by default, on roads leading from the entrance.
+ * "--sweep <grid|count>" evaluates grid or random sample of traffic parameters with successive halving: "--rungs <n>"
+ * (4) rungs, each "--eta <n>" (2) times longer than the previous one and keeping the best 1/eta of configurations and
+ * those not beaten in both throughput and travel time; last rung lasts "--ticks". Every configuration is averaged over
+ * "--sweep-seeds <n>" (3) seeds.
+ * "--tick-threads <n>" moves vehicles of every tick on n threads owning tiles of the map.
+ * "--events 1" checks roads, collisions and cameras of a vehicle only when something may happen to it.
+ * "--hybrid 1" simulates vehicles far from cameras and the enter road as queues on roads.
+ * "--automaton 1" simulates traffic with the Nagel-Schreckenberg cellular automaton instead of moving vehicles.
+ * "--following 1" moves vehicles with the Intelligent Driver Model, "--time-step <ticks>" (1) of it per tick.
+ * "--morton 1" sorts vehicles by Morton codes of their cells every VEHICLES_SORT_TICKS ticks.
+ * "--shards <n>" splits every scenario into n regions simulated by separate processes; with "--verify 1" the scenario
+ * is also run in one process and the run fails if the results differ.
+ */
+int main(int argc, char* argv[])
+{
+    std::string filter = zpr::CommandLine::getOptionValue(argc, argv, "--filter", "ZPR_SCENARIO_FILTER");
+    std::string ticks = zpr::CommandLine::getOptionValue(argc, argv, "--ticks", "ZPR_SCENARIO_TICKS");
+    std::string seed = zpr::CommandLine::getOptionValue(argc, argv, "--seed", "ZPR_SCENARIO_SEED");
+    std::string json_path = zpr::CommandLine::getOptionValue(argc, argv, "--json", "ZPR_SCENARIO_JSON");
+    std::string baseline_path = zpr::CommandLine::getOptionValue(argc, argv, "--baseline", "ZPR_SCENARIO_BASELINE");
+    std::string threshold = zpr::CommandLine::getOptionValue(argc, argv, "--threshold", "ZPR_SCENARIO_THRESHOLD");
+    std::string map_path = zpr::CommandLine::getOptionValue(argc, argv, "--map", "ZPR_SCENARIO_MAP");
+    std::string ensemble = zpr::CommandLine::getOptionValue(argc, argv, "--ensemble", "ZPR_SCENARIO_ENSEMBLE");
+    std::string threads = zpr::CommandLine::getOptionValue(argc, argv, "--threads", "ZPR_SCENARIO_THREADS");
+    std::string cameras = zpr::CommandLine::getOptionValue(argc, argv, "--cameras", "ZPR_SCENARIO_CAMERAS");
+    std::string sweep = zpr::CommandLine::getOptionValue(argc, argv, "--sweep", "ZPR_SCENARIO_SWEEP");
+    std::string sweep_seeds = zpr::CommandLine::getOptionValue(argc, argv, "--sweep-seeds", "ZPR_SCENARIO_SWEEP_SEEDS");
+    std::string rungs = zpr::CommandLine::getOptionValue(argc, argv, "--rungs", "ZPR_SCENARIO_RUNGS");
+    std::string eta = zpr::CommandLine::getOptionValue(argc, argv, "--eta", "ZPR_SCENARIO_ETA");
+    std::string tick_threads = zpr::CommandLine::getOptionValue(argc, argv, "--tick-threads", "ZPR_SCENARIO_TICK_THREADS");
+    std::string events = zpr::CommandLine::getOptionValue(argc, argv, "--events", "ZPR_SCENARIO_EVENTS");
+    std::string hybrid = zpr::CommandLine::getOptionValue(argc, argv, "--hybrid", "ZPR_SCENARIO_HYBRID");
+    std::string automaton = zpr::CommandLine::getOptionValue(argc, argv, "--automaton", "ZPR_SCENARIO_AUTOMATON");
+    std::string following = zpr::CommandLine::getOptionValue(argc, argv, "--following", "ZPR_SCENARIO_FOLLOWING");
+    std::string time_step = zpr::CommandLine::getOptionValue(argc, argv, "--time-step", "ZPR_SCENARIO_TIME_STEP");
+    std::string morton = zpr::CommandLine::getOptionValue(argc, argv, "--morton", "ZPR_SCENARIO_MORTON");
+    std::string shards = zpr::CommandLine::getOptionValue(argc, argv, "--shards", "ZPR_SCENARIO_SHARDS");
+    std::string verify = zpr::CommandLine::getOptionValue(argc, argv, "--verify", "ZPR_SCENARIO_VERIFY");
+
+    zpr::ScenarioOptions options;
+    options.tickThreads_ = tick_threads.empty() ? 1 : std::stoi(tick_threads);
+    options.isEventDriven_ = events == "1";
+    options.isHybrid_ = hybrid == "1";
+    options.isCellularAutomaton_ = automaton == "1";
+    options.isCarFollowing_ = following == "1";
+    options.timeStep_ = time_step.empty() ? 1 : std::stof(time_step);
+    options.isMortonOrder_ = morton == "1";
+    zpr::ScenarioRunner runner(ticks.empty() ? 3000 : std::stoi(ticks), seed.empty() ? 2021 : std::stoul(seed), options);
+    zpr::EnsembleRunner ensemble_runner(ticks.empty() ? 3000 : std::stoi(ticks), seed.empty() ? 2021 : std::stoul(seed),
+                                        ensemble.empty() ? 0 : std::stoi(ensemble), threads.empty() ? 0 : std::stoi(threads));
+    zpr::SweepRunner sweep_runner(ticks.empty() ? 3000 : std::stoi(ticks), seed.empty() ? 2021 : std::stoul(seed),
+                                  sweep_seeds.empty() ? 3 : std::stoi(sweep_seeds), rungs.empty() ? 4 : std::stoi(rungs),
+                                  eta.empty() ? 2 : std::stoi(eta), threads.empty() ? 0 : std::stoi(threads));
+    zpr::ShardedRunner sharded_runner(ticks.empty() ? 3000 : std::stoi(ticks), seed.empty() ? 2021 : std::stoul(seed),
+                                      shards.empty() ? 1 : std::stoi(shards));
+    std::vector<zpr::SimulationParameters> sweep_parameters;
+    if (!sweep.empty()) {
+        sweep_parameters = sweep == "grid" ? zpr::SweepRunner::makeGrid()
+                                           : zpr::SweepRunner::makeRandomSample(std::stoi(sweep), seed.empty() ? 2021 : std::stoul(seed));
+    }
+    std::ostringstream sweep_json;
+    std::vector<std::pair<std::string, std::string>> saved_maps = {{"demo", "SavedMaps/Demo.txt"}, {"map1", "SavedMaps/Map1.txt"}};
+    std::vector<int> dense_sizes = {32, 256, 1024};
+    std::vector<int> sparse_sizes = {256};
+    if (!map_path.empty()) {
+        saved_maps = {{map_path.substr(map_path.find_last_of('/') + 1), map_path}};
+        dense_sizes.clear();
+        sparse_sizes.clear();
+    }
+    std::vector<zpr::ScenarioResult> results;
+    std::vector<zpr::EnsembleResult> ensemble_results;
+    auto run_scenario = [&](zpr::Scenario& scenario) {
+        if (!shards.empty()) {
+            zpr::ShardedResult result = sharded_runner.run(scenario);
+            printShardedResult(result);
+            if (verify == "1") {
+                zpr::ShardedResult single_result = sharded_runner.runSingle(scenario);
+                printShardedResult(single_result);
+                if (!zpr::ShardedRunner::isIdentical(result, single_result)) {
+                    std::cerr << scenario.name_ << ": sharded simulation differs from the single process one" << std::endl;
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (!sweep.empty()) {
+            std::cout << scenario.name_ << ": sweep of " << sweep_parameters.size() << " configurations" << std::endl;
+            std::vector<zpr::SweepConfiguration> configurations = sweep_runner.run(scenario, sweep_parameters, std::cout);
+            printSweepResult(configurations, 10);
+            zpr::SweepRunner::writeJson(sweep_json, scenario.name_, configurations);
+            return true;
+        }
+        if (ensemble.empty()) {
+            results.push_back(runner.run(scenario));
+            printResult(results.back());
+            return true;
+        }
+        if (cameras.empty()) {
+            zpr::EnsembleRunner::placeDefaultCameras(scenario);
+        }
+        else if (!zpr::EnsembleRunner::placeCameras(scenario, cameras)) {
+            std::cerr << "Cameras " << cameras << " are not on roads of " << scenario.name_ << std::endl;
+            return false;
+        }
+        ensemble_results.push_back(ensemble_runner.run(scenario));
+        printEnsembleResult(ensemble_results.back());
+        return true;
+    };
+
+    for (const std::pair<std::string, std::string>& saved_map : saved_maps) {
+        if (saved_map.first.find(filter) == std::string::npos) {
+            continue;
+        }
+        zpr::Scenario scenario;
+        if (!zpr::ScenarioRunner::loadScenario(saved_map.first, saved_map.second, scenario)) {
+            std::cerr << "Could not load " << saved_map.second << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (!run_scenario(scenario)) {
+            return EXIT_FAILURE;
+        }
+    }
+    for (int grid_size : dense_sizes) {
+        if (("dense_" + std::to_string(grid_size)).find(filter) == std::string::npos) {
+            continue;
+        }
+        zpr::Scenario scenario = zpr::ScenarioRunner::generateDenseScenario(grid_size);
+        if (!run_scenario(scenario)) {
+            return EXIT_FAILURE;
+        }
+    }
+    for (int grid_size : sparse_sizes) {
+        if (("sparse_" + std::to_string(grid_size)).find(filter) == std::string::npos) {
+            continue;
+        }
+        zpr::Scenario scenario = zpr::ScenarioRunner::generateSparseScenario(grid_size);
+        if (!run_scenario(scenario)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream file(json_path);
+        if (!sweep.empty()) {
+            file << sweep_json.str();
+        }
+        else if (ensemble.empty()) {
+            zpr::ScenarioRunner::writeJson(file, results);
+        }
+        else {
+            zpr::EnsembleRunner::writeJson(file, ensemble_results);
+        }
+        if (!file) {
+            std::cerr << "Could not write scenario results to " << json_path << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (!baseline_path.empty() && ensemble.empty() && sweep.empty()) {
+        std::ifstream file(baseline_path);
+        if (!file) {
+            std::cerr << "Could not read baseline " << baseline_path << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::vector<zpr::ScenarioResult> baseline = zpr::ScenarioRunner::readJson(file);
+        if (!zpr::ScenarioRunner::compare(results, baseline, threshold.empty() ? 10.0 : std::stod(threshold), std::cout)) {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
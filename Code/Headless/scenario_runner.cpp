@@ -0,0 +1,282 @@
+/**
+ * scenario_runner.cpp
+ * Implementation of ScenarioRunner class.
+ */
+
+#include "scenario_runner.hpp"
+#include "../creator_handler.hpp"
+#include "../simulation_handler.hpp"
+#include "../profiling/metrics.hpp"
+#include "../helpers/city_generator.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sys/resource.h>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Function reading number written after "key": in the line.
+         * @param line - Line of JSON.
+         * @param key - Name of the field.
+         * @param value - Read value.
+         * @return - True if the field was found, false otherwise.
+         */
+        bool readNumber(const std::string& line, const std::string& key, double& value)
+        {
+            std::size_t position = line.find("\"" + key + "\":");
+            if (position == std::string::npos) {
+                return false;
+            }
+            value = std::stod(line.substr(position + key.size() + 3));
+            return true;
+        }
+
+        /**
+         * Function returning relative change from baseline value to current value in percents.
+         * @param current - Current value.
+         * @param baseline - Baseline value.
+         * @return - Change in percents, positive if current value is bigger.
+         */
+        double getChange(double current, double baseline)
+        {
+            return baseline == 0 ? 0 : (current - baseline) / baseline * 100.0;
+        }
+    }
+
+    /**
+     * Parametrized constructor of ScenarioRunner class.
+     * @param ticks - Number of simulation ticks of every scenario.
+     * @param seed - Seed of the simulation.
+     * @param options - Modes of the simulation.
+     */
+    ScenarioRunner::ScenarioRunner(int ticks, unsigned seed, const ScenarioOptions& options)
+        : ticks_(ticks), seed_(seed), options_(options) {}
+
+    /**
+     * Method loading scenario from saved map file.
+     * @param name - Name of the scenario.
+     * @param path - Path of the map file.
+     * @param scenario - Loaded scenario.
+     * @return - True if map was loaded, false otherwise.
+     */
+    bool ScenarioRunner::loadScenario(const std::string& name, const std::string& path, Scenario& scenario)
+    {
+        std::ifstream file(path);
+        scenario.name_ = name;
+        scenario.cells_.clear();
+        if (!(file >> scenario.gridSize_)) {
+            return false;
+        }
+        Cell cell;
+        while (file >> cell) {
+            scenario.cells_.push_back(cell);
+        }
+        return true;
+    }
+
+    /**
+     * Method generating dense city: Manhattan grid with roads in every even row and every even column, so every block
+     * has one cell.
+     * @param grid_size - Size of the grid.
+     * @return - Generated scenario.
+     */
+    Scenario ScenarioRunner::generateDenseScenario(int grid_size)
+    {
+        CityGenerator generator(grid_size, 0);
+        generator.addManhattanGrid(1);
+        generator.connectEntrance();
+        return Scenario{"dense_" + std::to_string(grid_size), grid_size, generator.getCells()};
+    }
+
+    /**
+     * Method generating sparse city: Manhattan grid with blocks of 15x15 cells, so vehicles go long straight roads
+     * between crossroads.
+     * @param grid_size - Size of the grid.
+     * @return - Generated scenario.
+     */
+    Scenario ScenarioRunner::generateSparseScenario(int grid_size)
+    {
+        CityGenerator generator(grid_size, 0);
+        generator.addManhattanGrid(15);
+        generator.connectEntrance();
+        return Scenario{"sparse_" + std::to_string(grid_size), grid_size, generator.getCells()};
+    }
+
+    /**
+     * Method preparing simulation of the scenario: map is loaded by CreatorHandler exactly as in the application.
+     * Every call creates its own handlers, so simulations made by separate calls can tick on separate threads.
+     * @param scenario - Scenario to simulate.
+     * @param seed - Seed of the simulation.
+     * @param parameters - Parameters of traffic.
+     * @return - Simulation ready for ticks.
+     */
+    std::shared_ptr<SimulationHandler> ScenarioRunner::createSimulation(const Scenario& scenario, unsigned seed,
+                                                                       const SimulationParameters& parameters)
+    {
+        std::shared_ptr<CreatorHandler> creator_handler = std::make_shared<CreatorHandler>(scenario.gridSize_, scenario.cells_);
+        std::shared_ptr<SimulationHandler> simulation_handler = std::make_shared<SimulationHandler>(scenario.gridSize_);
+        creator_handler->add(simulation_handler);
+        creator_handler->init();
+        simulation_handler->setSeed(seed);
+        simulation_handler->setParameters(parameters);
+        simulation_handler->prepareSimulation();
+        return simulation_handler;
+    }
+
+    /**
+     * Method running the scenario.
+     * @param scenario - Scenario to run.
+     * @return - Result of the scenario.
+     */
+    ScenarioResult ScenarioRunner::run(const Scenario& scenario)
+    {
+        Metrics::instance().clear();
+        Metrics::instance().start("", METRICS_DUMP_INTERVAL);
+        resetPeakRss();
+        std::chrono::steady_clock::time_point setup_start = std::chrono::steady_clock::now();
+        std::shared_ptr<SimulationHandler> simulation_handler = createSimulation(scenario, this->seed_);
+        simulation_handler->setThreadsCount(this->options_.tickThreads_);
+        simulation_handler->setEventDriven(this->options_.isEventDriven_);
+        simulation_handler->setHybrid(this->options_.isHybrid_);
+        simulation_handler->setCellularAutomaton(this->options_.isCellularAutomaton_);
+        simulation_handler->setCarFollowing(this->options_.isCarFollowing_);
+        simulation_handler->setTimeStep(this->options_.timeStep_);
+        simulation_handler->setMortonOrder(this->options_.isMortonOrder_);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < this->ticks_; i++) {
+            simulation_handler->tick();
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        Metrics::instance().stop();
+
+        std::chrono::duration<double> setup = start - setup_start;
+        std::chrono::duration<double> elapsed = end - start;
+        return ScenarioResult{scenario.name_, scenario.gridSize_, this->ticks_, this->ticks_ / elapsed.count(), getPeakRss(),
+                              static_cast<long>(Metrics::instance().getHistogram(Metric::VehicleLifetime).getCount()), setup.count()};
+    }
+
+    /**
+     * Method resetting peak resident set size of the process, so the next scenario has its own peak.
+     * It works only on Linux, elsewhere peak of the whole process is reported.
+     */
+    void ScenarioRunner::resetPeakRss()
+    {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+    }
+
+    /**
+     * Method returning peak resident set size of the process.
+     * @return - Peak resident set size in kilobytes.
+     */
+    long ScenarioRunner::getPeakRss()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) {
+                return std::stol(line.substr(6));
+            }
+        }
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+
+    /**
+     * Method writing results as JSON, one scenario per line.
+     * @param stream - Output stream.
+     * @param results - Results of scenarios.
+     */
+    void ScenarioRunner::writeJson(std::ostream& stream, const std::vector<ScenarioResult>& results)
+    {
+        stream << "{\"scenarios\":[";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const ScenarioResult& result = results[i];
+            stream << (i == 0 ? "" : ",") << "\n{\"name\":\"" << result.name_ << "\",\"grid\":" << result.gridSize_
+                   << ",\"ticks\":" << result.ticks_ << std::fixed << std::setprecision(1)
+                   << ",\"ticks_per_second\":" << result.ticksPerSecond_ << ",\"peak_rss_kb\":" << result.peakRss_
+                   << ",\"exited_vehicles\":" << result.exitedVehicles_
+                   << ",\"exited_vehicles_per_1000_ticks\":" << result.exitedVehicles_ * 1000.0 / result.ticks_
+                   << std::setprecision(3) << ",\"setup_seconds\":" << result.setupSeconds_ << "}";
+        }
+        stream << "\n]}\n";
+    }
+
+    /**
+     * Method reading results written by writeJson.
+     * @param stream - Input stream.
+     * @return - Read results.
+     */
+    std::vector<ScenarioResult> ScenarioRunner::readJson(std::istream& stream)
+    {
+        std::vector<ScenarioResult> results;
+        std::string line;
+        while (std::getline(stream, line)) {
+            std::size_t name_start = line.find("{\"name\":\"");
+            if (name_start == std::string::npos) {
+                continue;
+            }
+            name_start += 9;
+            ScenarioResult result{line.substr(name_start, line.find('"', name_start) - name_start), 0, 0, 0, 0, 0, 0};
+            double value;
+            if (readNumber(line, "grid", value)) result.gridSize_ = static_cast<int>(value);
+            if (readNumber(line, "ticks", value)) result.ticks_ = static_cast<int>(value);
+            if (readNumber(line, "ticks_per_second", value)) result.ticksPerSecond_ = value;
+            if (readNumber(line, "peak_rss_kb", value)) result.peakRss_ = static_cast<long>(value);
+            if (readNumber(line, "exited_vehicles", value)) result.exitedVehicles_ = static_cast<long>(value);
+            if (readNumber(line, "setup_seconds", value)) result.setupSeconds_ = value;
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    /**
+     * Method comparing results with baseline. Scenario regresses when its ticks per second drop or its peak memory
+     * grows by more than threshold. Different number of exited vehicles means simulation behaves differently,
+     * it is reported but it is not a performance regression.
+     * @param results - Current results.
+     * @param baseline - Baseline results.
+     * @param threshold - Allowed change in percents.
+     * @param log - Stream for the comparison table.
+     * @return - True if no scenario regressed, false otherwise.
+     */
+    bool ScenarioRunner::compare(const std::vector<ScenarioResult>& results, const std::vector<ScenarioResult>& baseline,
+                                 double threshold, std::ostream& log)
+    {
+        bool passed = true;
+        log << std::fixed << std::setprecision(1);
+        for (const ScenarioResult& result : results) {
+            const ScenarioResult* base = nullptr;
+            for (const ScenarioResult& candidate : baseline) {
+                if (candidate.name_ == result.name_) {
+                    base = &candidate;
+                }
+            }
+            if (base == nullptr) {
+                log << std::left << std::setw(14) << result.name_ << "no baseline\n";
+                continue;
+            }
+            double speed_change = getChange(result.ticksPerSecond_, base->ticksPerSecond_);
+            double memory_change = getChange(result.peakRss_, base->peakRss_);
+            bool regressed = speed_change < -threshold || memory_change > threshold;
+            passed = passed && !regressed;
+            log << std::left << std::setw(14) << result.name_ << std::right << "ticks/s " << std::showpos << std::setw(7) << speed_change
+                << "%  peak RSS " << std::setw(7) << memory_change << "%" << std::noshowpos << (regressed ? "  REGRESSION" : "");
+            if (result.exitedVehicles_ != base->exitedVehicles_ || result.ticks_ != base->ticks_) {
+                log << "  (exited vehicles " << base->exitedVehicles_ << " -> " << result.exitedVehicles_ << ", behaviour changed)";
+            }
+            log << "\n";
+        }
+        return passed;
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * scenario_runner.hpp
+ * Header of ScenarioRunner class.
+ */
+
+#pragma once
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../components/cell.hpp"
+#include "../simulation_handler.hpp"
+
+namespace zpr {
+
+    /**
+     * Struct with map of one scenario: size of the grid and its cells.
+     */
+    struct Scenario {
+        std::string name_;
+        int gridSize_;
+        std::vector<Cell> cells_;
+    };
+
+    /**
+     * Struct with result of one scenario. Throughput is number of vehicles which reached city exit.
+     */
+    struct ScenarioResult {
+        std::string name_;
+        int gridSize_;
+        int ticks_;
+        double ticksPerSecond_;
+        long peakRss_;
+        long exitedVehicles_;
+        double setupSeconds_;
+    };
+
+    /**
+     * Struct with modes of the simulation used by ScenarioRunner. Default values are the ones used by the application.
+     */
+    struct ScenarioOptions {
+        /**
+         * Default constructor of ScenarioOptions struct.
+         */
+        ScenarioOptions() : tickThreads_(1), isEventDriven_(false), isHybrid_(false), isCellularAutomaton_(false),
+            isCarFollowing_(false), isMortonOrder_(false), timeStep_(1) {}
+
+        int tickThreads_;
+        bool isEventDriven_, isHybrid_, isCellularAutomaton_, isCarFollowing_, isMortonOrder_;
+        float timeStep_;
+    };
+
+    /**
+     * Class responsible for running whole simulation without window: map is loaded by CreatorHandler
+     * and SimulationHandler makes given number of seeded ticks, exactly as in the application.
+     */
+    class ScenarioRunner {
+    public:
+        ScenarioRunner(int ticks, unsigned seed, const ScenarioOptions& options = ScenarioOptions());
+        static bool loadScenario(const std::string& name, const std::string& path, Scenario& scenario);
+        static Scenario generateDenseScenario(int grid_size);
+        static Scenario generateSparseScenario(int grid_size);
+        static std::shared_ptr<SimulationHandler> createSimulation(const Scenario& scenario, unsigned seed,
+                                                                   const SimulationParameters& parameters = SimulationParameters());
+        ScenarioResult run(const Scenario& scenario);
+        static void writeJson(std::ostream& stream, const std::vector<ScenarioResult>& results);
+        static std::vector<ScenarioResult> readJson(std::istream& stream);
+        static bool compare(const std::vector<ScenarioResult>& results, const std::vector<ScenarioResult>& baseline,
+                            double threshold, std::ostream& log);
+    private:
+        static void resetPeakRss();
+        static long getPeakRss();
+        int ticks_;
+        unsigned seed_;
+        ScenarioOptions options_;
+    };
+}
@@ -0,0 +1,879 @@
+/**
+ * sharded_runner.cpp
+ * Implementation of ShardedRunner class.
+ */
+
+#include "sharded_runner.hpp"
+#include "shared_ring.hpp"
+#include "camera_counter.hpp"
+#include "../creator_handler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace zpr {
+
+    namespace {
+
+        const std::uint64_t NO_VEHICLE = std::numeric_limits<std::uint64_t>::max();
+
+        /**
+         * Struct with everything a vehicle needs to continue in another process. Vehicles appear one per tick at most,
+         * so tick of appearance identifies the vehicle and gives order of moving.
+         */
+        struct VehicleRecord {
+            std::uint64_t spawnTick_;
+            AABB shape_, colisionBox_;
+            std::int32_t isTruck_, x_, y_, speed_, maxSpeed_, stopCounter_, unblockTicks_;
+            std::int32_t direction_, currentRoad_, previousRoad_;
+            std::uint32_t engineState_;
+            float rotation_;
+            bool seenByCamera_[CAMERAS_COUNT];
+        };
+
+        /**
+         * Struct with shape of a vehicle from the halo before and after it moved in the current tick.
+         */
+        struct HaloVehicle {
+            std::uint64_t spawnTick_;
+            AABB oldShape_, newShape_;
+        };
+
+        /**
+         * Struct with state of one region which other processes read during the tick, and its results.
+         */
+        struct alignas(64) ShardState {
+            std::atomic<std::uint64_t> progress_;
+            std::atomic<std::uint64_t> vehiclesCount_;
+            std::atomic<std::uint64_t> exitingVehicle_;
+            std::atomic<std::uint64_t> haloCount_;
+            std::atomic<int> isStartingRoadTaken_;
+            double seconds_;
+            std::uint64_t exitedVehicles_, exitedTicks_, vehicles_, digest_, migrations_;
+            long cars_[CAMERAS_COUNT], trucks_[CAMERAS_COUNT];
+        };
+
+        /**
+         * Struct with barrier shared by every process.
+         */
+        struct alignas(64) SharedControl {
+            std::atomic<int> barrierCount_;
+            std::atomic<int> barrierGeneration_;
+            std::atomic<int> isFailed_;
+        };
+
+        typedef SharedRing<VehicleRecord> VehicleRing;
+
+        /**
+         * Function rounding size up to a multiple of 64 bytes.
+         * @param size - Size in bytes.
+         * @return - Aligned size.
+         */
+        std::size_t alignSize(std::size_t size)
+        {
+            return (size + 63) / 64 * 64;
+        }
+
+        /**
+         * Function mixing bits of the value (splitmix64 finalizer).
+         * @param value - Value to mix.
+         * @return - Mixed value.
+         */
+        std::uint64_t mix(std::uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+            return value ^ (value >> 31);
+        }
+
+        /**
+         * Function coding direction of a vehicle as a number.
+         * @param direction - Direction.
+         * @return - 1 to 4 for North, South, East and West, 0 for no direction.
+         */
+        std::int32_t encodeDirection(const std::string& direction)
+        {
+            static const char* directions[] = {"North", "South", "East", "West"};
+            for (std::int32_t i = 0; i < 4; i++) {
+                if (direction == directions[i]) {
+                    return i + 1;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * Function decoding direction coded by encodeDirection.
+         * @param code - Code of the direction.
+         * @return - Direction.
+         */
+        const char* decodeDirection(std::int32_t code)
+        {
+            static const char* directions[] = {"", "North", "South", "East", "West"};
+            return directions[code];
+        }
+
+        /**
+         * Class with layout of the shared memory: barrier, states of regions, halo of every region and a ring for
+         * every ordered pair of regions.
+         */
+        class SharedLayout {
+        public:
+            /**
+             * Parametrized constructor of SharedLayout class.
+             * @param shards - Number of regions.
+             * @param halo_capacity - Maximal number of vehicles in the halo of a region.
+             */
+            SharedLayout(int shards, std::size_t halo_capacity) : shards_(shards), haloCapacity_(halo_capacity), memory_(nullptr)
+            {
+                this->statesOffset_ = alignSize(sizeof(SharedControl));
+                this->halosOffset_ = this->statesOffset_ + alignSize(sizeof(ShardState) * shards);
+                this->ringsOffset_ = this->halosOffset_ + alignSize(sizeof(HaloVehicle) * halo_capacity) * shards;
+                this->ringSize_ = alignSize(VehicleRing::getSize(SHARD_RING_CAPACITY));
+                this->size_ = this->ringsOffset_ + this->ringSize_ * shards * shards;
+            }
+
+            /**
+             * Method creating every shared object in the memory.
+             * @param memory - Shared memory of getSize() bytes.
+             */
+            void create(void* memory)
+            {
+                this->memory_ = static_cast<char*>(memory);
+                SharedControl* control = new (this->memory_) SharedControl();
+                control->barrierCount_.store(0);
+                control->barrierGeneration_.store(0);
+                control->isFailed_.store(0);
+                for (int i = 0; i < this->shards_; i++) {
+                    ShardState* state = new (this->getState(i)) ShardState();
+                    state->progress_.store(0);
+                    state->vehiclesCount_.store(0);
+                    state->exitingVehicle_.store(NO_VEHICLE);
+                    state->haloCount_.store(0);
+                    state->isStartingRoadTaken_.store(0);
+                    for (int j = 0; j < this->shards_; j++) {
+                        VehicleRing::create(this->getRing(i, j), SHARD_RING_CAPACITY);
+                    }
+                }
+            }
+
+            /**
+             * Method returning size of the shared memory.
+             * @return - Size in bytes.
+             */
+            std::size_t getSize() const
+            {
+                return this->size_;
+            }
+
+            /**
+             * Method returning barrier shared by every process.
+             * @return - Shared control block.
+             */
+            SharedControl* getControl() const
+            {
+                return reinterpret_cast<SharedControl*>(this->memory_);
+            }
+
+            /**
+             * Method returning state of the region.
+             * @param shard - Number of the region.
+             * @return - State of the region.
+             */
+            ShardState* getState(int shard) const
+            {
+                return reinterpret_cast<ShardState*>(this->memory_ + this->statesOffset_) + shard;
+            }
+
+            /**
+             * Method returning halo of the region: its vehicles close to other regions.
+             * @param shard - Number of the region.
+             * @return - First vehicle of the halo.
+             */
+            HaloVehicle* getHalo(int shard) const
+            {
+                return reinterpret_cast<HaloVehicle*>(this->memory_ + this->halosOffset_ + alignSize(sizeof(HaloVehicle) * this->haloCapacity_) * shard);
+            }
+
+            /**
+             * Method returning ring carrying vehicles from one region to another.
+             * @param from - Number of the sending region.
+             * @param to - Number of the receiving region.
+             * @return - Ring between the regions.
+             */
+            VehicleRing* getRing(int from, int to) const
+            {
+                return reinterpret_cast<VehicleRing*>(this->memory_ + this->ringsOffset_ + this->ringSize_ * (from * this->shards_ + to));
+            }
+        private:
+            int shards_;
+            std::size_t haloCapacity_, statesOffset_, halosOffset_, ringsOffset_, ringSize_, size_;
+            char* memory_;
+        };
+
+        /**
+         * Class splitting the world into columns x rows rectangular regions of whole cells. Outer regions reach
+         * to infinity, so vehicles on the enter road above the city also belong to a region.
+         */
+        class Regions {
+        public:
+            /**
+             * Parametrized constructor of Regions class. Regions are as close to squares as the number allows.
+             * @param shards - Number of regions.
+             * @param grid_size - Size of the grid.
+             * @param prefix - Position of the first cell in world units.
+             * @param cell_size - Size of a cell in world units.
+             */
+            Regions(int shards, int grid_size, float prefix, float cell_size) : gridSize_(grid_size), prefix_(prefix), cellSize_(cell_size)
+            {
+                this->rows_ = 1;
+                for (int i = 1; i * i <= shards; i++) {
+                    if (shards % i == 0) {
+                        this->rows_ = i;
+                    }
+                }
+                this->columns_ = shards / this->rows_;
+            }
+
+            /**
+             * Method returning region containing the point.
+             * @param point - Point in world units.
+             * @return - Number of the region.
+             */
+            int getRegion(sf::Vector2f point) const
+            {
+                return this->getBand(point.y, this->rows_) * this->columns_ + this->getBand(point.x, this->columns_);
+            }
+
+            /**
+             * Method returning distance from the point to the region along the farther axis.
+             * @param region - Number of the region.
+             * @param point - Point in world units.
+             * @return - Distance in world units, 0 inside the region.
+             */
+            float getDistance(int region, sf::Vector2f point) const
+            {
+                float dx = this->getAxisDistance(region % this->columns_, this->columns_, point.x);
+                float dy = this->getAxisDistance(region / this->columns_, this->rows_, point.y);
+                return std::max(dx, dy);
+            }
+        private:
+            /**
+             * Method returning first cell of the band.
+             * @param band - Number of the band.
+             * @param count - Number of bands.
+             * @return - Number of the cell.
+             */
+            int getBandStart(int band, int count) const
+            {
+                return (band * this->gridSize_ + count - 1) / count;
+            }
+
+            /**
+             * Method returning band containing the coordinate.
+             * @param coordinate - Coordinate in world units.
+             * @param count - Number of bands.
+             * @return - Number of the band.
+             */
+            int getBand(float coordinate, int count) const
+            {
+                int cell = static_cast<int>(std::floor((coordinate - this->prefix_) / this->cellSize_));
+                cell = std::min(std::max(cell, 0), this->gridSize_ - 1);
+                return cell * count / this->gridSize_;
+            }
+
+            /**
+             * Method returning distance from the coordinate to the band.
+             * @param band - Number of the band.
+             * @param count - Number of bands.
+             * @param coordinate - Coordinate in world units.
+             * @return - Distance in world units, 0 inside the band.
+             */
+            float getAxisDistance(int band, int count, float coordinate) const
+            {
+                float begin = band == 0 ? -std::numeric_limits<float>::infinity() : this->prefix_ + this->cellSize_ * this->getBandStart(band, count);
+                float end = band == count - 1 ? std::numeric_limits<float>::infinity() : this->prefix_ + this->cellSize_ * this->getBandStart(band + 1, count);
+                return std::max(0.0f, std::max(begin - coordinate, coordinate - end));
+            }
+            int gridSize_, rows_, columns_;
+            float prefix_, cellSize_;
+        };
+
+        /**
+         * Class simulating one region in its own process. Roads, cameras and exit sites of the whole map are prepared
+         * by SimulationHandler, vehicles are only the ones in the region.
+         */
+        class Shard {
+        public:
+            Shard(int index, int shards, const Scenario& scenario, unsigned seed, const SharedLayout& layout);
+            void run(int ticks);
+        private:
+            void waitAtBarrier(bool is_receiving);
+            void checkFailed() const;
+            void spawnVehicle(std::uint64_t tick, int num, unsigned seed);
+            void publishHalo();
+            void moveVehicle(std::size_t index);
+            bool checkHaloColision(const std::shared_ptr<Vehicle>& vehicle, std::uint64_t halo_shards);
+            std::uint64_t findExitingVehicle() const;
+            void deleteVehicle(std::uint64_t tick, std::uint64_t spawn_tick);
+            void sendVehicles();
+            void receiveVehicles();
+            void acceptVehicles();
+            std::shared_ptr<Vehicle> takeVehicle(bool is_truck);
+            VehicleRecord makeRecord(const Vehicle& vehicle) const;
+            void applyRecord(const VehicleRecord& record, Vehicle& vehicle) const;
+            int index_, shards_;
+            const SharedLayout& layout_;
+            std::shared_ptr<SimulationHandler> simulation_;
+            std::unique_ptr<Regions> regions_;
+            std::mt19937 engine_;
+            SimulationParameters parameters_;
+            std::vector<std::shared_ptr<Vehicle>> vehicles_, carsPool_, trucksPool_;
+            std::vector<std::uint64_t> haloShards_;
+            std::vector<int> haloIndex_;
+            std::vector<VehicleRecord> received_;
+            std::uint64_t exitedVehicles_, exitedTicks_, migrations_;
+            std::array<long, CAMERAS_COUNT> cars_, trucks_;
+        };
+
+        /**
+         * Parametrized constructor of Shard class. Map is loaded exactly as in the single process simulation.
+         * @param index - Number of the region.
+         * @param shards - Number of regions.
+         * @param scenario - Scenario to simulate.
+         * @param seed - Seed of the simulation.
+         * @param layout - Layout of the shared memory.
+         */
+        Shard::Shard(int index, int shards, const Scenario& scenario, unsigned seed, const SharedLayout& layout)
+            : index_(index), shards_(shards), layout_(layout), engine_(seed), exitedVehicles_(0), exitedTicks_(0),
+              migrations_(0), cars_(), trucks_()
+        {
+            std::shared_ptr<CreatorHandler> creator_handler = std::make_shared<CreatorHandler>(scenario.gridSize_, scenario.cells_);
+            this->simulation_ = std::make_shared<SimulationHandler>(scenario.gridSize_);
+            creator_handler->add(this->simulation_);
+            creator_handler->init();
+            this->simulation_->prepareRoads();
+            Converter converter(scenario.gridSize_, WORLD_CELL_SIZE);
+            this->regions_ = std::make_unique<Regions>(shards, scenario.gridSize_, converter.calculatePrefix(), WORLD_CELL_SIZE);
+        }
+
+        /**
+         * Method running every tick of the region. Steps are the same as in SimulationHandler::tick.
+         * @param ticks - Number of ticks.
+         */
+        void Shard::run(int ticks)
+        {
+            ShardState* state = this->layout_.getState(this->index_);
+            const std::vector<AABB>& roads = this->simulation_->getRoads();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (std::uint64_t tick = 1; tick <= static_cast<std::uint64_t>(ticks); tick++) {
+                bool is_starting_road_taken = std::any_of(this->vehicles_.begin(), this->vehicles_.end(), [&](const std::shared_ptr<Vehicle>& vehicle) {
+                    sf::Vector2f position = vehicle->getShape().getPosition();
+                    return roads.back().contains(position) || roads.at(roads.size() - 2).contains(position);
+                });
+                state->vehiclesCount_.store(this->vehicles_.size(), std::memory_order_relaxed);
+                state->isStartingRoadTaken_.store(is_starting_road_taken, std::memory_order_relaxed);
+                this->waitAtBarrier(false);
+
+                std::uint64_t vehicles_count = 0;
+                bool is_starting_cell_free = true;
+                for (int i = 0; i < this->shards_; i++) {
+                    vehicles_count += this->layout_.getState(i)->vehiclesCount_.load(std::memory_order_relaxed);
+                    is_starting_cell_free = is_starting_cell_free && !this->layout_.getState(i)->isStartingRoadTaken_.load(std::memory_order_relaxed);
+                }
+                if (is_starting_cell_free && vehicles_count < this->simulation_->getMaxVehicles()) {
+                    int num = SimulationHandler::drawSpawn(this->engine_, this->parameters_);
+                    if (num != 0) {
+                        this->spawnVehicle(tick, num, this->engine_());
+                    }
+                }
+                this->publishHalo();
+                state->progress_.store(0, std::memory_order_release);
+                this->waitAtBarrier(false);
+
+                for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+                    this->moveVehicle(i);
+                }
+                state->progress_.store(NO_VEHICLE, std::memory_order_release);
+                state->exitingVehicle_.store(this->findExitingVehicle(), std::memory_order_relaxed);
+                this->waitAtBarrier(false);
+
+                std::uint64_t exiting_vehicle = NO_VEHICLE;
+                for (int i = 0; i < this->shards_; i++) {
+                    exiting_vehicle = std::min(exiting_vehicle, this->layout_.getState(i)->exitingVehicle_.load(std::memory_order_relaxed));
+                }
+                if (exiting_vehicle != NO_VEHICLE) {
+                    this->deleteVehicle(tick, exiting_vehicle);
+                }
+                this->sendVehicles();
+                this->waitAtBarrier(true);
+                this->acceptVehicles();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            state->seconds_ = elapsed.count();
+            state->exitedVehicles_ = this->exitedVehicles_;
+            state->exitedTicks_ = this->exitedTicks_;
+            state->migrations_ = this->migrations_;
+            state->vehicles_ = this->vehicles_.size();
+            state->digest_ = 0;
+            for (const std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
+                state->digest_ += ShardedRunner::hashVehicle(*vehicle);
+            }
+            for (int i = 0; i < CAMERAS_COUNT; i++) {
+                state->cars_[i] = this->cars_[i];
+                state->trucks_[i] = this->trucks_[i];
+            }
+        }
+
+        /**
+         * Method waiting until every process reaches the barrier.
+         * @param is_receiving - True if vehicles sent by other regions should be taken from rings while waiting.
+         */
+        void Shard::waitAtBarrier(bool is_receiving)
+        {
+            SharedControl* control = this->layout_.getControl();
+            int generation = control->barrierGeneration_.load(std::memory_order_acquire);
+            if (control->barrierCount_.fetch_add(1, std::memory_order_acq_rel) + 1 == this->shards_) {
+                control->barrierCount_.store(0, std::memory_order_relaxed);
+                control->barrierGeneration_.fetch_add(1, std::memory_order_acq_rel);
+                return;
+            }
+            while (control->barrierGeneration_.load(std::memory_order_acquire) == generation) {
+                this->checkFailed();
+                if (is_receiving) {
+                    this->receiveVehicles();
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         * Method ending the process if another process failed, so nobody waits for it forever.
+         */
+        void Shard::checkFailed() const
+        {
+            if (this->layout_.getControl()->isFailed_.load(std::memory_order_relaxed)) {
+                _exit(EXIT_FAILURE);
+            }
+        }
+
+        /**
+         * Method adding vehicle drawn in this tick, if it appears in this region. Every region draws the same numbers,
+         * so the random engine stays the same as in the single process simulation.
+         * @param tick - Number of the tick.
+         * @param num - Drawn number, as returned by SimulationHandler::drawSpawn.
+         * @param seed - Seed of the vehicle.
+         */
+        void Shard::spawnVehicle(std::uint64_t tick, int num, unsigned seed)
+        {
+            bool is_east = num == 3 || num == 4 || num == 6;
+            sf::Vector2i position = this->simulation_->getStartingPosition(is_east);
+            if (this->regions_->getRegion(sf::Vector2f(position)) != this->index_) {
+                return;
+            }
+            std::shared_ptr<Vehicle> vehicle = this->takeVehicle(num > 4);
+            vehicle->reset(position.x, position.y, is_east ? "West" : "East", seed);
+            vehicle->spawnTick_ = tick;
+            this->vehicles_.push_back(std::move(vehicle));
+        }
+
+        /**
+         * Method writing shapes of vehicles which are close to other regions, before anything moves.
+         */
+        void Shard::publishHalo()
+        {
+            HaloVehicle* halo = this->layout_.getHalo(this->index_);
+            std::size_t halo_count = 0;
+            float halo_size = SHARD_HALO_CELLS * WORLD_CELL_SIZE;
+            this->haloShards_.assign(this->vehicles_.size(), 0);
+            this->haloIndex_.assign(this->vehicles_.size(), -1);
+            for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+                sf::Vector2f position = this->vehicles_[i]->getShape().getPosition();
+                for (int shard = 0; shard < this->shards_; shard++) {
+                    if (shard != this->index_ && this->regions_->getDistance(shard, position) <= halo_size) {
+                        this->haloShards_[i] |= std::uint64_t(1) << shard;
+                    }
+                }
+                if (this->haloShards_[i] != 0) {
+                    const AABB& shape = this->vehicles_[i]->getShape();
+                    this->haloIndex_[i] = halo_count;
+                    halo[halo_count++] = HaloVehicle{this->vehicles_[i]->spawnTick_, shape, shape};
+                }
+            }
+            this->layout_.getState(this->index_)->haloCount_.store(halo_count, std::memory_order_relaxed);
+        }
+
+        /**
+         * Method making one step of the vehicle with SimulationHandler::moveVehicle, as the single process simulation.
+         * @param index - Index of the vehicle.
+         */
+        void Shard::moveVehicle(std::size_t index)
+        {
+            const std::shared_ptr<Vehicle>& vehicle = this->vehicles_[index];
+            unsigned sightings = SimulationHandler::moveVehicle(vehicle, this->simulation_->getCameras(), [&]() {
+                bool is_colision = std::any_of(this->vehicles_.begin(), this->vehicles_.end(), [&](const std::shared_ptr<Vehicle>& colider) {
+                    return vehicle->checkColision(colider);
+                });
+                if (!is_colision && this->haloShards_[index] != 0) {
+                    is_colision = this->checkHaloColision(vehicle, this->haloShards_[index]);
+                }
+                return is_colision;
+            });
+            for (int camera = 0; camera < CAMERAS_COUNT; camera++) {
+                if (sightings & (1u << camera)) {
+                    (vehicle->isTruck() ? this->trucks_ : this->cars_)[camera]++;
+                }
+            }
+            if (this->haloIndex_[index] >= 0) {
+                this->layout_.getHalo(this->index_)[this->haloIndex_[index]].newShape_ = vehicle->getShape();
+            }
+            this->layout_.getState(this->index_)->progress_.store(vehicle->spawnTick_ + 1, std::memory_order_release);
+        }
+
+        /**
+         * Method checking collision with vehicles of other regions. It waits until the regions moved every vehicle
+         * which appeared earlier, then uses their new shapes and old shapes of younger vehicles.
+         * @param vehicle - Vehicle which is going to move.
+         * @param halo_shards - Bit mask of regions close to the vehicle.
+         * @return - True if there is a collision, false otherwise.
+         */
+        bool Shard::checkHaloColision(const std::shared_ptr<Vehicle>& vehicle, std::uint64_t halo_shards)
+        {
+            std::uint64_t spawn_tick = vehicle->spawnTick_;
+            this->layout_.getState(this->index_)->progress_.store(spawn_tick, std::memory_order_release);
+            sf::Vector2f position = vehicle->getShape().getPosition();
+            for (int shard = 0; shard < this->shards_; shard++) {
+                if ((halo_shards & (std::uint64_t(1) << shard)) == 0) {
+                    continue;
+                }
+                ShardState* state = this->layout_.getState(shard);
+                while (state->progress_.load(std::memory_order_acquire) <= spawn_tick) {
+                    this->checkFailed();
+                    std::this_thread::yield();
+                }
+                const HaloVehicle* halo = this->layout_.getHalo(shard);
+                std::size_t halo_count = state->haloCount_.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < halo_count; i++) {
+                    const AABB& shape = halo[i].spawnTick_ < spawn_tick ? halo[i].newShape_ : halo[i].oldShape_;
+                    if (shape.getPosition() != position && vehicle->colisionBox_.intersects(shape)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Method finding the oldest vehicle of the region which reached city exit.
+         * @return - Tick of appearance of the vehicle, NO_VEHICLE if there is none.
+         */
+        std::uint64_t Shard::findExitingVehicle() const
+        {
+            for (const std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
+                for (const AABB& exit_site : this->simulation_->getExitSites()) {
+                    if (exit_site.contains(vehicle->getShape().getPosition())) {
+                        return vehicle->spawnTick_;
+                    }
+                }
+            }
+            return NO_VEHICLE;
+        }
+
+        /**
+         * Method removing vehicle which left the city, if it belongs to this region. Only one vehicle leaves in a tick,
+         * the oldest one of all regions, as in SimulationHandler::deleteVehicles.
+         * @param tick - Number of the tick.
+         * @param spawn_tick - Tick of appearance of the vehicle.
+         */
+        void Shard::deleteVehicle(std::uint64_t tick, std::uint64_t spawn_tick)
+        {
+            for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+                if (this->vehicles_[i]->spawnTick_ == spawn_tick) {
+                    this->exitedVehicles_++;
+                    this->exitedTicks_ += tick - spawn_tick;
+                    (this->vehicles_[i]->isTruck() ? this->trucksPool_ : this->carsPool_).push_back(std::move(this->vehicles_[i]));
+                    this->vehicles_.erase(this->vehicles_.begin() + i);
+                    return;
+                }
+            }
+        }
+
+        /**
+         * Method sending vehicles which are now in other regions. When a ring is full, vehicles sent to this region
+         * are received in the meantime, so two regions sending to each other do not wait forever.
+         */
+        void Shard::sendVehicles()
+        {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+                int region = this->regions_->getRegion(this->vehicles_[i]->getShape().getPosition());
+                if (region == this->index_) {
+                    std::swap(this->vehicles_[kept++], this->vehicles_[i]);
+                    continue;
+                }
+                VehicleRecord record = this->makeRecord(*this->vehicles_[i]);
+                VehicleRing* ring = this->layout_.getRing(this->index_, region);
+                while (!ring->push(record)) {
+                    this->checkFailed();
+                    this->receiveVehicles();
+                    std::this_thread::yield();
+                }
+                this->migrations_++;
+                (this->vehicles_[i]->isTruck() ? this->trucksPool_ : this->carsPool_).push_back(std::move(this->vehicles_[i]));
+            }
+            this->vehicles_.resize(kept);
+        }
+
+        /**
+         * Method taking vehicles sent by other regions from the rings. They are added to the region later, by
+         * acceptVehicles().
+         */
+        void Shard::receiveVehicles()
+        {
+            VehicleRecord record;
+            for (int shard = 0; shard < this->shards_; shard++) {
+                VehicleRing* ring = this->layout_.getRing(shard, this->index_);
+                while (ring->pop(record)) {
+                    this->received_.push_back(record);
+                }
+            }
+        }
+
+        /**
+         * Method adding received vehicles to the region after the last barrier of the tick, when every region has
+         * sent its vehicles. Vehicles are kept in order of appearance, as in SimulationHandler.
+         */
+        void Shard::acceptVehicles()
+        {
+            this->receiveVehicles();
+            if (this->received_.empty()) {
+                return;
+            }
+            for (const VehicleRecord& record : this->received_) {
+                std::shared_ptr<Vehicle> vehicle = this->takeVehicle(record.isTruck_);
+                this->applyRecord(record, *vehicle);
+                this->vehicles_.push_back(std::move(vehicle));
+            }
+            this->received_.clear();
+            std::sort(this->vehicles_.begin(), this->vehicles_.end(), [](const std::shared_ptr<Vehicle>& first, const std::shared_ptr<Vehicle>& second) {
+                return first->spawnTick_ < second->spawnTick_;
+            });
+        }
+
+        /**
+         * Method returning vehicle from the pool, or a new one if the pool is empty.
+         * @param is_truck - True for a truck, false for a car.
+         * @return - Vehicle to reset.
+         */
+        std::shared_ptr<Vehicle> Shard::takeVehicle(bool is_truck)
+        {
+            std::vector<std::shared_ptr<Vehicle>>& pool = is_truck ? this->trucksPool_ : this->carsPool_;
+            if (pool.empty()) {
+                const std::vector<AABB>& roads = this->simulation_->getRoads();
+                std::shared_ptr<Vehicle> vehicle = is_truck ? VehicleFactory::createTruck(0, 0, WORLD_CELL_SIZE, roads, "East")
+                                                            : VehicleFactory::createCar(0, 0, WORLD_CELL_SIZE, roads, "East");
+                vehicle->maxSpeed_ = this->parameters_.vehicleSpeed_;
+                vehicle->unblockTicks_ = this->parameters_.unblockTicks_;
+                return vehicle;
+            }
+            std::shared_ptr<Vehicle> vehicle = std::move(pool.back());
+            pool.pop_back();
+            return vehicle;
+        }
+
+        /**
+         * Method copying state of the vehicle to a record.
+         * @param vehicle - Vehicle leaving the region.
+         * @return - Record of the vehicle.
+         */
+        VehicleRecord Shard::makeRecord(const Vehicle& vehicle) const
+        {
+            const AABB* roads = this->simulation_->getRoads().data();
+            std::ostringstream engine_state;
+            engine_state << vehicle.engine_;
+            VehicleRecord record;
+            record.spawnTick_ = vehicle.spawnTick_;
+            record.shape_ = vehicle.shape_;
+            record.colisionBox_ = vehicle.colisionBox_;
+            record.isTruck_ = vehicle.isTruck();
+            record.x_ = vehicle.x_;
+            record.y_ = vehicle.y_;
+            record.speed_ = vehicle.speed_;
+            record.maxSpeed_ = vehicle.maxSpeed_;
+            record.stopCounter_ = vehicle.stopCounter_;
+            record.unblockTicks_ = vehicle.unblockTicks_;
+            record.direction_ = encodeDirection(vehicle.direction_);
+            record.currentRoad_ = vehicle.currentRoad_ ? vehicle.currentRoad_ - roads : -1;
+            record.previousRoad_ = vehicle.previousRoad_ ? vehicle.previousRoad_ - roads : -1;
+            record.engineState_ = std::stoul(engine_state.str());
+            record.rotation_ = vehicle.rotation_;
+            for (int i = 0; i < CAMERAS_COUNT; i++) {
+                record.seenByCamera_[i] = vehicle.seenByCamera_[i];
+            }
+            return record;
+        }
+
+        /**
+         * Method restoring state of the vehicle from a record.
+         * @param record - Record of the vehicle.
+         * @param vehicle - Vehicle entering the region, already reset.
+         */
+        void Shard::applyRecord(const VehicleRecord& record, Vehicle& vehicle) const
+        {
+            const std::vector<AABB>& roads = this->simulation_->getRoads();
+            vehicle.spawnTick_ = record.spawnTick_;
+            vehicle.shape_ = record.shape_;
+            vehicle.colisionBox_ = record.colisionBox_;
+            vehicle.x_ = record.x_;
+            vehicle.y_ = record.y_;
+            vehicle.speed_ = record.speed_;
+            vehicle.maxSpeed_ = record.maxSpeed_;
+            vehicle.stopCounter_ = record.stopCounter_;
+            vehicle.unblockTicks_ = record.unblockTicks_;
+            vehicle.direction_ = decodeDirection(record.direction_);
+            vehicle.currentRoad_ = record.currentRoad_ < 0 ? nullptr : &roads[record.currentRoad_];
+            vehicle.previousRoad_ = record.previousRoad_ < 0 ? nullptr : &roads[record.previousRoad_];
+            vehicle.engine_.seed(record.engineState_);
+            vehicle.rotation_ = record.rotation_;
+            for (int i = 0; i < CAMERAS_COUNT; i++) {
+                vehicle.seenByCamera_[i] = record.seenByCamera_[i];
+            }
+        }
+    }
+
+    /**
+     * Parametrized constructor of ShardedRunner class.
+     * @param ticks - Number of simulation ticks.
+     * @param seed - Seed of the simulation.
+     * @param shards - Number of regions and processes, from 1 to SHARDS_MAX_COUNT.
+     */
+    ShardedRunner::ShardedRunner(int ticks, unsigned seed, int shards) : ticks_(ticks), seed_(seed),
+        shards_(std::min(std::max(shards, 1), SHARDS_MAX_COUNT)) {}
+
+    /**
+     * Method running the scenario in forked processes, one per region.
+     * @param scenario - Scenario to run.
+     * @return - State of the simulation after the last tick.
+     */
+    ShardedResult ShardedRunner::run(const Scenario& scenario) const
+    {
+        std::shared_ptr<CreatorHandler> creator_handler = std::make_shared<CreatorHandler>(scenario.gridSize_, scenario.cells_);
+        std::shared_ptr<SimulationHandler> simulation_handler = std::make_shared<SimulationHandler>(scenario.gridSize_);
+        creator_handler->add(simulation_handler);
+        creator_handler->init();
+        simulation_handler->prepareRoads();
+        SharedLayout layout(this->shards_, simulation_handler->getMaxVehicles() + 1);
+        SharedMemory memory(layout.getSize());
+        layout.create(memory.getData());
+
+        std::vector<pid_t> processes;
+        bool is_failed = false;
+        for (int i = 0; i < this->shards_ && !is_failed; i++) {
+            pid_t process = fork();
+            if (process == 0) {
+                int status = EXIT_SUCCESS;
+                try {
+                    Shard shard(i, this->shards_, scenario, this->seed_, layout);
+                    shard.run(this->ticks_);
+                }
+                catch (...) {
+                    layout.getControl()->isFailed_.store(1);
+                    status = EXIT_FAILURE;
+                }
+                _exit(status);
+            }
+            if (process < 0) {
+                layout.getControl()->isFailed_.store(1);
+                is_failed = true;
+            }
+            else {
+                processes.push_back(process);
+            }
+        }
+        for (std::size_t i = 0; i < processes.size(); i++) {
+            int status = 0;
+            if (waitpid(-1, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+                layout.getControl()->isFailed_.store(1);
+                is_failed = true;
+            }
+        }
+        if (is_failed) {
+            throw std::runtime_error("Process simulating a region failed");
+        }
+
+        ShardedResult result{scenario.name_, this->shards_, this->ticks_, 0, 0, 0, {}, {}, 0, 0, 0};
+        for (int i = 0; i < this->shards_; i++) {
+            const ShardState* state = layout.getState(i);
+            result.seconds_ = std::max(result.seconds_, state->seconds_);
+            result.exitedVehicles_ += state->exitedVehicles_;
+            result.exitedTicks_ += state->exitedTicks_;
+            result.vehicles_ += state->vehicles_;
+            result.digest_ += state->digest_;
+            result.migrations_ += state->migrations_;
+            for (int j = 0; j < CAMERAS_COUNT; j++) {
+                result.cars_[j] += state->cars_[j];
+                result.trucks_[j] += state->trucks_[j];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Method running the scenario in this process with SimulationHandler, for comparison.
+     * @param scenario - Scenario to run.
+     * @return - State of the simulation after the last tick.
+     */
+    ShardedResult ShardedRunner::runSingle(const Scenario& scenario) const
+    {
+        std::shared_ptr<SimulationHandler> simulation_handler = ScenarioRunner::createSimulation(scenario, this->seed_);
+        std::shared_ptr<CameraCounter> counter = std::make_shared<CameraCounter>();
+        simulation_handler->add(counter);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < this->ticks_; i++) {
+            simulation_handler->tick();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        ShardedResult result{scenario.name_, 1, this->ticks_, elapsed.count(), simulation_handler->getExitedVehiclesCount(),
+                             simulation_handler->getExitedVehiclesTicks(), counter->cars_, counter->trucks_,
+                             simulation_handler->getVehicles().size(), 0, 0};
+        for (const std::shared_ptr<Vehicle>& vehicle : simulation_handler->getVehicles()) {
+            result.digest_ += hashVehicle(*vehicle);
+        }
+        return result;
+    }
+
+    /**
+     * Method checking if two runs ended in the same state.
+     * @param first - First result.
+     * @param second - Second result.
+     * @return - True if vehicles, exits and camera counts are the same, false otherwise.
+     */
+    bool ShardedRunner::isIdentical(const ShardedResult& first, const ShardedResult& second)
+    {
+        return first.exitedVehicles_ == second.exitedVehicles_ && first.exitedTicks_ == second.exitedTicks_
+            && first.cars_ == second.cars_ && first.trucks_ == second.trucks_ && first.vehicles_ == second.vehicles_
+            && first.digest_ == second.digest_;
+    }
+
+    /**
+     * Method hashing state of the vehicle which decides about its next moves.
+     * @param vehicle - Vehicle.
+     * @return - Hash of the vehicle.
+     */
+    std::uint64_t ShardedRunner::hashVehicle(const Vehicle& vehicle)
+    {
+        std::uint64_t hash = mix(vehicle.spawnTick_);
+        for (std::int64_t value : {std::int64_t(vehicle.x_), std::int64_t(vehicle.y_), std::int64_t(vehicle.speed_),
+                                   std::int64_t(vehicle.stopCounter_), std::int64_t(encodeDirection(vehicle.direction_))}) {
+            hash = mix(hash ^ static_cast<std::uint64_t>(value));
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * sharded_runner.hpp
+ * Header of ShardedRunner class.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include "scenario_runner.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Struct with state of the simulation after the last tick. Digest sums hashes of every vehicle on the map, so it
+     * does not depend on which process simulated the vehicle.
+     */
+    struct ShardedResult {
+        std::string name_;
+        int shards_, ticks_;
+        double seconds_;
+        std::uint64_t exitedVehicles_, exitedTicks_;
+        std::array<long, CAMERAS_COUNT> cars_, trucks_;
+        std::uint64_t vehicles_, digest_, migrations_;
+    };
+
+    /**
+     * Class running one simulation split into rectangular regions, each simulated by its own process.
+     * Processes meet at barriers in every tick: to decide together where a vehicle appears and which one leaves the
+     * city, and to hand over vehicles which crossed borders of regions through shared memory rings.
+     * Vehicles are moved in order of appearance, as in SimulationHandler: a vehicle closer than SHARD_HALO_CELLS to
+     * another region waits until that region moved every older vehicle and checks collisions with its vehicles from
+     * the halo, so results are the same as of a single process with the same seed.
+     */
+    class ShardedRunner {
+    public:
+        ShardedRunner(int ticks, unsigned seed, int shards);
+        ShardedResult run(const Scenario& scenario) const;
+        ShardedResult runSingle(const Scenario& scenario) const;
+        static bool isIdentical(const ShardedResult& first, const ShardedResult& second);
+        static std::uint64_t hashVehicle(const Vehicle& vehicle);
+    private:
+        int ticks_;
+        unsigned seed_;
+        int shards_;
+    };
+}
@@ -0,0 +1,48 @@
+/**
+ * shared_ring.cpp
+ * Implementation of SharedMemory class.
+ */
+
+#include "shared_ring.hpp"
+#include <sys/mman.h>
+
+namespace zpr {
+
+    /**
+     * Parametrized constructor of SharedMemory class. Memory is filled with zeros.
+     * @param size - Size of the memory in bytes.
+     */
+    SharedMemory::SharedMemory(std::size_t size) : size_(size)
+    {
+        this->data_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (this->data_ == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /**
+     * Destructor of SharedMemory class. Memory is unmapped from this process only.
+     */
+    SharedMemory::~SharedMemory()
+    {
+        munmap(this->data_, this->size_);
+    }
+
+    /**
+     * Method returning beginning of the memory.
+     * @return - Address of the memory, aligned to the page size.
+     */
+    void* SharedMemory::getData() const
+    {
+        return this->data_;
+    }
+
+    /**
+     * Method returning size of the memory.
+     * @return - Size in bytes.
+     */
+    std::size_t SharedMemory::getSize() const
+    {
+        return this->size_;
+    }
+}
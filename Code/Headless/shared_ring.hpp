@@ -0,0 +1,112 @@
+/**
+ * shared_ring.hpp
+ * Header of SharedMemory class and SharedRing template.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace zpr {
+
+    /**
+     * Class owning memory mapped as shared and anonymous. Processes forked after its construction see the same bytes,
+     * so it must be created before fork().
+     */
+    class SharedMemory {
+    public:
+        SharedMemory(std::size_t size);
+        ~SharedMemory();
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+        void* getData() const;
+        std::size_t getSize() const;
+    private:
+        void* data_;
+        std::size_t size_;
+    };
+
+    /**
+     * Ring buffer with one writing and one reading process, placed in shared memory. Records have to be trivially
+     * copyable, so they mean the same in every process.
+     */
+    template <typename T>
+    class SharedRing {
+        static_assert(std::is_trivially_copyable<T>::value, "Records of SharedRing have to be trivially copyable");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "SharedRing needs lock free 64-bit atomics");
+    public:
+        /**
+         * Method returning number of bytes taken by the ring.
+         * @param capacity - Maximal number of records in the ring.
+         * @return - Size of the ring with its records.
+         */
+        static std::size_t getSize(std::size_t capacity)
+        {
+            return sizeof(SharedRing) + capacity * sizeof(T);
+        }
+
+        /**
+         * Method creating empty ring in the given memory.
+         * @param memory - Memory of getSize(capacity) bytes, aligned to 64 bytes.
+         * @param capacity - Maximal number of records in the ring.
+         * @return - Created ring.
+         */
+        static SharedRing* create(void* memory, std::size_t capacity)
+        {
+            return new (memory) SharedRing(capacity);
+        }
+
+        /**
+         * Method adding record to the ring. Only the writing process may call it.
+         * @param record - Added record.
+         * @return - False if the ring is full, true otherwise.
+         */
+        bool push(const T& record)
+        {
+            std::uint64_t tail = this->tail_.load(std::memory_order_relaxed);
+            if (tail - this->head_.load(std::memory_order_acquire) == this->capacity_) {
+                return false;
+            }
+            this->getRecords()[tail % this->capacity_] = record;
+            this->tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Method taking the oldest record from the ring. Only the reading process may call it.
+         * @param record - Taken record.
+         * @return - False if the ring is empty, true otherwise.
+         */
+        bool pop(T& record)
+        {
+            std::uint64_t head = this->head_.load(std::memory_order_relaxed);
+            if (head == this->tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            record = this->getRecords()[head % this->capacity_];
+            this->head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+    private:
+        /**
+         * Parametrized constructor of SharedRing class.
+         * @param capacity - Maximal number of records in the ring.
+         */
+        SharedRing(std::size_t capacity) : head_(0), tail_(0), capacity_(capacity) {}
+
+        /**
+         * Method returning records, which are placed right after the ring.
+         * @return - Records of the ring.
+         */
+        T* getRecords()
+        {
+            return reinterpret_cast<T*>(this + 1);
+        }
+        alignas(64) std::atomic<std::uint64_t> head_;
+        alignas(64) std::atomic<std::uint64_t> tail_;
+        std::size_t capacity_;
+    };
+}
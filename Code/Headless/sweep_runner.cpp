@@ -0,0 +1,209 @@
+/**
+ * sweep_runner.cpp
+ * Implementation of SweepRunner class.
+ */
+
+#include "sweep_runner.hpp"
+#include "parallel_loop.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <random>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Function comparing configurations by throughput, then by travel time.
+         * @param first - First configuration.
+         * @param second - Second configuration.
+         * @return - True if the first configuration is better, false otherwise.
+         */
+        bool isBetter(const SweepConfiguration& first, const SweepConfiguration& second)
+        {
+            if (first.throughput_ != second.throughput_) {
+                return first.throughput_ > second.throughput_;
+            }
+            return first.travelTicks_ < second.travelTicks_;
+        }
+    }
+
+    /**
+     * Parametrized constructor of SweepRunner class.
+     * @param ticks - Number of ticks simulated in the last rung.
+     * @param first_seed - Seed of the first simulation of every configuration, next ones use next seeds.
+     * @param seeds - Number of simulations of every configuration, their metrics are averaged.
+     * @param rungs - Number of rungs.
+     * @param eta - Part of configurations kept by every rung (1/eta) and growth of the budget between rungs.
+     * @param threads - Number of threads, 0 to use every core.
+     */
+    SweepRunner::SweepRunner(int ticks, unsigned first_seed, int seeds, int rungs, int eta, int threads) : ticks_(ticks),
+        seeds_(std::max(1, seeds)), rungs_(std::max(1, rungs)), eta_(std::max(2, eta)), threads_(threads), firstSeed_(first_seed) {}
+
+    /**
+     * Method returning grid of parameters: every combination of several values around the defaults.
+     * @return - Parameters of every configuration.
+     */
+    std::vector<SimulationParameters> SweepRunner::makeGrid()
+    {
+        std::vector<SimulationParameters> grid;
+        for (int spawn_percent : {3, 6, 12, 24}) {
+            for (int vehicles_percent : {25, 50, 100}) {
+                for (int speed : {2, 3, 4, 6}) {
+                    for (int unblock_ticks : {50, 100, 200}) {
+                        grid.push_back(SimulationParameters(spawn_percent, vehicles_percent, speed, unblock_ticks));
+                    }
+                }
+            }
+        }
+        return grid;
+    }
+
+    /**
+     * Method returning random sample of parameters from the same ranges as the grid.
+     * @param count - Number of configurations.
+     * @param seed - Seed of the sample.
+     * @return - Parameters of every configuration.
+     */
+    std::vector<SimulationParameters> SweepRunner::makeRandomSample(int count, unsigned seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_int_distribution<> spawn_percent(1, 30), vehicles_percent(10, 100), speed(1, 6), unblock_ticks(20, 300);
+        std::vector<SimulationParameters> sample;
+        for (int i = 0; i < count; i++) {
+            sample.push_back(SimulationParameters(spawn_percent(engine), vehicles_percent(engine), speed(engine), unblock_ticks(engine)));
+        }
+        return sample;
+    }
+
+    /**
+     * Method returning number of ticks simulated by configurations which reached the rung.
+     * @param rung - Number of the rung, from 0.
+     * @return - Budget of the rung, the last one gets every tick.
+     */
+    int SweepRunner::getRungTicks(int rung) const
+    {
+        int ticks = this->ticks_;
+        for (int i = rung; i < this->rungs_ - 1; i++) {
+            ticks /= this->eta_;
+        }
+        return std::max(1, ticks);
+    }
+
+    /**
+     * Method evaluating configurations. Configurations of one rung run in parallel, every one owns its simulations,
+     * so threads share only the index of the next configuration to take.
+     * @param scenario - Scenario to run, it is only read.
+     * @param parameters - Parameters of every configuration.
+     * @param log - Stream for progress of rungs.
+     * @return - Every configuration with metrics of the last rung it reached, best first.
+     */
+    std::vector<SweepConfiguration> SweepRunner::run(const Scenario& scenario, const std::vector<SimulationParameters>& parameters,
+                                                     std::ostream& log) const
+    {
+        std::vector<SweepConfiguration> configurations;
+        for (const SimulationParameters& configuration_parameters : parameters) {
+            configurations.push_back(SweepConfiguration{configuration_parameters, 0, 0, 0, 0, false});
+        }
+        std::vector<std::vector<std::shared_ptr<SimulationHandler>>> simulations(configurations.size());
+        std::vector<int> alive(configurations.size());
+        for (std::size_t i = 0; i < alive.size(); i++) {
+            alive[i] = i;
+        }
+
+        for (int rung = 0; rung < this->rungs_ && !alive.empty(); rung++) {
+            int rung_ticks = this->getRungTicks(rung);
+            ParallelLoop::run(alive.size(), this->threads_, [&](int index) {
+                SweepConfiguration& configuration = configurations[alive[index]];
+                std::vector<std::shared_ptr<SimulationHandler>>& configuration_simulations = simulations[alive[index]];
+                for (int seed = configuration_simulations.size(); seed < this->seeds_; seed++) {
+                    configuration_simulations.push_back(ScenarioRunner::createSimulation(scenario, this->firstSeed_ + seed, configuration.parameters_));
+                }
+                std::uint64_t exited = 0, exited_ticks = 0;
+                for (const std::shared_ptr<SimulationHandler>& simulation : configuration_simulations) {
+                    for (int tick = configuration.ticks_; tick < rung_ticks; tick++) {
+                        simulation->tick();
+                    }
+                    exited += simulation->getExitedVehiclesCount();
+                    exited_ticks += simulation->getExitedVehiclesTicks();
+                }
+                configuration.ticks_ = rung_ticks;
+                configuration.rung_ = rung;
+                configuration.throughput_ = exited * 1000.0 / rung_ticks / this->seeds_;
+                configuration.travelTicks_ = exited == 0 ? std::numeric_limits<double>::infinity() : static_cast<double>(exited_ticks) / exited;
+            });
+
+            std::sort(alive.begin(), alive.end(), [&](int first, int second) {
+                return isBetter(configurations[first], configurations[second]);
+            });
+            std::size_t kept = rung == this->rungs_ - 1 ? alive.size() : (alive.size() + this->eta_ - 1) / this->eta_;
+            std::vector<int> survivors(alive.begin(), alive.begin() + kept);
+            for (std::size_t i = kept; i < alive.size(); i++) {
+                bool is_dominated = std::any_of(alive.begin(), alive.end(), [&](int other) {
+                    return dominates(configurations[other], configurations[alive[i]]);
+                });
+                if (is_dominated) {
+                    configurations[alive[i]].isEliminated_ = true;
+                    std::vector<std::shared_ptr<SimulationHandler>>().swap(simulations[alive[i]]);
+                }
+                else {
+                    survivors.push_back(alive[i]);
+                }
+            }
+            log << "Rung " << rung + 1 << ": " << alive.size() << " configurations for " << rung_ticks << " ticks, "
+                << survivors.size() << " kept" << std::endl;
+            alive.swap(survivors);
+        }
+
+        std::stable_sort(configurations.begin(), configurations.end(), [](const SweepConfiguration& first, const SweepConfiguration& second) {
+            if (first.rung_ != second.rung_) {
+                return first.rung_ > second.rung_;
+            }
+            return isBetter(first, second);
+        });
+        return configurations;
+    }
+
+    /**
+     * Method checking if one configuration is clearly better: not worse in throughput nor travel time and better in
+     * at least one of them.
+     * @param first - First configuration.
+     * @param second - Second configuration.
+     * @return - True if the first configuration dominates the second one, false otherwise.
+     */
+    bool SweepRunner::dominates(const SweepConfiguration& first, const SweepConfiguration& second)
+    {
+        return first.throughput_ >= second.throughput_ && first.travelTicks_ <= second.travelTicks_
+            && (first.throughput_ > second.throughput_ || first.travelTicks_ < second.travelTicks_);
+    }
+
+    /**
+     * Method writing configurations as JSON, one configuration per line.
+     * @param stream - Output stream.
+     * @param name - Name of the scenario.
+     * @param configurations - Evaluated configurations.
+     */
+    void SweepRunner::writeJson(std::ostream& stream, const std::string& name, const std::vector<SweepConfiguration>& configurations)
+    {
+        stream << "{\"scenario\":\"" << name << "\",\"configurations\":[";
+        for (std::size_t i = 0; i < configurations.size(); i++) {
+            const SweepConfiguration& configuration = configurations[i];
+            stream << (i == 0 ? "" : ",") << "\n{\"spawn_percent\":" << configuration.parameters_.spawnPercent_
+                   << ",\"vehicles_per_roads_percent\":" << configuration.parameters_.vehiclesPerRoadsPercent_
+                   << ",\"vehicle_speed\":" << configuration.parameters_.vehicleSpeed_
+                   << ",\"unblock_ticks\":" << configuration.parameters_.unblockTicks_
+                   << ",\"ticks\":" << configuration.ticks_ << ",\"rung\":" << configuration.rung_ + 1
+                   << std::fixed << std::setprecision(3) << ",\"throughput\":" << configuration.throughput_ << ",\"travel_ticks\":";
+            if (configuration.travelTicks_ == std::numeric_limits<double>::infinity()) {
+                stream << "null";
+            }
+            else {
+                stream << configuration.travelTicks_;
+            }
+            stream << ",\"eliminated\":" << (configuration.isEliminated_ ? "true" : "false") << "}";
+        }
+        stream << "\n]}\n";
+    }
+}
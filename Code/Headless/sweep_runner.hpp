@@ -0,0 +1,46 @@
+/**
+ * sweep_runner.hpp
+ * Header of SweepRunner class.
+ */
+
+#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+#include "scenario_runner.hpp"
+#include "../components/simulation_parameters.hpp"
+
+namespace zpr {
+
+    /**
+     * Struct with one configuration of the sweep and its metrics from the last rung it reached.
+     * Throughput is number of vehicles which reached city exit per 1000 ticks, travel time is their mean lifetime.
+     */
+    struct SweepConfiguration {
+        SimulationParameters parameters_;
+        double throughput_, travelTicks_;
+        int ticks_, rung_;
+        bool isEliminated_;
+    };
+
+    /**
+     * Class evaluating configurations of traffic parameters with successive halving: every rung simulates surviving
+     * configurations eta times longer than the previous one and keeps only the best 1/eta of them, together with
+     * configurations which no other one beats in both throughput and travel time. Simulations are continued between
+     * rungs, so a configuration reaching the last rung costs the same as one full run.
+     */
+    class SweepRunner {
+    public:
+        SweepRunner(int ticks, unsigned first_seed, int seeds, int rungs, int eta, int threads);
+        static std::vector<SimulationParameters> makeGrid();
+        static std::vector<SimulationParameters> makeRandomSample(int count, unsigned seed);
+        std::vector<SweepConfiguration> run(const Scenario& scenario, const std::vector<SimulationParameters>& parameters,
+                                            std::ostream& log) const;
+        static bool dominates(const SweepConfiguration& first, const SweepConfiguration& second);
+        static void writeJson(std::ostream& stream, const std::string& name, const std::vector<SweepConfiguration>& configurations);
+    private:
+        int getRungTicks(int rung) const;
+        int ticks_, seeds_, rungs_, eta_, threads_;
+        unsigned firstSeed_;
+    };
+}
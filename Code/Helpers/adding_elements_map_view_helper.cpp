@@ -13,7 +13,7 @@ namespace zpr{
      */
     AddingHelper::AddingHelper(SimulatorDataRef data, int grid_size): data_(data), gridSize_(grid_size){
         this->roadBuilderHelper_ = std::make_unique<RoadBuilderHelper>(this->data_, this->gridSize_);
-        this->converter_ = std::make_unique<Converter>(this->gridSize_);
+        this->converter_ = std::make_unique<Converter>(this->gridSize_, WORLD_CELL_SIZE);
         this->cellSize_ = this->converter_->getCellSize();
         this->camerasHelper_ = std::make_unique<CamerasHelper>(this->cellSize_);
     }
@@ -26,7 +26,7 @@ namespace zpr{
      */
     sf::RectangleShape AddingHelper::addElement(std::string texture_name, sf::Vector2i position){
         sf::RectangleShape element;
-        element.setSize(sf::Vector2f(SCREEN_HEIGHT / this->gridSize_, SCREEN_HEIGHT / this->gridSize_));
+        element.setSize(sf::Vector2f(this->cellSize_, this->cellSize_));
         element.setTexture(&this->data_->assets_.getTexture(texture_name));
         element.setOrigin(sf::Vector2f(element.getSize().x / 2, element.getSize().y / 2));
         sf::Vector2f centered_position_in_pixels = this->converter_->transformRowColToPixels(sf::Vector2i(position.x, position.y));
@@ -0,0 +1,278 @@
+/**
+ * city_generator.cpp
+ * Implementation of CityGenerator class.
+ */
+
+#include "city_generator.hpp"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+namespace zpr {
+
+    /**
+     * Parametrized constructor of CityGenerator class. Generated city has no roads.
+     * @param grid_size - Size of the grid.
+     * @param seed - Seed of random layouts.
+     */
+    CityGenerator::CityGenerator(int grid_size, unsigned seed) : gridSize_(std::max(1, grid_size)), engine_(seed)
+    {
+        this->roads_.assign(static_cast<std::size_t>(this->gridSize_) * this->gridSize_, 0);
+    }
+
+    /**
+     * Method returning random number from 0 to bound - 1 (bound has to be positive).
+     * @param bound - Number of possible values.
+     * @return - Random number.
+     */
+    std::uint32_t CityGenerator::random(std::uint32_t bound)
+    {
+        return this->engine_() % bound;
+    }
+
+    /**
+     * Method adding road to the cell, if it is inside the grid.
+     * @param row - Row of the cell.
+     * @param column - Column of the cell.
+     */
+    void CityGenerator::addRoad(int row, int column)
+    {
+        if (row >= 0 && column >= 0 && row < this->gridSize_ && column < this->gridSize_) {
+            this->roads_[static_cast<std::size_t>(row) * this->gridSize_ + column] = 1;
+        }
+    }
+
+    /**
+     * Method adding Manhattan grid: roads in every (block_size + 1)-th row and column, starting from the first ones.
+     * @param block_size - Number of cells between two parallel roads.
+     */
+    void CityGenerator::addManhattanGrid(int block_size)
+    {
+        int period = std::max(1, block_size) + 1;
+        for (int row = 0; row < this->gridSize_; row++) {
+            for (int col = 0; col < this->gridSize_; col++) {
+                if (row % period == 0 || col % period == 0) {
+                    this->addRoad(row, col);
+                }
+            }
+        }
+    }
+
+    /**
+     * Method adding random spanning tree (maze): every crossing is placed every spacing cells in both directions
+     * and every crossing can be reached from every other by exactly one way. Depth-first search uses its own stack,
+     * so it works for the biggest grids.
+     * @param spacing - Distance between neighbouring crossings.
+     */
+    void CityGenerator::addSpanningTree(int spacing)
+    {
+        spacing = std::max(1, spacing);
+        int nodes_per_side = (this->gridSize_ - 1) / spacing + 1;
+        std::vector<std::uint8_t> visited(static_cast<std::size_t>(nodes_per_side) * nodes_per_side, 0);
+        std::vector<std::int32_t> stack;
+        stack.push_back(0);
+        visited[0] = 1;
+        this->addRoad(0, 0);
+        const int row_steps[] = {-1, 1, 0, 0};
+        const int col_steps[] = {0, 0, -1, 1};
+        while (!stack.empty()) {
+            int node = stack.back();
+            int node_row = node / nodes_per_side;
+            int node_col = node % nodes_per_side;
+            int neighbours[4];
+            int neighbours_count = 0;
+            for (int i = 0; i < 4; i++) {
+                int row = node_row + row_steps[i];
+                int col = node_col + col_steps[i];
+                if (row >= 0 && col >= 0 && row < nodes_per_side && col < nodes_per_side && !visited[row * nodes_per_side + col]) {
+                    neighbours[neighbours_count++] = i;
+                }
+            }
+            if (neighbours_count == 0) {
+                stack.pop_back();
+                continue;
+            }
+            int direction = neighbours[this->random(neighbours_count)];
+            for (int step = 1; step <= spacing; step++) {
+                this->addRoad(node_row * spacing + row_steps[direction] * step, node_col * spacing + col_steps[direction] * step);
+            }
+            int next = (node_row + row_steps[direction]) * nodes_per_side + node_col + col_steps[direction];
+            visited[next] = 1;
+            stack.push_back(next);
+        }
+    }
+
+    /**
+     * Method adding square ring road in given distance from the border of the grid.
+     * @param margin - Distance from the border.
+     */
+    void CityGenerator::addRingRoad(int margin)
+    {
+        int first = std::max(0, margin);
+        int last = this->gridSize_ - 1 - first;
+        for (int i = first; i <= last; i++) {
+            this->addRoad(first, i);
+            this->addRoad(last, i);
+            this->addRoad(i, first);
+            this->addRoad(i, last);
+        }
+    }
+
+    /**
+     * Method adding arterials: roads crossing the whole city in random rows and the same number of random columns.
+     * @param count - Number of arterials in each direction.
+     */
+    void CityGenerator::addArterials(int count)
+    {
+        for (int i = 0; i < count; i++) {
+            int row = this->random(this->gridSize_);
+            int col = this->random(this->gridSize_);
+            for (int j = 0; j < this->gridSize_; j++) {
+                this->addRoad(row, j);
+                this->addRoad(j, col);
+            }
+        }
+    }
+
+    /**
+     * Method putting cameras on different random roads. There are at most CAMERAS_COUNT cameras, numbered from 1.
+     * @param count - Number of cameras.
+     */
+    void CityGenerator::placeCameras(int count)
+    {
+        this->cameras_.clear();
+        std::int64_t roads_count = this->getRoadsCount();
+        count = static_cast<int>(std::min<std::int64_t>(std::min(count, CAMERAS_COUNT), roads_count));
+        while (static_cast<int>(this->cameras_.size()) < count) {
+            std::int64_t chosen = this->random(static_cast<std::uint32_t>(roads_count));
+            for (std::size_t i = 0; i < this->roads_.size(); i++) {
+                if (this->roads_[i] && chosen-- == 0) {
+                    sf::Vector2i position(i / this->gridSize_, i % this->gridSize_);
+                    if (this->getCamera(position.x, position.y) == 0) {
+                        this->cameras_.push_back(position);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Method adding road from the enter road (column 4 of the first row) down to the first road of the network.
+     */
+    void CityGenerator::connectEntrance()
+    {
+        int col = std::min(4, this->gridSize_ - 1);
+        for (int row = 0; row < this->gridSize_ && !this->containsRoad(row, col); row++) {
+            this->addRoad(row, col);
+        }
+    }
+
+    /**
+     * Method checking if cell contains road.
+     * @param row - Row of the cell.
+     * @param column - Column of the cell.
+     * @return - True if cell contains road, false otherwise.
+     */
+    bool CityGenerator::containsRoad(int row, int column) const
+    {
+        return this->roads_[static_cast<std::size_t>(row) * this->gridSize_ + column] != 0;
+    }
+
+    /**
+     * Method returning number of camera standing on the cell.
+     * @param row - Row of the cell.
+     * @param column - Column of the cell.
+     * @return - Number of the camera, 0 if there is no camera.
+     */
+    int CityGenerator::getCamera(int row, int column) const
+    {
+        for (std::size_t i = 0; i < this->cameras_.size(); i++) {
+            if (this->cameras_[i] == sf::Vector2i(row, column)) {
+                return static_cast<int>(i) + 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Method counting cells with roads.
+     * @return - Number of roads.
+     */
+    std::int64_t CityGenerator::getRoadsCount() const
+    {
+        return std::count(this->roads_.begin(), this->roads_.end(), 1);
+    }
+
+    /**
+     * Method returning cells with roads (and cameras), as kept by the editor.
+     * @return - Not empty cells.
+     */
+    std::vector<Cell> CityGenerator::getCells() const
+    {
+        std::vector<Cell> cells;
+        cells.reserve(this->getRoadsCount());
+        for (int row = 0; row < this->gridSize_; row++) {
+            for (int col = 0; col < this->gridSize_; col++) {
+                if (this->containsRoad(row, col)) {
+                    Cell cell(row, col);
+                    cell.containsRoad_ = true;
+                    cell.whichCamera_ = this->getCamera(row, col);
+                    cell.containsCamera_ = cell.whichCamera_ != 0;
+                    cells.push_back(cell);
+                }
+            }
+        }
+        return cells;
+    }
+
+    /**
+     * Method creating grid used by the editor and the simulation.
+     * @return - Grid with generated roads and cameras.
+     */
+    std::unique_ptr<ChunkedGrid> CityGenerator::createGrid() const
+    {
+        return std::make_unique<ChunkedGrid>(this->getCells(), this->gridSize_);
+    }
+
+    /**
+     * Method writing the map in format of saved maps: size of the grid, then "row column road" line for every cell.
+     * Cameras are not a part of the format, so they are not written.
+     * @param stream - Output stream.
+     */
+    void CityGenerator::write(std::ostream& stream) const
+    {
+        stream << this->gridSize_ << "\n";
+        std::vector<char> buffer(1 << 16);
+        std::size_t used = 0;
+        for (int row = 0; row < this->gridSize_; row++) {
+            for (int col = 0; col < this->gridSize_; col++) {
+                if (buffer.size() - used < 32) {
+                    stream.write(buffer.data(), used);
+                    used = 0;
+                }
+                char* end = buffer.data() + buffer.size();
+                char* position = std::to_chars(buffer.data() + used, end, row).ptr;
+                *position++ = ' ';
+                position = std::to_chars(position, end, col).ptr;
+                *position++ = ' ';
+                *position++ = this->containsRoad(row, col) ? '1' : '0';
+                *position++ = '\n';
+                used = position - buffer.data();
+            }
+        }
+        stream.write(buffer.data(), used);
+    }
+
+    /**
+     * Method saving the map to file.
+     * @param path - Path of the file.
+     * @return - True if the map was saved, false otherwise.
+     */
+    bool CityGenerator::saveToFile(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        this->write(file);
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * city_generator.hpp
+ * Header of CityGenerator class.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../components/cell.hpp"
+#include "../components/chunked_grid.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Class responsible for generating big road networks. Layouts can be combined: Manhattan grid, random spanning
+     * tree, ring roads and arterials, then cameras are put on random roads. Road from the enter road (column 4 of
+     * the first row) to the network is always added. The same seed gives the same map on every platform, because
+     * only std::mt19937 output is used, without standard distributions.
+     */
+    class CityGenerator {
+    public:
+        CityGenerator(int grid_size, unsigned seed);
+        void addManhattanGrid(int block_size);
+        void addSpanningTree(int spacing);
+        void addRingRoad(int margin);
+        void addArterials(int count);
+        void placeCameras(int count);
+        void connectEntrance();
+        bool containsRoad(int row, int column) const;
+        int getCamera(int row, int column) const;
+        std::int64_t getRoadsCount() const;
+        std::vector<Cell> getCells() const;
+        std::unique_ptr<ChunkedGrid> createGrid() const;
+        void write(std::ostream& stream) const;
+        bool saveToFile(const std::string& path) const;
+    private:
+        void addRoad(int row, int column);
+        std::uint32_t random(std::uint32_t bound);
+        int gridSize_;
+        std::mt19937 engine_;
+        std::vector<std::uint8_t> roads_;
+        std::vector<sf::Vector2i> cameras_;
+    };
+}
@@ -0,0 +1,34 @@
+/**
+ * command_line.cpp
+ * Implementation of CommandLine class.
+ */
+
+#include "command_line.hpp"
+#include <cstdlib>
+
+namespace zpr {
+
+    /**
+     * Method finding value of the option. Program argument "<option> <value>" (or "<option>=<value>") is used first,
+     * then environment variable.
+     * @param argc - Number of program arguments.
+     * @param argv - Program arguments.
+     * @param option - Name of the option, eg. "--trace".
+     * @param variable - Name of the environment variable, eg. "ZPR_TRACE".
+     * @return - Value of the option, empty if it was not given.
+     */
+    std::string CommandLine::getOptionValue(int argc, char* argv[], const std::string& option, const char* variable)
+    {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            if (argument == option && i + 1 < argc) {
+                return argv[i + 1];
+            }
+            if (argument.compare(0, option.size() + 1, option + "=") == 0) {
+                return argument.substr(option.size() + 1);
+            }
+        }
+        const char* value = std::getenv(variable);
+        return value != nullptr ? value : "";
+    }
+}
@@ -0,0 +1,18 @@
+/**
+ * command_line.hpp
+ * Header of CommandLine class.
+ */
+
+#pragma once
+#include <string>
+
+namespace zpr {
+
+    /**
+     * Class responsible for reading options of the application from program arguments and environment.
+     */
+    class CommandLine {
+    public:
+        static std::string getOptionValue(int argc, char* argv[], const std::string& option, const char* variable);
+    };
+}
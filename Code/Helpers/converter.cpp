@@ -4,6 +4,7 @@
  */
 
 #include "converter.hpp"
+#include <algorithm>
 
 
 namespace zpr {
@@ -13,9 +14,19 @@ namespace zpr {
      * @param grid_size - Size of the grid.
      */
     Converter::Converter(int grid_size): gridSize_(grid_size){
-        this->cellSize_ = (SCREEN_HEIGHT / this->gridSize_);
+        this->cellSize_ = std::max(1, SCREEN_HEIGHT / this->gridSize_);
+        double cell_size_with_point = (double)SCREEN_HEIGHT / gridSize_;
+        double the_rest = cell_size_with_point - this->cellSize_;
+        this->prefix_ = std::max(0, (int)(the_rest * gridSize_ / 2));
     }
 
+    /**
+     * Parametrized constructor of Converter class working in world units.
+     * @param grid_size - Size of the grid.
+     * @param cell_size - Size of a cell in world units.
+     */
+    Converter::Converter(int grid_size, int cell_size): cellSize_(cell_size), gridSize_(grid_size), prefix_(0) {}
+
     /**
      * Method responsible for converting pixels to rows or columns.
      * @param pixels - Value in pixels to convert.
@@ -49,10 +60,7 @@ namespace zpr {
     * @return - Calculated prefix.
     */
    int Converter::calculatePrefix() {
-       double cell_size_with_point = (double)SCREEN_HEIGHT / gridSize_;
-       double the_rest = cell_size_with_point - this->cellSize_;
-       int draw_prefix = the_rest * gridSize_ / 2;
-       return draw_prefix;
+       return this->prefix_;
    }
 
     /**
@@ -63,7 +71,6 @@ namespace zpr {
         return this->cellSize_;
     }
 
-
     /**
      * Method which converts Cell object to sf::RectangleShape object.
      * @param cell - Cell to convert.
@@ -73,8 +80,20 @@ namespace zpr {
     sf::RectangleShape Converter::convertCellToCenteredRectShape(Cell cell, std::string which_road)
     {
         sf::RectangleShape rect_shape;
-        rect_shape.setSize(sf::Vector2f(SCREEN_HEIGHT / this->gridSize_, SCREEN_HEIGHT / this->gridSize_));
+        rect_shape.setSize(sf::Vector2f(this->cellSize_, this->cellSize_));
         rect_shape.setOrigin(sf::Vector2f(rect_shape.getSize().x / 2, rect_shape.getSize().y / 2));
+        rect_shape.setPosition(this->convertCellToCenteredBox(cell, which_road).getPosition());
+        return rect_shape;
+    }
+
+    /**
+     * Method which converts Cell object to AABB box used by the simulation.
+     * @param cell - Cell to convert.
+     * @param which_road - Information if we are converting enter cells or user cells.
+     * @return - Box covering the cell.
+     */
+    AABB Converter::convertCellToCenteredBox(Cell cell, std::string which_road)
+    {
         sf::Vector2f centered_position_in_pixels;
         if(which_road == "User" ){
             centered_position_in_pixels = sf::Vector2f(cell.getPosition().x * this->cellSize_ + this->calculatePrefix(), cell.getPosition().y * this->cellSize_ + this->calculatePrefix());
@@ -85,8 +104,25 @@ namespace zpr {
                                      
         centered_position_in_pixels.x = centered_position_in_pixels.x + this->cellSize_ / 2;
         centered_position_in_pixels.y = centered_position_in_pixels.y + this->cellSize_ / 2;
-        rect_shape.setPosition(centered_position_in_pixels);
-        return rect_shape;
+        return AABB::fromCenter(centered_position_in_pixels.x, centered_position_in_pixels.y, this->cellSize_, this->cellSize_);
+    }
+
+    /**
+     * Method returning Z-order (Morton) code of the cell containing the point: bits of its column and row are
+     * interleaved, so cells close to each other usually have close codes. Points outside the grid get the code of
+     * the nearest cell of the grid.
+     * @param point - Point to convert.
+     * @return - Morton code of the cell.
+     */
+    std::uint32_t Converter::getMortonCode(sf::Vector2f point)
+    {
+        std::uint32_t column = std::min(std::max(this->transformPixelsToRowCol(point.x - this->prefix_), 0), this->gridSize_ - 1);
+        std::uint32_t row = std::min(std::max(this->transformPixelsToRowCol(point.y - this->prefix_), 0), this->gridSize_ - 1);
+        std::uint32_t code = 0;
+        for (std::uint32_t i = 0; i < 16; i++) {
+            code |= ((column >> i) & 1u) << (2 * i) | ((row >> i) & 1u) << (2 * i + 1);
+        }
+        return code;
     }
 
 }
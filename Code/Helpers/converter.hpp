@@ -3,25 +3,33 @@
  * Header of Converter class.
  */
 #pragma once
+#include <cstdint>
 #include "SFML/Graphics.hpp"
 #include "../definitions.hpp"
 #include "../components/cell.hpp"
+#include "../components/aabb.hpp"
 
 namespace zpr{
 
     /**
      * Class responsible for helping transforming values.
+     * Converter created only with grid size works in screen pixels, converter created with cell size works in world units
+     * (WORLD_CELL_SIZE per cell, no prefix), which are used by the simulation regardless of grid size and window resolution.
      */
     class Converter{
     public:
         Converter(int grid_size);
+        Converter(int grid_size, int cell_size);
         sf::Vector2f transformRowColToPixels(sf::Vector2i rowcol);
         int transformPixelsToRowCol(double pixels);
         int calculatePrefix();
         int getCellSize();
         sf::RectangleShape convertCellToCenteredRectShape(Cell cell, std::string whichRoad);
+        AABB convertCellToCenteredBox(Cell cell, std::string which_road);
+        std::uint32_t getMortonCode(sf::Vector2f point);
     private:
         int cellSize_;
         int gridSize_;
+        int prefix_;
     };
 }
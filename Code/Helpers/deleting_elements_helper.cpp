@@ -14,8 +14,8 @@ namespace zpr {
      */
     DeletingHelper::DeletingHelper(SimulatorDataRef data, int grid_size): data_(data), gridSize_(grid_size){
         this->roadBuilderHelper_ = std::make_unique<RoadBuilderHelper>(this->data_, this->gridSize_);
-        this->converter_ = std::make_unique<Converter>(this->gridSize_);
-        this->cellSize_ = (SCREEN_HEIGHT / this->gridSize_);
+        this->converter_ = std::make_unique<Converter>(this->gridSize_, WORLD_CELL_SIZE);
+        this->cellSize_ = this->converter_->getCellSize();
         this->camerasHelper_ = std::make_unique<CamerasHelper>(this->cellSize_);
     }
 
@@ -19,9 +19,9 @@ namespace zpr{
      * @param is_simulating - Value telling if simulation is taking place.
      * @param grid_lines - sf::RectangleShape objects representing lines of grid.
      */
-    void DrawingHelper::drawGrid(bool is_simulating, std::vector<sf::RectangleShape> grid_lines) {
+    void DrawingHelper::drawGrid(bool is_simulating, const std::vector<sf::RectangleShape>& grid_lines) {
         if(!is_simulating){
-            for (sf::RectangleShape line : grid_lines) {
+            for (const sf::RectangleShape& line : grid_lines) {
                 this->data_->window_.draw(line);
             }
         }
@@ -31,21 +31,21 @@ namespace zpr{
      * Method responsible for drawing roads made by user.
      * @param roads - Vector of roads existing in map view.
      */
-    void DrawingHelper::drawRoads(std::vector<sf::RectangleShape> roads){
-        for (sf::RectangleShape road : roads) {
+    void DrawingHelper::drawRoads(const std::vector<sf::RectangleShape>& roads){
+        for (const sf::RectangleShape& road : roads) {
             this->data_->window_.draw(road);
         }
     }
 
     /**
      * Method responsible for drawing vehicles.
-     * @param vehicles - Vector of vehicles existing in map view.
+     * @param vehicles - Snapshots of vehicles existing in map view.
      */
 
-    void DrawingHelper::drawVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles)
+    void DrawingHelper::drawVehicles(const std::vector<VehicleSnapshot>& vehicles)
     {
-        for (std::shared_ptr<Vehicle>& vehicle : vehicles) {
-            this->data_->window_.draw(*vehicle);
+        for (const VehicleSnapshot& vehicle : vehicles) {
+            this->data_->window_.draw(vehicle);
         }
 
     }
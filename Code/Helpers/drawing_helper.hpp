@@ -17,9 +17,9 @@ namespace zpr {
     class DrawingHelper{
     public:
         DrawingHelper(SimulatorDataRef data);
-        void drawGrid(bool is_simulating, std::vector<sf::RectangleShape> grid_lines);
-        void drawRoads(std::vector<sf::RectangleShape> roads);
-        void drawVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles);
+        void drawGrid(bool is_simulating, const std::vector<sf::RectangleShape>& grid_lines);
+        void drawRoads(const std::vector<sf::RectangleShape>& roads);
+        void drawVehicles(const std::vector<VehicleSnapshot>& vehicles);
         void drawCameras(sf::RectangleShape *cameras);
         
     private:
@@ -15,7 +15,7 @@ namespace zpr {
      * @param grid_size - Size of grid in map view.
      */
     RoadBuilderHelper::RoadBuilderHelper(SimulatorDataRef data, int grid_size): data_(data), gridSize_(grid_size){
-        this->converter_ = std::make_unique<Converter>(this->gridSize_);
+        this->converter_ = std::make_unique<Converter>(this->gridSize_, WORLD_CELL_SIZE);
         this->cellSize_ = this->converter_->getCellSize();
     }
 
@@ -16,8 +16,9 @@ namespace zpr {
     class SpawnPoints{
     public:
         SpawnPoints(int grid_size);
-        void setupExitSites(std::vector<sf::RectangleShape>& city_exit_site);
-        void addStartingRoad(std::vector<sf::RectangleShape>& roads);
+        SpawnPoints(int grid_size, int cell_size);
+        void setupExitSites(std::vector<AABB>& city_exit_site);
+        void addStartingRoad(std::vector<AABB>& roads);
     private:
         int gridSize_;
         int cellSize_;
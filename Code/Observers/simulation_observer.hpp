@@ -14,10 +14,11 @@ namespace zpr {
     class SimulationObserver
     {
     public:
-        virtual void updateVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles) {}
+        virtual void updateVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles) {}
         virtual void updateIsSimulating(bool is_simulating) {}
         virtual void updateCarsLabel(int which_label) {}
         virtual void updateTrucksLabel(int which_label) {}
+        virtual void updateSpeedUp(int time_scale, float speed_up) {}
         virtual ~SimulationObserver() {}
     };
 }
@@ -0,0 +1,150 @@
+/**
+ * hdr_histogram.cpp
+ * Implementation of HdrHistogram class.
+ */
+
+#include "hdr_histogram.hpp"
+#include <cmath>
+
+namespace zpr {
+
+    /**
+     * Default constructor of HdrHistogram class. Histogram is empty.
+     */
+    HdrHistogram::HdrHistogram()
+    {
+        this->clear();
+    }
+
+    /**
+     * Method returning index of the bucket keeping the value. Values below SUB_BUCKETS_COUNT have their own buckets,
+     * every bigger power of two range is split into SUB_BUCKETS_COUNT / 2 equally wide buckets.
+     * @param value - Value, not bigger than MAX_VALUE.
+     * @return - Index of the bucket.
+     */
+    int HdrHistogram::getBucketIndex(std::uint64_t value)
+    {
+        if (value < SUB_BUCKETS_COUNT) {
+            return static_cast<int>(value);
+        }
+        int shift = 0;
+        while ((value >> shift) >= SUB_BUCKETS_COUNT) {
+            shift++;
+        }
+        return static_cast<int>(SUB_BUCKETS_COUNT + (shift - 1) * SUB_BUCKETS_COUNT / 2 + (value >> shift) - SUB_BUCKETS_COUNT / 2);
+    }
+
+    /**
+     * Method returning the biggest value kept in the bucket.
+     * @param index - Index of the bucket.
+     * @return - The biggest value of the bucket.
+     */
+    std::uint64_t HdrHistogram::getHighestEquivalentValue(int index)
+    {
+        if (index < static_cast<int>(SUB_BUCKETS_COUNT)) {
+            return index;
+        }
+        int offset = index - static_cast<int>(SUB_BUCKETS_COUNT);
+        int shift = offset / static_cast<int>(SUB_BUCKETS_COUNT / 2) + 1;
+        std::uint64_t mantissa = offset % (SUB_BUCKETS_COUNT / 2) + SUB_BUCKETS_COUNT / 2;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    /**
+     * Method adding value to the histogram. It does not allocate memory.
+     * @param value - Recorded value, bigger ones than MAX_VALUE are recorded as MAX_VALUE.
+     */
+    void HdrHistogram::record(std::uint64_t value)
+    {
+        if (value > MAX_VALUE) {
+            value = MAX_VALUE;
+        }
+        this->counts_[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        this->sum_.fetch_add(value, std::memory_order_relaxed);
+        if (value < this->min_.load(std::memory_order_relaxed)) {
+            this->min_.store(value, std::memory_order_relaxed);
+        }
+        if (value > this->max_.load(std::memory_order_relaxed)) {
+            this->max_.store(value, std::memory_order_relaxed);
+        }
+        this->count_.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * Method returning number of recorded values.
+     * @return - Number of values.
+     */
+    std::uint64_t HdrHistogram::getCount() const
+    {
+        return this->count_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Method returning the smallest recorded value.
+     * @return - The smallest value, 0 if histogram is empty.
+     */
+    std::uint64_t HdrHistogram::getMin() const
+    {
+        return this->getCount() == 0 ? 0 : this->min_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Method returning the biggest recorded value.
+     * @return - The biggest value, 0 if histogram is empty.
+     */
+    std::uint64_t HdrHistogram::getMax() const
+    {
+        return this->max_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Method returning mean of recorded values.
+     * @return - Mean, 0 if histogram is empty.
+     */
+    double HdrHistogram::getMean() const
+    {
+        std::uint64_t count = this->getCount();
+        return count == 0 ? 0.0 : static_cast<double>(this->sum_.load(std::memory_order_relaxed)) / count;
+    }
+
+    /**
+     * Method returning value below or equal to which given percent of recorded values is.
+     * @param percentile - Percentile, eg. 99.9.
+     * @return - The biggest value of the bucket with the percentile (not bigger than recorded maximum), 0 if histogram is empty.
+     */
+    std::uint64_t HdrHistogram::getValueAtPercentile(double percentile) const
+    {
+        std::uint64_t count = this->getCount();
+        if (count == 0) {
+            return 0;
+        }
+        std::uint64_t target = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * count));
+        if (target < 1) {
+            target = 1;
+        }
+        std::uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS_COUNT; i++) {
+            seen += this->counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                std::uint64_t value = getHighestEquivalentValue(i);
+                std::uint64_t max = this->getMax();
+                return value < max ? value : max;
+            }
+        }
+        return this->getMax();
+    }
+
+    /**
+     * Method removing every recorded value.
+     */
+    void HdrHistogram::clear()
+    {
+        for (std::atomic<std::uint64_t>& count : this->counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        this->count_.store(0, std::memory_order_relaxed);
+        this->sum_.store(0, std::memory_order_relaxed);
+        this->min_.store(MAX_VALUE, std::memory_order_relaxed);
+        this->max_.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,40 @@
+/**
+ * hdr_histogram.hpp
+ * Header of HdrHistogram class.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace zpr {
+
+    /**
+     * High dynamic range histogram with fixed memory. Values up to MAX_VALUE are kept in log-linear buckets:
+     * values below SUB_BUCKETS_COUNT exactly, bigger ones with relative error below 1 / (SUB_BUCKETS_COUNT / 2).
+     * Bigger values are clamped. Counters are atomics, so it can be read while one thread records.
+     */
+    class HdrHistogram {
+    public:
+        static constexpr int SUB_BUCKET_BITS = 7;
+        static constexpr int MAX_VALUE_BITS = 40;
+        static constexpr std::uint64_t SUB_BUCKETS_COUNT = std::uint64_t(1) << SUB_BUCKET_BITS;
+        static constexpr std::uint64_t MAX_VALUE = (std::uint64_t(1) << MAX_VALUE_BITS) - 1;
+        static constexpr int BUCKETS_COUNT = SUB_BUCKETS_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKETS_COUNT / 2;
+
+        HdrHistogram();
+        void record(std::uint64_t value);
+        std::uint64_t getCount() const;
+        std::uint64_t getMin() const;
+        std::uint64_t getMax() const;
+        double getMean() const;
+        std::uint64_t getValueAtPercentile(double percentile) const;
+        void clear();
+        static int getBucketIndex(std::uint64_t value);
+        static std::uint64_t getHighestEquivalentValue(int index);
+    private:
+        std::array<std::atomic<std::uint64_t>, BUCKETS_COUNT> counts_;
+        std::atomic<std::uint64_t> count_, sum_, min_, max_;
+    };
+}
@@ -0,0 +1,161 @@
+/**
+ * metrics.cpp
+ * Implementation of Metrics and ScopedMetric classes.
+ */
+
+#include "metrics.hpp"
+#include <fstream>
+#include <iomanip>
+
+namespace zpr {
+
+    /**
+     * Method returning the only Metrics object, shared by every thread.
+     * @return - Reference to the metrics.
+     */
+    Metrics& Metrics::instance()
+    {
+        static Metrics metrics;
+        return metrics;
+    }
+
+    /**
+     * Default constructor of Metrics class. Metrics are stopped.
+     */
+    Metrics::Metrics() : enabled_(false), startTime_(std::chrono::steady_clock::now()) {}
+
+    /**
+     * Method returning name of the metric, as written to the metrics file. Name ends with the unit.
+     * @param metric - Metric.
+     * @return - Name of the metric.
+     */
+    const char* Metrics::getMetricName(Metric metric)
+    {
+        static const char* names[METRICS_COUNT] = {
+            "tick_duration_ns", "frame_duration_ns", "vehicle_lifetime_ticks", "notify_latency_ns"
+        };
+        return names[static_cast<int>(metric)];
+    }
+
+    /**
+     * Method starting recording of metrics.
+     * @param path - Path of the metrics file, empty if nothing should be written.
+     * @param interval - Time between dumps to the file in milliseconds.
+     */
+    void Metrics::start(const std::string& path, int interval)
+    {
+        this->path_ = path;
+        this->startTime_ = std::chrono::steady_clock::now();
+        this->enabled_.store(true, std::memory_order_release);
+        if (!path.empty()) {
+            this->dumpTimer_.setInterval([&]() {
+                this->dump();
+            }, interval);
+        }
+    }
+
+    /**
+     * Method stopping recording of metrics and appending last line to the metrics file.
+     * @return - False if the metrics file could not be written, true otherwise.
+     */
+    bool Metrics::stop()
+    {
+        if (!this->enabled_.exchange(false, std::memory_order_acq_rel) || this->path_.empty()) {
+            return true;
+        }
+        this->dumpTimer_.stopTimer();
+        return this->dump();
+    }
+
+    /**
+     * Method adding value to the histogram of the metric. Does nothing when metrics are stopped.
+     * @param metric - Metric.
+     * @param value - Value in unit of the metric.
+     */
+    void Metrics::record(Metric metric, std::uint64_t value)
+    {
+        if (!this->isEnabled()) {
+            return;
+        }
+        this->histograms_[static_cast<int>(metric)].record(value);
+    }
+
+    /**
+     * Method returning histogram of the metric.
+     * @param metric - Metric.
+     * @return - Histogram of the metric.
+     */
+    const HdrHistogram& Metrics::getHistogram(Metric metric) const
+    {
+        return this->histograms_[static_cast<int>(metric)];
+    }
+
+    /**
+     * Method writing one JSON line with time since start and count, min, mean, percentiles and max of every metric.
+     * @param stream - Output stream.
+     */
+    void Metrics::writeJsonLine(std::ostream& stream) const
+    {
+        static const double percentiles[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+        static const char* percentile_names[] = {"p50", "p90", "p99", "p99_9", "p99_99"};
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - this->startTime_;
+        stream << std::fixed << std::setprecision(3) << "{\"time_s\":" << elapsed.count();
+        for (int i = 0; i < METRICS_COUNT; i++) {
+            const HdrHistogram& histogram = this->histograms_[i];
+            stream << ",\"" << getMetricName(static_cast<Metric>(i)) << "\":{\"count\":" << histogram.getCount()
+                   << ",\"min\":" << histogram.getMin() << ",\"mean\":" << histogram.getMean();
+            for (int j = 0; j < 5; j++) {
+                stream << ",\"" << percentile_names[j] << "\":" << histogram.getValueAtPercentile(percentiles[j]);
+            }
+            stream << ",\"max\":" << histogram.getMax() << "}";
+        }
+        stream << "}\n";
+    }
+
+    /**
+     * Method appending current line to the metrics file.
+     * @return - False if the metrics file could not be written, true otherwise.
+     */
+    bool Metrics::dump()
+    {
+        std::lock_guard<std::mutex> lock(this->fileMutex_);
+        std::ofstream file(this->path_, std::ios::app);
+        if (!file) {
+            return false;
+        }
+        this->writeJsonLine(file);
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Method removing every recorded value.
+     */
+    void Metrics::clear()
+    {
+        for (HdrHistogram& histogram : this->histograms_) {
+            histogram.clear();
+        }
+    }
+
+    /**
+     * Parametrized constructor of ScopedMetric class. It starts measuring if metrics are started.
+     * @param metric - Measured duration metric.
+     */
+    ScopedMetric::ScopedMetric(Metric metric) : metric_(metric), isRecording_(Metrics::instance().isEnabled())
+    {
+        if (this->isRecording_) {
+            this->start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * Destructor of ScopedMetric class. It records the duration.
+     */
+    ScopedMetric::~ScopedMetric()
+    {
+        if (this->isRecording_) {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - this->start_;
+            Metrics::instance().record(this->metric_, elapsed.count());
+        }
+    }
+}
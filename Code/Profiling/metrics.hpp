@@ -0,0 +1,75 @@
+/**
+ * metrics.hpp
+ * Header of Metrics and ScopedMetric classes.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "hdr_histogram.hpp"
+#include "../components/timer.hpp"
+#include "../definitions.hpp"
+
+namespace zpr {
+
+    /**
+     * Long-run metrics. Durations are in nanoseconds, vehicle lifetime (from spawn to reaching city exit) in ticks.
+     */
+    enum class Metric {
+        TickDuration, FrameDuration, VehicleLifetime, NotifyLatency,
+        Count
+    };
+
+    /**
+     * Class keeping HdrHistogram of every metric for the whole session. When started, it appends one JSON line
+     * with percentiles of every metric to the metrics file every METRICS_DUMP_INTERVAL milliseconds and on stop.
+     */
+    class Metrics {
+    public:
+        static Metrics& instance();
+        static const char* getMetricName(Metric metric);
+
+        /**
+         * Method checking if metrics are recorded.
+         * @return - True if metrics are started, false otherwise.
+         */
+        bool isEnabled() const
+        {
+            return this->enabled_.load(std::memory_order_relaxed);
+        }
+        void start(const std::string& path, int interval);
+        bool stop();
+        void record(Metric metric, std::uint64_t value);
+        const HdrHistogram& getHistogram(Metric metric) const;
+        void writeJsonLine(std::ostream& stream) const;
+        bool dump();
+        void clear();
+    private:
+        Metrics();
+        static constexpr int METRICS_COUNT = static_cast<int>(Metric::Count);
+        std::atomic<bool> enabled_;
+        std::string path_;
+        std::chrono::steady_clock::time_point startTime_;
+        std::mutex fileMutex_;
+        Timer dumpTimer_;
+        std::array<HdrHistogram, METRICS_COUNT> histograms_;
+    };
+
+    /**
+     * Class which records time between its construction and destruction as a duration metric.
+     */
+    class ScopedMetric {
+    public:
+        ScopedMetric(Metric metric);
+        ~ScopedMetric();
+    private:
+        Metric metric_;
+        bool isRecording_;
+        std::chrono::steady_clock::time_point start_;
+    };
+}
@@ -0,0 +1,132 @@
+/**
+ * perf_counters.cpp
+ * Implementation of PerfCounters class.
+ */
+
+#include "perf_counters.hpp"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace zpr {
+
+    /**
+     * Method returning counters of the calling thread. They are opened on the first call from the thread.
+     * @return - Counters of the calling thread.
+     */
+    PerfCounters& PerfCounters::forThisThread()
+    {
+        static thread_local PerfCounters counters;
+        return counters;
+    }
+
+    /**
+     * Method returning short name of the counter.
+     * @param counter - Counter.
+     * @return - Name of the counter.
+     */
+    const char* PerfCounters::getCounterName(PerfCounter counter)
+    {
+        static const char* names[COUNTERS_COUNT] = {"cycles", "instructions", "LLC misses", "branch misses"};
+        return names[static_cast<int>(counter)];
+    }
+
+    /**
+     * Default constructor of PerfCounters class. It opens user space counters of the calling thread, cycles being
+     * the group leader, and starts them.
+     */
+    PerfCounters::PerfCounters() : openedCount_(0)
+    {
+        this->fds_.fill(-1);
+#ifdef __linux__
+        const std::uint64_t configs[COUNTERS_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for (int i = 0; i < COUNTERS_COUNT; i++) {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = configs[i];
+            attributes.disabled = i == 0 ? 1 : 0;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP;
+            this->fds_[i] = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, this->fds_[0], 0));
+            if (this->fds_[0] < 0) {
+                return;
+            }
+            if (this->fds_[i] >= 0) {
+                this->openedCount_++;
+            }
+        }
+        ioctl(this->fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(this->fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    /**
+     * Destructor of PerfCounters class. It closes opened counters.
+     */
+    PerfCounters::~PerfCounters()
+    {
+#ifdef __linux__
+        for (int fd : this->fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Method checking if any counter is available.
+     * @return - True if at least cycles can be read, false otherwise.
+     */
+    bool PerfCounters::isAvailable() const
+    {
+        return this->openedCount_ > 0;
+    }
+
+    /**
+     * Method checking if the counter is available.
+     * @param counter - Counter.
+     * @return - True if the counter can be read, false otherwise.
+     */
+    bool PerfCounters::isAvailable(PerfCounter counter) const
+    {
+        return this->fds_[static_cast<int>(counter)] >= 0;
+    }
+
+    /**
+     * Method reading current values of the counters. Unavailable counters are 0.
+     * @param values - Read values.
+     * @return - True if counters were read, false otherwise.
+     */
+    bool PerfCounters::read(CounterValues& values) const
+    {
+        values.fill(0);
+#ifdef __linux__
+        if (!this->isAvailable()) {
+            return false;
+        }
+        std::uint64_t buffer[1 + COUNTERS_COUNT];
+        if (::read(this->fds_[0], buffer, sizeof(buffer)) < static_cast<ssize_t>(sizeof(std::uint64_t) * (1 + this->openedCount_))) {
+            return false;
+        }
+        int j = 1;
+        for (int i = 0; i < COUNTERS_COUNT; i++) {
+            if (this->fds_[i] >= 0) {
+                values[i] = buffer[j++];
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * perf_counters.hpp
+ * Header of PerfCounters class.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace zpr {
+
+    /**
+     * Hardware counters read around profiled phases.
+     */
+    enum class PerfCounter {
+        Cycles, Instructions, LlcMisses, BranchMisses,
+        Count
+    };
+
+    using CounterValues = std::array<std::uint64_t, static_cast<int>(PerfCounter::Count)>;
+
+    /**
+     * Class responsible for hardware counters of the calling thread, opened with perf_event_open as one group.
+     * Counters which cannot be opened (other systems than Linux, perf_event_paranoid, virtual machines without PMU)
+     * are unavailable and read as 0; when cycles cannot be opened, nothing is available.
+     */
+    class PerfCounters {
+    public:
+        static PerfCounters& forThisThread();
+        static const char* getCounterName(PerfCounter counter);
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+        ~PerfCounters();
+        bool isAvailable() const;
+        bool isAvailable(PerfCounter counter) const;
+        bool read(CounterValues& values) const;
+    private:
+        PerfCounters();
+        static constexpr int COUNTERS_COUNT = static_cast<int>(PerfCounter::Count);
+        std::array<int, COUNTERS_COUNT> fds_;
+        int openedCount_;
+    };
+}
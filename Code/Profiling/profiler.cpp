@@ -0,0 +1,252 @@
+/**
+ * profiler.cpp
+ * Implementation of Profiler, ScopedTimer and ScopedFrame classes.
+ */
+
+#include "profiler.hpp"
+#include <algorithm>
+
+namespace zpr {
+
+    namespace {
+
+        /**
+         * Function starting hardware counters of a scope, if they are enabled and available on the calling thread.
+         * @param start_counters - Values of counters at the start of the scope.
+         * @return - True if counters were read, false otherwise.
+         */
+        bool startCounting(CounterValues& start_counters)
+        {
+            return Profiler::instance().isCountersEnabled() && PerfCounters::forThisThread().read(start_counters);
+        }
+
+        /**
+         * Function adding hardware counters of a scope to the phase.
+         * @param phase - Measured phase.
+         * @param start_counters - Values of counters at the start of the scope.
+         */
+        void stopCounting(ProfilerPhase phase, const CounterValues& start_counters)
+        {
+            CounterValues counters;
+            if (!PerfCounters::forThisThread().read(counters)) {
+                return;
+            }
+            for (std::size_t i = 0; i < counters.size(); i++) {
+                counters[i] -= start_counters[i];
+            }
+            Profiler::instance().accumulateCounters(phase, counters);
+        }
+    }
+
+    /**
+     * Method returning the only Profiler object, shared by the simulation and render threads.
+     * @return - Reference to the profiler.
+     */
+    Profiler& Profiler::instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * Default constructor of Profiler class. Hardware counters are disabled.
+     */
+    Profiler::Profiler() : countersEnabled_(false)
+    {
+        this->clear();
+    }
+
+    /**
+     * Method returning name of the phase, as shown in the overlay.
+     * @param phase - Phase.
+     * @return - Name of the phase.
+     */
+    const char* Profiler::getPhaseName(ProfilerPhase phase)
+    {
+        static const char* names[PHASES_COUNT] = {
+            "Tick", "Add cars", "Move vehicles", "Collision", "Camera vision", "Delete vehicles", "Notify vehicles",
+            "Draw", "Background", "Cells", "Roads", "Grid", "Cameras", "Vehicles"
+        };
+        return names[static_cast<int>(phase)];
+    }
+
+    /**
+     * Method adding time to the current (not committed yet) sample of the phase. Several threads can add time to
+     * the same phase at once.
+     * @param phase - Measured phase.
+     * @param nanoseconds - Measured time.
+     */
+    void Profiler::accumulate(ProfilerPhase phase, std::int64_t nanoseconds)
+    {
+        std::atomic<std::int64_t>& pending = this->pending_[static_cast<int>(phase)];
+        std::int64_t current = pending.load(std::memory_order_relaxed);
+        while (!pending.compare_exchange_weak(current, current < 0 ? nanoseconds : current + nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * Method adding hardware counters to the current (not committed yet) sample of the phase. Several threads can
+     * add counters to the same phase at once.
+     * @param phase - Measured phase.
+     * @param counters - Counted events.
+     */
+    void Profiler::accumulateCounters(ProfilerPhase phase, const CounterValues& counters)
+    {
+        int i = static_cast<int>(phase);
+        for (int j = 0; j < COUNTERS_COUNT; j++) {
+            this->pendingCounters_[i][j].fetch_add(counters[j], std::memory_order_relaxed);
+        }
+        this->hasPendingCounters_[i].store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Method which stores current samples of phases from first to last. Phases which did not run are skipped.
+     * @param first - First phase of the tick or frame.
+     * @param last - Last phase of the tick or frame.
+     */
+    void Profiler::commit(ProfilerPhase first, ProfilerPhase last)
+    {
+        for (int i = static_cast<int>(first); i <= static_cast<int>(last); i++) {
+            if (this->hasPendingCounters_[i].exchange(false, std::memory_order_relaxed)) {
+                for (int j = 0; j < COUNTERS_COUNT; j++) {
+                    this->counterTotals_[i][j].fetch_add(this->pendingCounters_[i][j].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                this->counterSamples_[i].fetch_add(1, std::memory_order_release);
+            }
+            std::int64_t value = this->pending_[i].exchange(-1, std::memory_order_relaxed);
+            if (value < 0) {
+                continue;
+            }
+            unsigned index = this->written_[i].load(std::memory_order_relaxed);
+            this->samples_[i][index % PROFILER_WINDOW_SIZE].store(value, std::memory_order_relaxed);
+            this->written_[i].store(index + 1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * Method calculating p50 and p99 of the last samples of the phase and mean hardware counters of samples
+     * taken since counters were enabled.
+     * @param phase - Phase.
+     * @return - Percentiles in microseconds, mean counters and numbers of used samples.
+     */
+    PhaseStats Profiler::getStats(ProfilerPhase phase) const
+    {
+        int i = static_cast<int>(phase);
+        PhaseStats stats{0, 0, 0, {}, 0};
+        stats.counterSamples_ = this->counterSamples_[i].load(std::memory_order_acquire);
+        for (int j = 0; j < COUNTERS_COUNT && stats.counterSamples_ > 0; j++) {
+            stats.counters_[j] = static_cast<double>(this->counterTotals_[i][j].load(std::memory_order_relaxed)) / stats.counterSamples_;
+        }
+        int count = std::min<unsigned>(this->written_[i].load(std::memory_order_acquire), PROFILER_WINDOW_SIZE);
+        if (count == 0) {
+            return stats;
+        }
+        std::array<std::int64_t, PROFILER_WINDOW_SIZE> values;
+        for (int j = 0; j < count; j++) {
+            values[j] = this->samples_[i][j].load(std::memory_order_relaxed);
+        }
+        std::sort(values.begin(), values.begin() + count);
+        stats.p50_ = values[(count - 1) * 50 / 100] / 1000.0;
+        stats.p99_ = values[(count - 1) * 99 / 100] / 1000.0;
+        stats.samples_ = count;
+        return stats;
+    }
+
+    /**
+     * Method enabling or disabling reading of hardware counters by profiled scopes. Enabling starts new means.
+     * @param enabled - True to read counters, false otherwise.
+     */
+    void Profiler::setCountersEnabled(bool enabled)
+    {
+        if (enabled) {
+            this->clearCounters();
+        }
+        this->countersEnabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * Method checking if profiled scopes read hardware counters.
+     * @return - True if counters are enabled, false otherwise.
+     */
+    bool Profiler::isCountersEnabled() const
+    {
+        return this->countersEnabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Method removing every sample.
+     */
+    void Profiler::clear()
+    {
+        for (int i = 0; i < PHASES_COUNT; i++) {
+            this->pending_[i].store(-1, std::memory_order_relaxed);
+            this->written_[i].store(0, std::memory_order_relaxed);
+        }
+        this->clearCounters();
+    }
+
+    /**
+     * Method removing every hardware counters sample.
+     */
+    void Profiler::clearCounters()
+    {
+        for (int i = 0; i < PHASES_COUNT; i++) {
+            this->hasPendingCounters_[i].store(false, std::memory_order_relaxed);
+            this->counterSamples_[i].store(0, std::memory_order_relaxed);
+            for (int j = 0; j < COUNTERS_COUNT; j++) {
+                this->pendingCounters_[i][j].store(0, std::memory_order_relaxed);
+                this->counterTotals_[i][j].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Parametrized constructor of ScopedTimer class. It starts measuring.
+     * @param phase - Measured phase.
+     */
+    ScopedTimer::ScopedTimer(ProfilerPhase phase) : phase_(phase), isCounting_(startCounting(startCounters_))
+    {
+        this->start_ = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Destructor of ScopedTimer class. It adds measured time to the phase.
+     */
+    ScopedTimer::~ScopedTimer()
+    {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        Profiler::instance().accumulate(this->phase_, (end - this->start_).count());
+        if (this->isCounting_) {
+            stopCounting(this->phase_, this->startCounters_);
+        }
+#ifdef ZPR_TRACING
+        Tracer::instance().record(Profiler::getPhaseName(this->phase_), this->start_, end);
+#endif
+    }
+
+    /**
+     * Parametrized constructor of ScopedFrame class. It starts measuring.
+     * @param phase - Phase measuring whole tick or frame.
+     * @param last_phase - Last phase belonging to the tick or frame.
+     */
+    ScopedFrame::ScopedFrame(ProfilerPhase phase, ProfilerPhase last_phase) : phase_(phase), lastPhase_(last_phase), isCounting_(startCounting(startCounters_))
+    {
+        this->start_ = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Destructor of ScopedFrame class. It stores whole time and closes every phase of the tick or frame.
+     */
+    ScopedFrame::~ScopedFrame()
+    {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        Profiler::instance().accumulate(this->phase_, (end - this->start_).count());
+        if (this->isCounting_) {
+            stopCounting(this->phase_, this->startCounters_);
+        }
+        Profiler::instance().commit(this->phase_, this->lastPhase_);
+#ifdef ZPR_TRACING
+        Tracer::instance().record(Profiler::getPhaseName(this->phase_), this->start_, end);
+#endif
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * profiler.hpp
+ * Header of Profiler, ScopedTimer and ScopedFrame classes and profiling macros.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "../definitions.hpp"
+#include "tracer.hpp"
+#include "perf_counters.hpp"
+
+/**
+ * Profiling macros. They expand to nothing unless the build defines ZPR_PROFILING (CMake option ENABLE_PROFILING).
+ * ZPR_PROFILE_SCOPE adds time of the current scope to the phase, ZPR_PROFILE_FRAME measures the whole tick or frame
+ * and closes it, so every phase from phase to last_phase gets one sample.
+ * Without the profiler, but with ZPR_TRACING, phases are still recorded as trace events.
+ */
+#define ZPR_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ZPR_PROFILE_CONCAT(a, b) ZPR_PROFILE_CONCAT_IMPL(a, b)
+#if defined(ZPR_PROFILING)
+#define ZPR_PROFILE_SCOPE(phase) zpr::ScopedTimer ZPR_PROFILE_CONCAT(zpr_profile_scope_, __LINE__)(zpr::ProfilerPhase::phase)
+#define ZPR_PROFILE_FRAME(phase, last_phase) zpr::ScopedFrame ZPR_PROFILE_CONCAT(zpr_profile_frame_, __LINE__)(zpr::ProfilerPhase::phase, zpr::ProfilerPhase::last_phase)
+#elif defined(ZPR_TRACING)
+#define ZPR_PROFILE_SCOPE(phase) zpr::TraceScope ZPR_PROFILE_CONCAT(zpr_profile_scope_, __LINE__)(zpr::Profiler::getPhaseName(zpr::ProfilerPhase::phase))
+#define ZPR_PROFILE_FRAME(phase, last_phase) zpr::TraceScope ZPR_PROFILE_CONCAT(zpr_profile_frame_, __LINE__)(zpr::Profiler::getPhaseName(zpr::ProfilerPhase::phase))
+#else
+#define ZPR_PROFILE_SCOPE(phase)
+#define ZPR_PROFILE_FRAME(phase, last_phase)
+#endif
+
+namespace zpr {
+
+    /**
+     * Measured phases. Simulation phases are written only by the simulation thread, drawing phases only by the render thread.
+     */
+    enum class ProfilerPhase {
+        Tick, AddCars, MoveVehicles, Collision, CameraVision, DeleteVehicles, NotifyVehicles,
+        Draw, DrawBackground, DrawCells, DrawRoads, DrawGrid, DrawCameras, DrawVehicles,
+        Count
+    };
+
+    /**
+     * Struct with percentiles of one phase, in microseconds, and mean hardware counters per sample of the phase.
+     */
+    struct PhaseStats {
+        double p50_, p99_;
+        int samples_;
+        std::array<double, static_cast<int>(PerfCounter::Count)> counters_;
+        int counterSamples_;
+    };
+
+    /**
+     * Class responsible for keeping last PROFILER_WINDOW_SIZE samples of every phase. Several threads (eg. workers
+     * moving vehicles on tiles) can add to the current sample of a phase at once, it is committed by one thread.
+     * Samples are atomics, so the render thread can read them while the simulation thread writes.
+     */
+    class Profiler {
+    public:
+        static Profiler& instance();
+        static constexpr bool isEnabled()
+        {
+#ifdef ZPR_PROFILING
+            return true;
+#else
+            return false;
+#endif
+        }
+        static const char* getPhaseName(ProfilerPhase phase);
+        void accumulate(ProfilerPhase phase, std::int64_t nanoseconds);
+        void accumulateCounters(ProfilerPhase phase, const CounterValues& counters);
+        void commit(ProfilerPhase first, ProfilerPhase last);
+        PhaseStats getStats(ProfilerPhase phase) const;
+        void setCountersEnabled(bool enabled);
+        bool isCountersEnabled() const;
+        void clear();
+    private:
+        Profiler();
+        void clearCounters();
+        static constexpr int PHASES_COUNT = static_cast<int>(ProfilerPhase::Count);
+        static constexpr int COUNTERS_COUNT = static_cast<int>(PerfCounter::Count);
+        std::array<std::atomic<std::int64_t>, PHASES_COUNT> pending_;
+        std::array<std::atomic<unsigned>, PHASES_COUNT> written_;
+        std::array<std::array<std::atomic<std::int64_t>, PROFILER_WINDOW_SIZE>, PHASES_COUNT> samples_;
+        std::atomic<bool> countersEnabled_;
+        std::array<std::atomic<bool>, PHASES_COUNT> hasPendingCounters_;
+        std::array<std::array<std::atomic<std::uint64_t>, COUNTERS_COUNT>, PHASES_COUNT> pendingCounters_;
+        std::array<std::array<std::atomic<std::uint64_t>, COUNTERS_COUNT>, PHASES_COUNT> counterTotals_;
+        std::array<std::atomic<unsigned>, PHASES_COUNT> counterSamples_;
+    };
+
+    /**
+     * Class which adds time (and hardware counters, when they are enabled) between its construction and destruction to a phase.
+     */
+    class ScopedTimer {
+    public:
+        ScopedTimer(ProfilerPhase phase);
+        ~ScopedTimer();
+    private:
+        ProfilerPhase phase_;
+        std::chrono::steady_clock::time_point start_;
+        CounterValues startCounters_;
+        bool isCounting_;
+    };
+
+    /**
+     * Class which measures whole tick or frame and then stores one sample for every phase of it.
+     */
+    class ScopedFrame {
+    public:
+        ScopedFrame(ProfilerPhase phase, ProfilerPhase last_phase);
+        ~ScopedFrame();
+    private:
+        ProfilerPhase phase_, lastPhase_;
+        std::chrono::steady_clock::time_point start_;
+        CounterValues startCounters_;
+        bool isCounting_;
+    };
+}
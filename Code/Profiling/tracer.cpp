@@ -0,0 +1,199 @@
+/**
+ * tracer.cpp
+ * Implementation of Tracer and TraceScope classes.
+ */
+
+#include "tracer.hpp"
+#include <fstream>
+#include <iomanip>
+
+namespace zpr {
+
+    /**
+     * Method returning the only Tracer object, shared by every thread.
+     * @return - Reference to the tracer.
+     */
+    Tracer& Tracer::instance()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /**
+     * Default constructor of Tracer class. Tracing is stopped.
+     */
+    Tracer::Tracer() : enabled_(false), epoch_(std::chrono::steady_clock::now()) {}
+
+    /**
+     * Method starting recording of events.
+     * @param path - Path of the file written by stop(), empty if nothing should be written.
+     */
+    void Tracer::start(const std::string& path)
+    {
+        this->path_ = path;
+        this->epoch_ = std::chrono::steady_clock::now();
+        this->enabled_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Method stopping recording of events and writing them to the trace file.
+     * @return - False if the trace file could not be written, true otherwise.
+     */
+    bool Tracer::stop()
+    {
+        if (!this->enabled_.exchange(false, std::memory_order_acq_rel) || this->path_.empty()) {
+            return true;
+        }
+        std::ofstream file(this->path_);
+        if (!file) {
+            return false;
+        }
+        this->writeJson(file);
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Method returning buffer of the calling thread. Buffer is created on the first call from the thread,
+     * which is the only moment a lock is taken.
+     * @return - Buffer of the calling thread.
+     */
+    Tracer::ThreadBuffer& Tracer::getThreadBuffer()
+    {
+        static thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+            created->events_.reset(new Event[TRACER_BUFFER_SIZE]);
+            created->size_.store(0, std::memory_order_relaxed);
+            created->dropped_.store(0, std::memory_order_relaxed);
+            created->name_.store(nullptr, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(this->buffersMutex_);
+            created->id_ = static_cast<int>(this->buffers_.size()) + 1;
+            buffer = created.get();
+            this->buffers_.push_back(std::move(created));
+        }
+        return *buffer;
+    }
+
+    /**
+     * Method adding event to the buffer of the calling thread. Does nothing when tracing is stopped.
+     * @param name - Name of the event, it has to be a string literal.
+     * @param start - Beginning of the event.
+     * @param end - End of the event.
+     */
+    void Tracer::record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        if (!this->isEnabled()) {
+            return;
+        }
+        ThreadBuffer& buffer = this->getThreadBuffer();
+        std::size_t index = buffer.size_.load(std::memory_order_relaxed);
+        if (index >= TRACER_BUFFER_SIZE) {
+            buffer.dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events_[index] = Event{name, (start - this->epoch_).count(), (end - start).count()};
+        buffer.size_.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * Method naming the calling thread in the trace. Does nothing when tracing is stopped.
+     * @param name - Name of the thread, it has to be a string literal.
+     */
+    void Tracer::setThreadName(const char* name)
+    {
+        if (!this->isEnabled()) {
+            return;
+        }
+        this->getThreadBuffer().name_.store(name, std::memory_order_relaxed);
+    }
+
+    /**
+     * Method writing recorded events as Chrome trace JSON. Only events completely written before the call are used,
+     * so it can run while other threads still record.
+     * @param stream - Output stream.
+     */
+    void Tracer::writeJson(std::ostream& stream) const
+    {
+        std::lock_guard<std::mutex> lock(this->buffersMutex_);
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        stream << std::fixed << std::setprecision(3);
+        bool first = true;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : this->buffers_) {
+            const char* thread_name = buffer->name_.load(std::memory_order_relaxed);
+            if (thread_name != nullptr) {
+                stream << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id_
+                       << ",\"args\":{\"name\":\"" << thread_name << "\"}}";
+                first = false;
+            }
+            std::size_t size = buffer->size_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < size; i++) {
+                const Event& event = buffer->events_[i];
+                stream << (first ? "" : ",") << "\n{\"name\":\"" << event.name_ << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id_
+                       << ",\"ts\":" << event.start_ / 1000.0 << ",\"dur\":" << event.duration_ / 1000.0 << "}";
+                first = false;
+            }
+        }
+        stream << "\n]}\n";
+    }
+
+    /**
+     * Method counting recorded events of every thread.
+     * @return - Number of recorded events.
+     */
+    std::size_t Tracer::getEventsCount() const
+    {
+        std::lock_guard<std::mutex> lock(this->buffersMutex_);
+        std::size_t count = 0;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : this->buffers_) {
+            count += buffer->size_.load(std::memory_order_acquire);
+        }
+        return count;
+    }
+
+    /**
+     * Method counting events which did not fit in the buffers.
+     * @return - Number of dropped events.
+     */
+    std::size_t Tracer::getDroppedCount() const
+    {
+        std::lock_guard<std::mutex> lock(this->buffersMutex_);
+        std::size_t count = 0;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : this->buffers_) {
+            count += buffer->dropped_.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    /**
+     * Method removing every recorded event. Buffers are kept, threads still own them.
+     */
+    void Tracer::clear()
+    {
+        std::lock_guard<std::mutex> lock(this->buffersMutex_);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : this->buffers_) {
+            buffer->size_.store(0, std::memory_order_relaxed);
+            buffer->dropped_.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Parametrized constructor of TraceScope class. It starts measuring if tracing is started.
+     * @param name - Name of the event, it has to be a string literal.
+     */
+    TraceScope::TraceScope(const char* name) : name_(name), isRecording_(Tracer::instance().isEnabled())
+    {
+        if (this->isRecording_) {
+            this->start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * Destructor of TraceScope class. It records the event.
+     */
+    TraceScope::~TraceScope()
+    {
+        if (this->isRecording_) {
+            Tracer::instance().record(this->name_, this->start_, std::chrono::steady_clock::now());
+        }
+    }
+}
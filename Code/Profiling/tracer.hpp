@@ -0,0 +1,89 @@
+/**
+ * tracer.hpp
+ * Header of Tracer and TraceScope classes and tracing macro.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../definitions.hpp"
+
+/**
+ * Tracing macro. It expands to nothing unless the build defines ZPR_TRACING (CMake option ENABLE_TRACING).
+ * When compiled in, it costs one atomic load until tracing is started with --trace or ZPR_TRACE.
+ */
+#ifdef ZPR_TRACING
+#define ZPR_TRACE_CONCAT_IMPL(a, b) a##b
+#define ZPR_TRACE_CONCAT(a, b) ZPR_TRACE_CONCAT_IMPL(a, b)
+#define ZPR_TRACE_SCOPE(name) zpr::TraceScope ZPR_TRACE_CONCAT(zpr_trace_scope_, __LINE__)(name)
+#else
+#define ZPR_TRACE_SCOPE(name)
+#endif
+
+namespace zpr {
+
+    /**
+     * Class recording timed events and writing them as Chrome trace (chrome://tracing, ui.perfetto.dev).
+     * Every thread writes only to its own buffer of TRACER_BUFFER_SIZE events, so recording does not take locks.
+     * Events which do not fit are dropped and counted.
+     */
+    class Tracer {
+    public:
+        static Tracer& instance();
+
+        /**
+         * Method checking if events are recorded.
+         * @return - True if tracing is started, false otherwise.
+         */
+        bool isEnabled() const
+        {
+            return this->enabled_.load(std::memory_order_relaxed);
+        }
+        void start(const std::string& path);
+        bool stop();
+        void record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+        void setThreadName(const char* name);
+        void writeJson(std::ostream& stream) const;
+        std::size_t getEventsCount() const;
+        std::size_t getDroppedCount() const;
+        void clear();
+    private:
+        struct Event {
+            const char* name_;
+            std::int64_t start_, duration_;
+        };
+        struct ThreadBuffer {
+            std::unique_ptr<Event[]> events_;
+            std::atomic<std::size_t> size_;
+            std::atomic<std::size_t> dropped_;
+            std::atomic<const char*> name_;
+            int id_;
+        };
+        Tracer();
+        ThreadBuffer& getThreadBuffer();
+        std::atomic<bool> enabled_;
+        std::string path_;
+        std::chrono::steady_clock::time_point epoch_;
+        mutable std::mutex buffersMutex_;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    };
+
+    /**
+     * Class which records one trace event lasting from its construction to its destruction.
+     */
+    class TraceScope {
+    public:
+        TraceScope(const char* name);
+        ~TraceScope();
+    private:
+        const char* name_;
+        bool isRecording_;
+        std::chrono::steady_clock::time_point start_;
+    };
+}
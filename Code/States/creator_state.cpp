@@ -17,14 +17,14 @@ namespace zpr {
      * @param data - Struct containing data of current application. (eg. window, assets)
      * @param grid_size - Size of grid chosen by user
      */
-    CreatorState::CreatorState(SimulatorDataRef data, int grid_size) : data_(data), gridSize_(grid_size) { }
+    CreatorState::CreatorState(SimulatorDataRef data, int grid_size) : data_(data), gridSize_(grid_size), isHybrid_(false), isCellularAutomaton_(false), isCarFollowing_(false) { }
     /**
      * Parametrized constructor of CreatorState class.
      * @param data - Struct containing data of current application. (eg. window, assets)
      * @param grid_size - Size of grid chosen by user
      * @param cells - Vector of cells passed from LoadState or SaveState
      */
-    CreatorState::CreatorState(SimulatorDataRef data, int grid_size, std::vector<Cell> cells) : data_(data), gridSize_(grid_size), cells_(cells) {
+    CreatorState::CreatorState(SimulatorDataRef data, int grid_size, std::vector<Cell> cells) : data_(data), gridSize_(grid_size), isHybrid_(false), isCellularAutomaton_(false), isCarFollowing_(false), cells_(cells) {
     }
     
     /**
@@ -77,6 +77,27 @@ namespace zpr {
                     this->camerasView_->handleInput();
                 }
             }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                this->camerasView_->toggleProfilerOverlay();
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+                this->camerasView_->toggleProfilerCounters();
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F5) {
+                this->isHybrid_ = !this->isHybrid_;
+                this->simulationHandler_->setHybrid(this->isHybrid_);
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F6) {
+                this->isCellularAutomaton_ = !this->isCellularAutomaton_;
+                this->simulationHandler_->setCellularAutomaton(this->isCellularAutomaton_);
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F7) {
+                this->isCarFollowing_ = !this->isCarFollowing_;
+                this->simulationHandler_->setCarFollowing(this->isCarFollowing_);
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F8) {
+                this->simulationHandler_->setTimeScale(SimulationHandler::getNextTimeScale(this->simulationHandler_->getTimeScale()));
+            }
             if (event.type == sf::Event::MouseWheelScrolled) {
                 if (event.mouseWheelScroll.delta > 0)
                     {
@@ -112,11 +133,12 @@ namespace zpr {
         }
     }
     /**
-     * Method which updates the window.
+     * Method which updates the window. Vehicles in the part of the city visible in the map view are simulated in
+     * detail when simulation is hybrid.
      * @param dt - Frequency of updating.
      */
     void CreatorState::update(float dt){
-        
+        this->simulationHandler_->setDetailedArea(this->mapView_->getVisibleArea());
     }
 
     /**
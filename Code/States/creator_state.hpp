@@ -42,6 +42,7 @@ namespace zpr{
         std::shared_ptr<SimulationHandler> simulationHandler_;
         std::shared_ptr<CamerasSubject> camerasSubject_;
         int gridSize_;
+        bool isHybrid_, isCellularAutomaton_, isCarFollowing_;
         std::vector<Cell> cells_;
     };
 }
@@ -6,6 +6,9 @@
 #include "save_state.hpp"
 #include "../definitions.hpp"
 #include "creator_state.hpp"
+#include "../components/chunked_grid.hpp"
+#include "../components/executor.hpp"
+#include <cstdio>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -100,17 +103,45 @@ namespace zpr {
    
 
     /**
-     * Method which saves data to specified file.
+     * Method which saves data to specified file. Every cell of the grid is written, also the empty ones
+     * which are not kept in memory. The file is written by the Executor into a temporary file which then replaces
+     * the slot, so the window does not wait for the disk and loading never sees half of a map. The Executor finishes
+     * pending tasks when the application closes, so a map saved just before is written too. Failures are reported on
+     * the standard error stream.
      * @param number - Number of slot to save.
      */
     void SaveState::saveToFile(int number){
-        std::ofstream file;
-        file.open("SavedMaps/Map"+std::to_string(number)+".txt");
-        file << gridsize_ <<std::endl;
-        for (Cell& cell : cells_){
-            file << cell;
-        }
-        file.close();
+        std::string path = "SavedMaps/Map"+std::to_string(number)+".txt";
+        std::vector<Cell> cells = this->cells_;
+        int grid_size = this->gridsize_;
+        Executor::instance().submit([path, cells, grid_size]() {
+            std::ofstream file;
+            file.open(path + ".tmp");
+            file << grid_size <<std::endl;
+            ChunkedGrid grid(cells, grid_size);
+            Cell empty_cell;
+            for (int row = 0; row < grid_size; row++){
+                for (int col = 0; col < grid_size; col++){
+                    const Cell* cell = grid.findCell(row, col);
+                    if (cell){
+                        file << *cell;
+                    }
+                    else{
+                        empty_cell = Cell(row, col);
+                        file << empty_cell;
+                    }
+                }
+            }
+            file.close();
+            if (!file){
+                std::cerr << "Could not write map file " << path << ".tmp" << std::endl;
+                std::remove((path + ".tmp").c_str());
+                return;
+            }
+            if (std::rename((path + ".tmp").c_str(), path.c_str()) != 0){
+                std::cerr << "Could not replace map file " << path << std::endl;
+            }
+        });
         this->buttonsInitializer();
     }
 
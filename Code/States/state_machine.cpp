@@ -4,6 +4,7 @@
  */
 
 #include "state_machine.hpp"
+#include "../profiling/tracer.hpp"
 
 namespace zpr
 {
@@ -27,6 +28,7 @@ namespace zpr
      * Method responsible for handling states (adding, removing)
      */
     void StateMachine::processStateChanges(){
+        ZPR_TRACE_SCOPE("Process state changes");
         if (this-> isRemoving_ && !this-> states_.empty()){
             this->states_.pop();
         
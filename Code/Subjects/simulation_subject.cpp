@@ -21,9 +21,9 @@ namespace zpr {
      * Method which notifies observers when vector of vehicles has changed.
      * @param vehicles - Updated vector of vehicles.
      */
-    void SimulationSubject::notifyVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles)
+    void SimulationSubject::notifyVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles)
     {
-        for (std::shared_ptr<SimulationObserver> observer : this->_observers) {
+        for (const std::shared_ptr<SimulationObserver>& observer : this->_observers) {
             observer->updateVehicles(vehicles);
         }
     }
@@ -60,4 +60,16 @@ namespace zpr {
             observer->updateTrucksLabel(which_label);
         }
     }
+
+    /**
+     * Method which notifies observers about speed-up of the simulation reached in the last measurement.
+     * @param time_scale - Chosen speed-up, 0 for as fast as possible.
+     * @param speed_up - Simulated time divided by real time.
+     */
+    void SimulationSubject::notifySpeedUp(int time_scale, float speed_up)
+    {
+        for (std::shared_ptr<SimulationObserver> observer : this->_observers) {
+            observer->updateSpeedUp(time_scale, speed_up);
+        }
+    }
 }
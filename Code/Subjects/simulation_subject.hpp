@@ -18,10 +18,11 @@ namespace zpr {
     {
     public:
         void add(std::shared_ptr<SimulationObserver> obs);
-        void notifyVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles);
+        void notifyVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles);
         void notifyIsSimulating(bool is_simulating);
         void notifyCarsLabel(int which_label);
         void notifyTrucksLabel(int which_label);
+        void notifySpeedUp(int time_scale, float speed_up);
         virtual ~SimulationSubject() {}
     private:
         std::vector<std::shared_ptr<SimulationObserver> > _observers;
@@ -0,0 +1,61 @@
+/**
+ * city_generator_main.cpp
+ * Command line tool generating big maps.
+ */
+
+#include "../helpers/city_generator.hpp"
+#include "../helpers/command_line.hpp"
+#include <chrono>
+#include <iostream>
+
+/**
+ * Main function of the generator. Options: "--output <file>" (required), "--grid <size>" (256 by default), "--seed <n>",
+ * "--layout manhattan|tree|mixed", "--block <cells>" between Manhattan roads, "--spacing <cells>" between spanning
+ * tree crossings, "--rings <n>" ring roads, "--arterials <n>" in each direction and "--cameras <n>".
+ * Mixed layout is a spanning tree with ring roads and arterials.
+ */
+int main(int argc, char* argv[])
+{
+    auto option = [&](const std::string& name, const std::string& default_value) {
+        std::string value = zpr::CommandLine::getOptionValue(argc, argv, "--" + name, "");
+        return value.empty() ? default_value : value;
+    };
+    std::string output = option("output", "");
+    if (output.empty()) {
+        std::cerr << "Usage: " << argv[0] << " --output <file> [--grid 256] [--seed 1] [--layout manhattan|tree|mixed]"
+                  << " [--block 3] [--spacing 4] [--rings 1] [--arterials 2] [--cameras 3]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int grid_size = std::stoi(option("grid", "256"));
+    std::string layout = option("layout", "manhattan");
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    zpr::CityGenerator generator(grid_size, std::stoul(option("seed", "1")));
+    if (layout == "manhattan") {
+        generator.addManhattanGrid(std::stoi(option("block", "3")));
+    }
+    else if (layout == "tree" || layout == "mixed") {
+        generator.addSpanningTree(std::stoi(option("spacing", "4")));
+    }
+    else {
+        std::cerr << "Unknown layout " << layout << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (layout == "mixed") {
+        int rings = std::stoi(option("rings", "1"));
+        for (int i = 1; i <= rings; i++) {
+            generator.addRingRoad(grid_size * i / (2 * rings + 2));
+        }
+        generator.addArterials(std::stoi(option("arterials", "2")));
+    }
+    generator.connectEntrance();
+    generator.placeCameras(std::stoi(option("cameras", "3")));
+    if (!generator.saveToFile(output)) {
+        std::cerr << "Could not write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << grid_size << "x" << grid_size << " " << layout << " map with " << generator.getRoadsCount()
+              << " roads written to " << output << " in " << elapsed.count() << " s" << std::endl;
+    return EXIT_SUCCESS;
+}
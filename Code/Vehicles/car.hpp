@@ -15,6 +15,6 @@ namespace zpr {
 	class Car: public Vehicle
 	{
 	public:
-		Car(int x, int y, int cell_size, std::vector<sf::RectangleShape> roads, std::string direction);
+		Car(int x, int y, int cell_size, const std::vector<AABB>& roads, const std::string& direction);
 	};
 }
@@ -16,7 +16,8 @@ namespace zpr {
 	class Truck : public Vehicle
 	{
 	public:
-		Truck(int x, int y, int cell_size, std::vector<sf::RectangleShape> roads, std::string direction);
+		Truck(int x, int y, int cell_size, const std::vector<AABB>& roads, const std::string& direction);
+		bool isTruck() const override;
 	};
 
 }
@@ -4,15 +4,63 @@
  */
 
 #include "vehicle.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <random>
 
 namespace zpr {
 
+    /**
+     * Method which puts the vehicle on starting position, so the same object can be used again by the simulation.
+     * Sizes, roads, cell size, speed and unblock threshold given in constructor are kept.
+     * @param x - Position x of the vehicle.
+     * @param y - Position y of the vehicle.
+     * @param direction - Starting direction.
+     * @param seed - Seed of the vehicle random engine (used when choosing where to turn).
+     */
+    void Vehicle::reset(int x, int y, const std::string& direction, unsigned seed)
+    {
+        this->x_ = x;
+        this->y_ = y;
+        this->speed_ = this->maxSpeed_;
+        this->velocity_ = this->maxSpeed_;
+        this->travelled_ = 0;
+        this->stopCounter_ = 0;
+        this->spawnTick_ = 0;
+        this->wakeTick_ = 0;
+        this->straightUntilTick_ = 0;
+        for (int i = 0; i < 3; i++) {
+            this->seenByCamera_[i] = false;
+        }
+        this->direction_ = direction;
+        this->previousDirection_ = "";
+        this->currentRoad_ = nullptr;
+        this->previousRoad_ = nullptr;
+        this->blocker_ = nullptr;
+        this->firstSleeper_ = nullptr;
+        this->nextSleeper_ = nullptr;
+        this->rotation_ = 0;
+        this->engine_.seed(seed);
+        this->shape_ = AABB::fromCenter(x, y, this->size_.x, this->size_.y);
+        sf::Vector2f colision_box_size = this->colisionBox_.getSize();
+        this->colisionBox_ = AABB::fromCenter(x, y + (colision_box_size.y / 2 + this->size_.y / 2 + this->roadStripesSize_), colision_box_size.x, colision_box_size.y);
+    }
+
+    /**
+     * Method telling if the vehicle is a truck.
+     * @return - False, trucks override it.
+     */
+    bool Vehicle::isTruck() const
+    {
+        return false;
+    }
+
     /**
      * Method returning shape of the Vehicle.
-     * @return - Shape of the vehicle.
+     * @return - Box occupied by the vehicle.
      */
-    sf::RectangleShape Vehicle::getShape()
+    const AABB& Vehicle::getShape() const
     {
         return this->shape_;
     }
@@ -23,23 +71,23 @@ namespace zpr {
     void Vehicle::move()
     {
         if (direction_ == "North") {
-            this->shape_.setRotation(0);
-            this->x_ = this->currentRoad_->getPosition().x + this->roadSize_ / 2 + this->roadStripesSize_;
+            this->rotation_ = 0;
+            this->x_ = this->getLanePosition();
             this->y_ -= this->speed_;
         }
         else if (direction_ == "South") {
-            this->shape_.setRotation(0);
-            this->x_ = this->currentRoad_->getPosition().x - this->roadSize_ / 2 - this->roadStripesSize_;
+            this->rotation_ = 0;
+            this->x_ = this->getLanePosition();
             this->y_ += this->speed_;
         }
         else if (direction_ == "East") {
-            this->shape_.setRotation(90);
-            this->y_ = this->currentRoad_->getPosition().y + this->roadSize_ / 2 + this->roadStripesSize_;
+            this->rotation_ = 90;
+            this->y_ = this->getLanePosition();
             this->x_ += this->speed_;
         }
         else if (direction_ == "West") {
-            this->shape_.setRotation(90);
-            this->y_ = this->currentRoad_->getPosition().y - this->roadSize_ / 2 - this->roadStripesSize_;
+            this->rotation_ = 90;
+            this->y_ = this->getLanePosition();
             this->x_ -= this->speed_;
         }
         this->updateColisionBoxPosition();
@@ -47,37 +95,135 @@ namespace zpr {
         
     }
 
+    /**
+     * Method returning position of the lane of current road in which the vehicle goes: x for vertical directions,
+     * y for horizontal ones.
+     * @return - Position of the lane.
+     */
+    int Vehicle::getLanePosition() const
+    {
+        sf::Vector2f road = this->currentRoad_->getPosition();
+        if (direction_ == "North") {
+            return road.x + this->roadSize_ / 2 + this->roadStripesSize_;
+        }
+        else if (direction_ == "South") {
+            return road.x - this->roadSize_ / 2 - this->roadStripesSize_;
+        }
+        else if (direction_ == "East") {
+            return road.y + this->roadSize_ / 2 + this->roadStripesSize_;
+        }
+        return road.y - this->roadSize_ / 2 - this->roadStripesSize_;
+    }
+
+    /**
+     * Method checking if next move only moves the vehicle forward: it is turned in its direction and it is already
+     * in the lane of current road.
+     * @return - True if the vehicle is in its lane, false otherwise.
+     */
+    bool Vehicle::isInLane() const
+    {
+        if (!this->currentRoad_) {
+            return false;
+        }
+        if (direction_ == "North" || direction_ == "South") {
+            return this->rotation_ == 0 && this->x_ == this->getLanePosition();
+        }
+        return this->rotation_ == 90 && this->y_ == this->getLanePosition();
+    }
+
+    /**
+     * Method returning move of the vehicle in one tick at maximal speed.
+     * @return - Change of position.
+     */
+    sf::Vector2f Vehicle::getStep() const
+    {
+        if (direction_ == "North") {
+            return sf::Vector2f(0, -this->maxSpeed_);
+        }
+        else if (direction_ == "South") {
+            return sf::Vector2f(0, this->maxSpeed_);
+        }
+        else if (direction_ == "East") {
+            return sf::Vector2f(this->maxSpeed_, 0);
+        }
+        return sf::Vector2f(-this->maxSpeed_, 0);
+    }
+
+    /**
+     * Method returning how far the vehicle has to drive along its direction to leave current road and enter the
+     * next cell, as checked by checkOnWhichCell.
+     * @return - Distance in whole world units, at least 1, the biggest int if the vehicle is not on current road.
+     */
+    int Vehicle::getCellExitDistance() const
+    {
+        sf::Vector2f position = this->shape_.getPosition();
+        if (!this->currentRoad_ || !this->currentRoad_->contains(position)) {
+            return std::numeric_limits<int>::max();
+        }
+        float distance;
+        if (direction_ == "North") {
+            distance = std::floor(position.y - this->currentRoad_->top_) + 1;
+        }
+        else if (direction_ == "South") {
+            distance = std::ceil(this->currentRoad_->bottom_ - position.y);
+        }
+        else if (direction_ == "East") {
+            distance = std::ceil(this->currentRoad_->right_ - position.x);
+        }
+        else {
+            distance = std::floor(position.x - this->currentRoad_->left_) + 1;
+        }
+        return std::max(static_cast<int>(distance), 1);
+    }
+
     /**
      * Method responsible for updating Vehicle's position.
      */
     void Vehicle::updatePosition() {
-        this->shape_.setPosition(sf::Vector2f(x_, y_));
+        if (this->rotation_ == 0) {
+            this->shape_ = AABB::fromCenter(this->x_, this->y_, this->size_.x, this->size_.y);
+        }
+        else {
+            this->shape_ = AABB::fromCenter(this->x_, this->y_, this->size_.y, this->size_.x);
+        }
     }
 
     /**
      * Method responsible for updating Vehicle's collision box position.
      */
     void Vehicle::updateColisionBoxPosition() {
+        this->colisionBox_ = this->getColisionBoxAt(this->shape_.getPosition());
+    }
+
+    /**
+     * Method returning collision box of the vehicle standing in given position.
+     * @param position - Position of the vehicle.
+     * @return - Collision box in front of the vehicle.
+     */
+    AABB Vehicle::getColisionBoxAt(sf::Vector2f position) const {
+        AABB colision_box = this->colisionBox_;
+        sf::Vector2f colision_box_size = this->colisionBox_.getSize();
         if (this->direction_ == "South") {
-            this->colisionBox_.setPosition(sf::Vector2f(this->shape_.getPosition().x, this->shape_.getPosition().y + (this->colisionBox_.getSize().y / 2 + this->shape_.getSize().y / 2 + this->roadStripesSize_)));
+            colision_box.moveCenterTo(position.x, position.y + (colision_box_size.y / 2 + this->size_.y / 2 + this->roadStripesSize_));
         }
         else if (this->direction_ == "North") {
-            this->colisionBox_.setPosition(sf::Vector2f(this->shape_.getPosition().x, this->shape_.getPosition().y - (this->colisionBox_.getSize().y / 2 + this->shape_.getSize().y / 2 + this->roadStripesSize_)));
+            colision_box.moveCenterTo(position.x, position.y - (colision_box_size.y / 2 + this->size_.y / 2 + this->roadStripesSize_));
         }
         else if (this->direction_ == "East"){
-            this->colisionBox_.setPosition(sf::Vector2f(this->shape_.getPosition().x + (ceil(this->colisionBox_.getSize().x / 2) + ceil(this->shape_.getSize().x / 2) + this->roadStripesSize_), this->shape_.getPosition().y));
+            colision_box.moveCenterTo(position.x + (ceil(colision_box_size.x / 2) + ceil(this->size_.x / 2) + this->roadStripesSize_), position.y);
         }
         else {
-            this->colisionBox_.setPosition(sf::Vector2f(this->shape_.getPosition().x - (ceil(this->colisionBox_.getSize().x / 2) + ceil(this->shape_.getSize().y / 2) + this->roadStripesSize_), this->shape_.getPosition().y));
+            colision_box.moveCenterTo(position.x - (ceil(colision_box_size.x / 2) + ceil(this->size_.y / 2) + this->roadStripesSize_), position.y);
         }
+        return colision_box;
     }
 
     /**
     *  Method that chcks if car can turn back from the road that it's on
     */
-	bool Vehicle::canTurnBack()
+	bool Vehicle::canTurnBack() const
 	{
-		for (sf::RectangleShape road : this->roads_) {
+		for (const AABB& road : *this->roads_) {
 			if (this->direction_ == "South" && road.getPosition().x == this->currentRoad_->getPosition().x && road.getPosition().y == this->currentRoad_->getPosition().y-this->cellSize_) {
 				return true;
 			}
@@ -99,14 +245,13 @@ namespace zpr {
      */
     void Vehicle::checkOnWhichCell()
     {
-        std::shared_ptr<sf::RectangleShape> temp_cell = nullptr;
-        if (this->roads_.size() != 0) {
+        if (this->roads_->size() != 0) {
             if (!previousRoad_ || this->currentRoad_->getPosition() == this->previousRoad_->getPosition()) {
-                for (sf::RectangleShape road : this->roads_) {
-                    if (road.getGlobalBounds().contains(this->shape_.getPosition())) {
-                        temp_cell = std::make_shared<sf::RectangleShape>(road);
+                sf::Vector2f position = this->shape_.getPosition();
+                for (const AABB& road : *this->roads_) {
+                    if (road.contains(position)) {
                         this->previousRoad_ = this->currentRoad_;
-                        this->currentRoad_ = temp_cell;
+                        this->currentRoad_ = &road;
                     }
                 }
             }
@@ -118,9 +263,9 @@ namespace zpr {
      * @param vehicle - Vehicle we are checking.
      * @return - True if there is a collision, false otherwise.
      */
-    bool Vehicle::checkColision(std::shared_ptr<Vehicle> vehicle){
+    bool Vehicle::checkColision(const std::shared_ptr<Vehicle>& vehicle){
         if (vehicle->getShape().getPosition() != this->getShape().getPosition()) {
-            bool colision = this->colisionBox_.getGlobalBounds().intersects(vehicle->getShape().getGlobalBounds());
+            bool colision = this->colisionBox_.intersects(vehicle->getShape());
             if (colision) {
                 return true;
             }
@@ -136,32 +281,33 @@ namespace zpr {
         if (previousRoad_) {
             if (this->currentRoad_->getPosition() != this->previousRoad_->getPosition())
             {
-                std::shared_ptr<sf::RectangleShape> north = nullptr;
-                std::shared_ptr<sf::RectangleShape> south = nullptr;
-                std::shared_ptr<sf::RectangleShape> east = nullptr;
-                std::shared_ptr<sf::RectangleShape> west = nullptr;
-                std::vector<std::shared_ptr<sf::RectangleShape>> neighbouring_roads;
-                for (sf::RectangleShape road : this->roads_) {
-                    if (road.getGlobalBounds() != this->previousRoad_->getGlobalBounds()) {
-                        if (road.getGlobalBounds().contains(sf::Vector2f(this->currentRoad_->getPosition().x + this->cellSize_, this->currentRoad_->getPosition().y))) {
-                            east = std::make_shared<sf::RectangleShape>(road);
-                            neighbouring_roads.push_back(east);
+                const AABB* north = nullptr;
+                const AABB* south = nullptr;
+                const AABB* east = nullptr;
+                const AABB* west = nullptr;
+                int neighbouring_roads = 0;
+                sf::Vector2f current = this->currentRoad_->getPosition();
+                for (const AABB& road : *this->roads_) {
+                    if (road != *this->previousRoad_) {
+                        if (road.contains(sf::Vector2f(current.x + this->cellSize_, current.y))) {
+                            east = &road;
+                            neighbouring_roads++;
                         }
-                        else if (road.getGlobalBounds().contains(sf::Vector2f(this->currentRoad_->getPosition().x - this->cellSize_, this->currentRoad_->getPosition().y))) {
-                            west = std::make_shared<sf::RectangleShape>(road);
-                            neighbouring_roads.push_back(west);
+                        else if (road.contains(sf::Vector2f(current.x - this->cellSize_, current.y))) {
+                            west = &road;
+                            neighbouring_roads++;
                         }
-                        if (road.getGlobalBounds().contains(sf::Vector2f(this->currentRoad_->getPosition().x , this->currentRoad_->getPosition().y + this->cellSize_))) {
-                            south = std::make_shared<sf::RectangleShape>(road);
-                            neighbouring_roads.push_back(south);
+                        if (road.contains(sf::Vector2f(current.x, current.y + this->cellSize_))) {
+                            south = &road;
+                            neighbouring_roads++;
                         }
-                        else if (road.getGlobalBounds().contains(sf::Vector2f(this->currentRoad_->getPosition().x, this->currentRoad_->getPosition().y - this->cellSize_))) {
-                            north = std::make_shared<sf::RectangleShape>(road);
-                            neighbouring_roads.push_back(north);
+                        else if (road.contains(sf::Vector2f(current.x, current.y - this->cellSize_))) {
+                            north = &road;
+                            neighbouring_roads++;
                         }
                     }
                 }
-                switch (neighbouring_roads.size()) {
+                switch (neighbouring_roads) {
                 case 0: this->turnBack(); break;
                 case 1: this->choseFromOneRoads(north, south, east, west); break;
                 case 2: this->choseFromTwoRoads(north, south, east, west); break;
@@ -192,22 +338,68 @@ namespace zpr {
 		}
 	}
     /**
-    * Method responsible for unblocking vehicle if it stays in one place gor too long
+    * Method responsible for unblocking vehicle if it stays in one place for more than unblockTicks_ ticks
     */
 	void Vehicle::unblockVehicle()
 	{
-		if (this->stopCounter_ > 100 && this->canTurnBack()) {
+		if (this->stopCounter_ > this->unblockTicks_ && this->canTurnBack()) {
 			this->turnBack();
 			this->stopCounter_ = 0;
 		}
 	}
 
+    /**
+     * Method which puts the stopped vehicle to sleep on the wake list of the vehicle which blocks it.
+     * @param blocker - Vehicle which stops this one.
+     * @param wake_tick - Tick in which the vehicle has to be checked again even if the blocker does not move.
+     */
+    void Vehicle::sleepOn(Vehicle& blocker, std::uint64_t wake_tick)
+    {
+        this->stopSleeping();
+        this->blocker_ = &blocker;
+        this->nextSleeper_ = blocker.firstSleeper_;
+        blocker.firstSleeper_ = this;
+        this->wakeTick_ = wake_tick;
+    }
+
+    /**
+     * Method which removes the vehicle from the wake list of its blocker, if it is on one.
+     */
+    void Vehicle::stopSleeping()
+    {
+        if (!this->blocker_) {
+            return;
+        }
+        Vehicle** sleeper = &this->blocker_->firstSleeper_;
+        while (*sleeper != this) {
+            sleeper = &(*sleeper)->nextSleeper_;
+        }
+        *sleeper = this->nextSleeper_;
+        this->blocker_ = nullptr;
+        this->nextSleeper_ = nullptr;
+    }
+
+    /**
+     * Method which wakes every vehicle sleeping on the wake list of this one and empties the list.
+     * @param tick - Current tick, woken vehicles which were not moved in it yet are checked in it.
+     */
+    void Vehicle::wakeSleepers(std::uint64_t tick)
+    {
+        while (this->firstSleeper_) {
+            Vehicle* sleeper = this->firstSleeper_;
+            this->firstSleeper_ = sleeper->nextSleeper_;
+            sleeper->blocker_ = nullptr;
+            sleeper->nextSleeper_ = nullptr;
+            sleeper->wakeTick_ = std::min(sleeper->wakeTick_, tick);
+        }
+    }
+
     /**
      * Method responsible for setting the speed of vehicle if there is no colision.
      */
     void Vehicle::noColision()
     {
-        this->speed_ = 3;
+        this->speed_ = this->maxSpeed_;
     }
 
     /**
@@ -230,12 +422,12 @@ namespace zpr {
     
     /**
      * Method responsible for choosing the road from one road when the car is about to turn.
-     * @param north - RectangleShape object representing road above.
-     * @param south - RectangleShape object representing road under.
-     * @param east - RectangleShape object representing road on the right.
-     * @param west - RectangleShape object representing road on the left.
+     * @param north - Box representing road above.
+     * @param south - Box representing road under.
+     * @param east - Box representing road on the right.
+     * @param west - Box representing road on the left.
      */
-    void Vehicle::choseFromOneRoads(std::shared_ptr<sf::RectangleShape> north, std::shared_ptr<sf::RectangleShape> south, std::shared_ptr<sf::RectangleShape> east, std::shared_ptr<sf::RectangleShape> west)
+    void Vehicle::choseFromOneRoads(const AABB* north, const AABB* south, const AABB* east, const AABB* west)
     {
         if (north) {
             this->updateDirection("North");
@@ -253,17 +445,15 @@ namespace zpr {
 
     /**
      * Method responsible for choosing the road from two roads when the car is about to turn.
-     * @param north - RectangleShape object representing road above.
-     * @param south - RectangleShape object representing road under.
-     * @param east - RectangleShape object representing road on the right.
-     * @param west - RectangleShape object representing road on the left.
+     * @param north - Box representing road above.
+     * @param south - Box representing road under.
+     * @param east - Box representing road on the right.
+     * @param west - Box representing road on the left.
      */
-    void Vehicle::choseFromTwoRoads(std::shared_ptr<sf::RectangleShape> north, std::shared_ptr<sf::RectangleShape> south, std::shared_ptr<sf::RectangleShape> east, std::shared_ptr<sf::RectangleShape> west)
+    void Vehicle::choseFromTwoRoads(const AABB* north, const AABB* south, const AABB* east, const AABB* west)
     {
-        std::random_device rng;
-        std::mt19937 eng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
         std::uniform_int_distribution<> dist(1, 2);
-        int num = dist(eng);
+        int num = dist(this->engine_);
         if (north && south) {
             switch (num)
             {
@@ -310,17 +500,15 @@ namespace zpr {
 
     /**
      * Method responsible for choosing the road from three roads when the car is about to turn.
-     * @param north - RectangleShape object representing road above.
-     * @param south - RectangleShape object representing road under.
-     * @param east - RectangleShape object representing road on the right.
-     * @param west - RectangleShape object representing road on the left.
+     * @param north - Box representing road above.
+     * @param south - Box representing road under.
+     * @param east - Box representing road on the right.
+     * @param west - Box representing road on the left.
      */
-    void Vehicle::choseFromThreeRoads(std::shared_ptr<sf::RectangleShape> north, std::shared_ptr<sf::RectangleShape> south, std::shared_ptr<sf::RectangleShape> east, std::shared_ptr<sf::RectangleShape> west)
+    void Vehicle::choseFromThreeRoads(const AABB* north, const AABB* south, const AABB* east, const AABB* west)
     {
-        std::random_device rng;
-        std::mt19937 eng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
         std::uniform_int_distribution<> dist(1, 3);
-        int num = dist(eng);
+        int num = dist(this->engine_);
         if (north && south && east) {
             switch (num) {
             case 1: this->updateDirection("North"); break;
@@ -355,11 +543,20 @@ namespace zpr {
      * Method responsible for updating the direction of the vehicle.
      * @param direction - Direction of the vehicle.
      */
-    void Vehicle::updateDirection(std::string direction)
+    void Vehicle::updateDirection(const std::string& direction)
     {
         this->direction_ = direction;
     }
 
+    /**
+     * Method returning a copy of what is needed to draw the vehicle now.
+     * @return - Snapshot of the vehicle.
+     */
+    VehicleSnapshot Vehicle::getSnapshot() const
+    {
+        return VehicleSnapshot(this->shape_.getPosition(), this->size_, this->rotation_, this->color_);
+    }
+
     /**
      * Method responsible for drawing the vehicle.
      * @param target - Object where to draw the vehicle.
@@ -367,7 +564,6 @@ namespace zpr {
      */
     void Vehicle::draw(sf::RenderTarget& target, sf::RenderStates states) const
     {
-        target.draw(this->shape_, states);
-        //target.draw(this->colisionBox_, states);
+        target.draw(this->getSnapshot(), states);
     }
 }
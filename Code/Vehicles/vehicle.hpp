@@ -7,47 +7,75 @@
 #include "SFML/Graphics.hpp"
 #include "../definitions.hpp"
 #include "../components/cell.hpp"
+#include "../components/aabb.hpp"
+#include "vehicle_snapshot.hpp"
 #include <chrono>
+#include <cstdint>
+#include <random>
 
 
 namespace zpr {
 
     /**
      * Class responsible for handling vehicles actions eg. moving, stopping, checking collisions. It is base class for Car and Truck.
+     * Simulation works only on AABB boxes, sf::RectangleShape of the vehicle is created when it is drawn.
+     * Vehicles do not own roads and can be reused with reset(), so moving them never allocates memory.
      */
 
 	class Vehicle : public sf::Drawable
 	{
 	public:
 		virtual ~Vehicle() {};
-		sf::RectangleShape getShape();
+		void reset(int x, int y, const std::string& direction, unsigned seed);
+		virtual bool isTruck() const;
+		const AABB& getShape() const;
 		void move();
+		bool isInLane() const;
+		sf::Vector2f getStep() const;
+		int getCellExitDistance() const;
+		AABB getColisionBoxAt(sf::Vector2f position) const;
 		void checkOnWhichCell();
 		void checkTurn();
 		void stopVehicle();
 		void checkVehicleStopped();
 		void unblockVehicle();
 		void noColision();
-		bool checkColision(std::shared_ptr<Vehicle> vehicle);
+		bool checkColision(const std::shared_ptr<Vehicle>& vehicle);
+		bool canTurnBack() const;
+		void sleepOn(Vehicle& blocker, std::uint64_t wake_tick);
+		void stopSleeping();
+		void wakeSleepers(std::uint64_t tick);
+		VehicleSnapshot getSnapshot() const;
 		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
-		int x_, y_, speed_;
+		int x_, y_, speed_, maxSpeed_;
 		int roadSize_, sidewalkSize_, roadStripesSize_;
 		int cellSize_;
-		int stopCounter_;
+		std::uint32_t handle_;
+		int stopCounter_, unblockTicks_;
+		float velocity_, travelled_;
+		std::uint64_t spawnTick_, wakeTick_, straightUntilTick_;
 		bool seenByCamera_[3];
-		std::vector<sf::RectangleShape> roads_;
+		float rotation_;
+		sf::Vector2f size_;
+		sf::Color color_;
+		const std::vector<AABB>* roads_;
 		std::string direction_, previousDirection_;
-		sf::RectangleShape shape_, colisionBox_;
-		std::shared_ptr<sf::RectangleShape> currentRoad_, previousRoad_;
+		AABB shape_, colisionBox_;
+		const AABB* currentRoad_;
+		const AABB* previousRoad_;
+		Vehicle* blocker_;
+		Vehicle* firstSleeper_;
+		Vehicle* nextSleeper_;
+		std::minstd_rand engine_;
 
 	private:
+		int getLanePosition() const;
 		void updatePosition();
 		void updateColisionBoxPosition();
-		bool canTurnBack();
 		void turnBack();
-		void choseFromOneRoads(std::shared_ptr<sf::RectangleShape> north, std::shared_ptr<sf::RectangleShape> south, std::shared_ptr<sf::RectangleShape> east, std::shared_ptr<sf::RectangleShape> west);
-		void choseFromTwoRoads(std::shared_ptr<sf::RectangleShape> north, std::shared_ptr<sf::RectangleShape> south, std::shared_ptr<sf::RectangleShape> east, std::shared_ptr<sf::RectangleShape> west);
-		void choseFromThreeRoads(std::shared_ptr<sf::RectangleShape> north, std::shared_ptr<sf::RectangleShape> south, std::shared_ptr<sf::RectangleShape> east, std::shared_ptr<sf::RectangleShape> west);
-		void updateDirection(std::string direction);
+		void choseFromOneRoads(const AABB* north, const AABB* south, const AABB* east, const AABB* west);
+		void choseFromTwoRoads(const AABB* north, const AABB* south, const AABB* east, const AABB* west);
+		void choseFromThreeRoads(const AABB* north, const AABB* south, const AABB* east, const AABB* west);
+		void updateDirection(const std::string& direction);
 	};
 }
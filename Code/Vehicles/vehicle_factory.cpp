@@ -9,7 +9,7 @@ namespace zpr {
     /**
      * Method responsible for creating Car objects.
      */
-    std::shared_ptr<Vehicle> zpr::VehicleFactory::createCar(int x, int y, int cell_size, std::vector<sf::RectangleShape> roads, std::string direction)
+    std::shared_ptr<Vehicle> zpr::VehicleFactory::createCar(int x, int y, int cell_size, const std::vector<AABB>& roads, const std::string& direction)
     {
         return std::shared_ptr<Vehicle>(new Car(x, y, cell_size, roads, direction));
     }
@@ -17,7 +17,7 @@ namespace zpr {
     /**
      * Method responsible for creating Truck objects.
      */
-    std::shared_ptr<Vehicle> VehicleFactory::createTruck(int x, int y, int cell_size, std::vector<sf::RectangleShape> roads, std::string direction)
+    std::shared_ptr<Vehicle> VehicleFactory::createTruck(int x, int y, int cell_size, const std::vector<AABB>& roads, const std::string& direction)
     {
         return std::shared_ptr<Vehicle>(new Truck(x, y, cell_size, roads, direction));
     }
@@ -15,8 +15,8 @@ namespace zpr {
 	class VehicleFactory
 	{
 	public:
-		static std::shared_ptr<Vehicle> createCar(int x, int y, int cell_size, std::vector<sf::RectangleShape> roads, std::string direction);
-		static std::shared_ptr<Vehicle> createTruck(int x, int y, int cell_size, std::vector<sf::RectangleShape> roads, std::string direction);
+		static std::shared_ptr<Vehicle> createCar(int x, int y, int cell_size, const std::vector<AABB>& roads, const std::string& direction);
+		static std::shared_ptr<Vehicle> createTruck(int x, int y, int cell_size, const std::vector<AABB>& roads, const std::string& direction);
 	};
 }
 
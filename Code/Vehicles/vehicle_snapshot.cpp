@@ -0,0 +1,39 @@
+/**
+ * vehicle_snapshot.cpp
+ * Implementation of VehicleSnapshot class.
+ */
+
+#include "vehicle_snapshot.hpp"
+
+namespace zpr {
+
+    /**
+     * Default constructor of VehicleSnapshot class.
+     */
+    VehicleSnapshot::VehicleSnapshot() : rotation_(0) {}
+
+    /**
+     * Parametrized constructor of VehicleSnapshot class.
+     * @param position - Position of the center of the vehicle.
+     * @param size - Size of the vehicle.
+     * @param rotation - Rotation of the vehicle in degrees.
+     * @param color - Color of the vehicle.
+     */
+    VehicleSnapshot::VehicleSnapshot(sf::Vector2f position, sf::Vector2f size, float rotation, sf::Color color)
+        : position_(position), size_(size), rotation_(rotation), color_(color) {}
+
+    /**
+     * Method responsible for drawing the vehicle as it was when the snapshot was taken.
+     * @param target - Object where to draw the vehicle.
+     * @param states - sf::RenderStates object.
+     */
+    void VehicleSnapshot::draw(sf::RenderTarget& target, sf::RenderStates states) const
+    {
+        sf::RectangleShape shape(this->size_);
+        shape.setFillColor(this->color_);
+        shape.setOrigin(this->size_.x / 2, this->size_.y / 2);
+        shape.setRotation(this->rotation_);
+        shape.setPosition(this->position_);
+        target.draw(shape, states);
+    }
+}
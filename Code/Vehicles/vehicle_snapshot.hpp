@@ -0,0 +1,24 @@
+/**
+ * vehicle_snapshot.hpp
+ * Header of VehicleSnapshot class.
+ */
+
+#pragma once
+#include "SFML/Graphics.hpp"
+
+namespace zpr {
+
+    /**
+     * Class keeping what is needed to draw a vehicle at one moment: its position, size, rotation and color, which
+     * tells a car from a truck. It is a copy, so it can be drawn while the vehicle itself moves on.
+     */
+    class VehicleSnapshot : public sf::Drawable {
+    public:
+        VehicleSnapshot();
+        VehicleSnapshot(sf::Vector2f position, sf::Vector2f size, float rotation, sf::Color color);
+        virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+        sf::Vector2f position_, size_;
+        float rotation_;
+        sf::Color color_;
+    };
+}
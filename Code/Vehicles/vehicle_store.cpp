@@ -0,0 +1,161 @@
+/**
+ * vehicle_store.cpp
+ * Implementation of VehicleStore class.
+ */
+
+#include "vehicle_store.hpp"
+#include <utility>
+
+namespace zpr {
+
+    /**
+     * Parametrized constructor of VehicleStore class. It creates every car and every truck at once, cars get handles
+     * from 0 and trucks the ones after them.
+     * @param cars_count - Number of cars.
+     * @param trucks_count - Number of trucks.
+     * @param cell_size - Size of a cell in world units.
+     * @param roads - Vector of available roads (not copied, it has to outlive the vehicles).
+     */
+    VehicleStore::VehicleStore(std::size_t cars_count, std::size_t trucks_count, int cell_size, const std::vector<AABB>& roads)
+    {
+        this->cars_.reserve(cars_count);
+        this->trucks_.reserve(trucks_count);
+        this->slots_.reserve(cars_count + trucks_count);
+        for (std::size_t i = 0; i < cars_count; i++) {
+            this->cars_.emplace_back(0, 0, cell_size, roads, "East");
+            this->cars_.back().handle_ = this->slots_.size();
+            this->slots_.push_back(i);
+        }
+        for (std::size_t i = 0; i < trucks_count; i++) {
+            this->trucks_.emplace_back(0, 0, cell_size, roads, "East");
+            this->trucks_.back().handle_ = this->slots_.size();
+            this->slots_.push_back(i);
+        }
+        this->carTargets_.resize(cars_count);
+        this->truckTargets_.resize(trucks_count);
+    }
+
+    /**
+     * Method creating a store, it has to be owned by a shared pointer to give out vehicles.
+     * @param cars_count - Number of cars.
+     * @param trucks_count - Number of trucks.
+     * @param cell_size - Size of a cell in world units.
+     * @param roads - Vector of available roads (not copied, it has to outlive the vehicles).
+     * @return - Created store.
+     */
+    std::shared_ptr<VehicleStore> VehicleStore::create(std::size_t cars_count, std::size_t trucks_count, int cell_size, const std::vector<AABB>& roads)
+    {
+        return std::make_shared<VehicleStore>(cars_count, trucks_count, cell_size, roads);
+    }
+
+    /**
+     * Method putting every car and every truck of the store to the pools, in order of slots.
+     * @param cars_pool - Pool of cars.
+     * @param trucks_pool - Pool of trucks.
+     */
+    void VehicleStore::fillPools(std::vector<std::shared_ptr<Vehicle>>& cars_pool, std::vector<std::shared_ptr<Vehicle>>& trucks_pool)
+    {
+        for (std::size_t i = 0; i < this->cars_.size(); i++) {
+            cars_pool.push_back(this->getSlot(false, i));
+        }
+        for (std::size_t i = 0; i < this->trucks_.size(); i++) {
+            trucks_pool.push_back(this->getSlot(true, i));
+        }
+    }
+
+    /**
+     * Method moving vehicles between slots, so cars and trucks lie in the order in which they are in the vectors:
+     * vehicles first, then the pools. Pointers in the vectors are changed to the new slots of their vehicles, other
+     * pointers to vehicles point to other vehicles afterwards. Vehicles must not be on wake lists of each other.
+     * It does not allocate memory.
+     * @param vehicles - Vehicles on the map, in the order in which they should lie.
+     * @param cars_pool - Pool of cars.
+     * @param trucks_pool - Pool of trucks.
+     * @return - False if the vectors do not hold every vehicle of the store, then nothing is moved.
+     */
+    bool VehicleStore::reorder(std::vector<std::shared_ptr<Vehicle>>& vehicles, std::vector<std::shared_ptr<Vehicle>>& cars_pool, std::vector<std::shared_ptr<Vehicle>>& trucks_pool)
+    {
+        if (vehicles.size() + cars_pool.size() + trucks_pool.size() != this->getVehiclesCount()) {
+            return false;
+        }
+        std::size_t next_car = 0;
+        std::size_t next_truck = 0;
+        for (std::vector<std::shared_ptr<Vehicle>>* list : {&vehicles, &cars_pool, &trucks_pool}) {
+            for (const std::shared_ptr<Vehicle>& vehicle : *list) {
+                std::size_t slot = this->slots_[vehicle->handle_];
+                if (vehicle->isTruck()) {
+                    this->truckTargets_[slot] = next_truck++;
+                }
+                else {
+                    this->carTargets_[slot] = next_car++;
+                }
+            }
+        }
+        if (next_car != this->cars_.size()) {
+            return false;
+        }
+        this->permute(this->cars_, this->carTargets_);
+        this->permute(this->trucks_, this->truckTargets_);
+        next_car = 0;
+        next_truck = 0;
+        for (std::vector<std::shared_ptr<Vehicle>>* list : {&vehicles, &cars_pool, &trucks_pool}) {
+            for (std::shared_ptr<Vehicle>& vehicle : *list) {
+                bool is_truck = vehicle->isTruck();
+                vehicle = this->getSlot(is_truck, is_truck ? next_truck++ : next_car++);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Method returning a vehicle by its handle, wherever it lies.
+     * @param handle - Handle of the vehicle.
+     * @return - Pointer to the vehicle.
+     */
+    std::shared_ptr<Vehicle> VehicleStore::getVehicle(std::uint32_t handle)
+    {
+        return this->getSlot(handle >= this->cars_.size(), this->slots_[handle]);
+    }
+
+    /**
+     * Method returning number of all vehicles in the store.
+     * @return - Number of cars and trucks.
+     */
+    std::size_t VehicleStore::getVehiclesCount() const
+    {
+        return this->slots_.size();
+    }
+
+    /**
+     * Method returning a pointer to a slot, it shares ownership of the store.
+     * @param is_truck - True for a slot of trucks.
+     * @param slot - Index of the slot.
+     * @return - Pointer to the vehicle in the slot.
+     */
+    std::shared_ptr<Vehicle> VehicleStore::getSlot(bool is_truck, std::size_t slot)
+    {
+        Vehicle* vehicle = is_truck ? static_cast<Vehicle*>(&this->trucks_[slot]) : static_cast<Vehicle*>(&this->cars_[slot]);
+        return std::shared_ptr<Vehicle>(this->shared_from_this(), vehicle);
+    }
+
+    /**
+     * Method moving vehicles to their target slots by swapping them along cycles of the permutation, and updating
+     * slots of their handles.
+     * @param vehicles - Cars or trucks.
+     * @param targets - Target slot of the vehicle in each slot, it is left as identity.
+     */
+    template <typename T>
+    void VehicleStore::permute(std::vector<T>& vehicles, std::vector<std::size_t>& targets)
+    {
+        for (std::size_t i = 0; i < vehicles.size(); i++) {
+            while (targets[i] != i) {
+                std::size_t target = targets[i];
+                std::swap(vehicles[i], vehicles[target]);
+                std::swap(targets[i], targets[target]);
+            }
+        }
+        for (std::size_t i = 0; i < vehicles.size(); i++) {
+            this->slots_[vehicles[i].handle_] = i;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * vehicle_store.hpp
+ * Header of VehicleStore class.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "car.hpp"
+#include "truck.hpp"
+
+namespace zpr {
+
+    /**
+     * Class keeping all cars and all trucks of the simulation in two contiguous arrays, so vehicles moved one after
+     * another lie one after another in memory. Vehicles are given out as shared pointers to the slots, which keep
+     * the store alive. reorder() moves vehicles between slots, so pointers to vehicles are only valid until it is
+     * called; every vehicle has a handle (Vehicle::handle_) which stays the same and getVehicle() finds its slot.
+     */
+    class VehicleStore : public std::enable_shared_from_this<VehicleStore> {
+    public:
+        VehicleStore(std::size_t cars_count, std::size_t trucks_count, int cell_size, const std::vector<AABB>& roads);
+        static std::shared_ptr<VehicleStore> create(std::size_t cars_count, std::size_t trucks_count, int cell_size, const std::vector<AABB>& roads);
+        void fillPools(std::vector<std::shared_ptr<Vehicle>>& cars_pool, std::vector<std::shared_ptr<Vehicle>>& trucks_pool);
+        bool reorder(std::vector<std::shared_ptr<Vehicle>>& vehicles, std::vector<std::shared_ptr<Vehicle>>& cars_pool, std::vector<std::shared_ptr<Vehicle>>& trucks_pool);
+        std::shared_ptr<Vehicle> getVehicle(std::uint32_t handle);
+        std::size_t getVehiclesCount() const;
+    private:
+        std::shared_ptr<Vehicle> getSlot(bool is_truck, std::size_t slot);
+        template <typename T>
+        void permute(std::vector<T>& vehicles, std::vector<std::size_t>& targets);
+        std::vector<Car> cars_;
+        std::vector<Truck> trucks_;
+        std::vector<std::size_t> slots_, carTargets_, truckTargets_;
+    };
+}
@@ -5,6 +5,8 @@
 
 #include "cameras_view.hpp"
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 
 namespace zpr {
 
@@ -12,7 +14,7 @@ namespace zpr {
      * Parametrized constructor of CamerasView class.
      * @param data - Struct containing data of current application. (eg. window, assets).
      */
-    CamerasView::CamerasView(SimulatorDataRef data) : data_(data), isSimulating_(false), isAddingCamera_(false)
+    CamerasView::CamerasView(SimulatorDataRef data) : data_(data), isShowingProfiler_(false), isSimulating_(false), isAddingCamera_(false)
     {
         this->camerasView_ = sf::View(sf::FloatRect(0.f, 0.f, (float)((SCREEN_WIDTH - SCREEN_HEIGHT) / 2), (float)(SCREEN_HEIGHT)));
         this->camerasView_.setViewport(this->viewportCalculator_.calculateCamerasViewport());
@@ -43,6 +45,12 @@ namespace zpr {
         this->camerasLabels_.push_back(this->createLabel("Trucks passed: 0", 380));
         this->camerasLabels_.push_back(this->createLabel("Trucks passed: 0", 610));
         this->startSimulationLabel_ = this->createLabel("", 815);
+        this->speedUpLabel_ = this->createLabel("", 760);
+        this->profilerLabel_ = this->createLabel("", 20);
+        this->profilerLabel_.setCharacterSize(16);
+        this->profilerLabel_.setPosition(20, 20);
+        this->profilerBackground_.setSize(this->camerasView_.getSize());
+        this->profilerBackground_.setFillColor(sf::Color(0, 0, 0, 200));
 
     }
 
@@ -116,6 +124,85 @@ namespace zpr {
         this->data_->window_.draw(this->background_);
         this->drawButtons();
         this->drawLabels();
+        if (this->isShowingProfiler_) {
+            this->drawProfilerOverlay();
+        }
+    }
+
+    /**
+     * Method which shows or hides profiler overlay. It does nothing when profiling is compiled out.
+     */
+    void CamerasView::toggleProfilerOverlay()
+    {
+        this->isShowingProfiler_ = Profiler::isEnabled() && !this->isShowingProfiler_;
+        this->profilerRefreshClock_.restart();
+        this->profilerLabel_.setString("Collecting samples...");
+    }
+
+    /**
+     * Method which enables or disables hardware counters of profiled phases while the profiler overlay is shown.
+     */
+    void CamerasView::toggleProfilerCounters()
+    {
+        if (this->isShowingProfiler_) {
+            Profiler::instance().setCountersEnabled(!Profiler::instance().isCountersEnabled());
+        }
+    }
+
+    /**
+     * Method writing mean hardware counters of every phase (instructions per cycle, LLC misses and branch misses
+     * per sample) below timings of the profiler overlay.
+     * @param text - Text of the overlay.
+     */
+    void CamerasView::writeCountersTable(std::ostringstream& text)
+    {
+        if (!Profiler::instance().isCountersEnabled()) {
+            text << "\nF4: hardware counters";
+            return;
+        }
+        if (!PerfCounters::forThisThread().isAvailable()) {
+            text << "\nHardware counters unavailable";
+            return;
+        }
+        text << "\nPhase                IPC   LLC miss   br miss\n";
+        for (int i = 0; i < static_cast<int>(ProfilerPhase::Count); i++) {
+            ProfilerPhase phase = static_cast<ProfilerPhase>(i);
+            PhaseStats stats = Profiler::instance().getStats(phase);
+            if (phase == ProfilerPhase::Draw) {
+                text << "\n";
+            }
+            double cycles = stats.counters_[static_cast<int>(PerfCounter::Cycles)];
+            double ipc = cycles > 0 ? stats.counters_[static_cast<int>(PerfCounter::Instructions)] / cycles : 0;
+            text << std::left << std::setw(18) << Profiler::getPhaseName(phase) << std::right << std::setprecision(2)
+                 << std::setw(7) << ipc << std::setprecision(0)
+                 << std::setw(11) << stats.counters_[static_cast<int>(PerfCounter::LlcMisses)]
+                 << std::setw(10) << stats.counters_[static_cast<int>(PerfCounter::BranchMisses)] << "\n";
+        }
+    }
+
+    /**
+     * Method which draws p50 and p99 of every profiled phase over the view. Text is refreshed twice per second.
+     */
+    void CamerasView::drawProfilerOverlay()
+    {
+        if (this->profilerRefreshClock_.getElapsedTime().asMilliseconds() > 500) {
+            this->profilerRefreshClock_.restart();
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(1) << "Phase              p50 [us]   p99 [us]\n";
+            for (int i = 0; i < static_cast<int>(ProfilerPhase::Count); i++) {
+                ProfilerPhase phase = static_cast<ProfilerPhase>(i);
+                PhaseStats stats = Profiler::instance().getStats(phase);
+                if (phase == ProfilerPhase::Draw) {
+                    text << "\n";
+                }
+                text << std::left << std::setw(18) << Profiler::getPhaseName(phase) << std::right
+                     << std::setw(10) << stats.p50_ << std::setw(11) << stats.p99_ << "\n";
+            }
+            this->writeCountersTable(text);
+            this->profilerLabel_.setString(text.str());
+        }
+        this->data_->window_.draw(this->profilerBackground_);
+        this->data_->window_.draw(this->profilerLabel_);
     }
 
     /**
@@ -148,6 +235,7 @@ namespace zpr {
             this->data_->window_.draw(camerasLabels_.at(i));
             this->data_->window_.draw(startSimulationLabel_);
         }
+        this->data_->window_.draw(speedUpLabel_);
     }
 
     /**
@@ -156,10 +244,11 @@ namespace zpr {
      */
     bool CamerasView::startingRoadConnected()
     {
-        if (this->cells_.at(sqrt(this->cells_.size())*STARTING_CELL_COL).containsRoad_)
-            return true;
-        else
-            return false;
+        for (Cell& cell : this->cells_) {
+            if (cell.getPosition() == sf::Vector2i(STARTING_CELL_COL, STARTING_CELL_ROW) && cell.containsRoad_)
+                return true;
+        }
+        return false;
     }
 
     /**
@@ -192,6 +281,17 @@ namespace zpr {
         this->camerasLabels_.at(which_label+5).setString("Trucks passed: "+std::to_string(numberOfTrucks_[which_label-1]));
     }
 
+    /**
+     * Method responsible for updating label with speed-up of the simulation: the chosen one and the one reached.
+     * @param time_scale - Chosen speed-up, 0 for as fast as possible.
+     * @param speed_up - Simulated time divided by real time.
+     */
+    void CamerasView::updateSpeedUp(int time_scale, float speed_up){
+        std::ostringstream text;
+        text << "Speed: " << (time_scale == 0 ? "max" : std::to_string(time_scale) + "x") << " (" << std::fixed << std::setprecision(1) << speed_up << "x)";
+        this->speedUpLabel_.setString(text.str());
+    }
+
     /**
      * Method responsible for updating this view when simulation is taking place.
      * @param is_simulating - True when simulation starts, false when it ends.
@@ -199,6 +299,7 @@ namespace zpr {
     void CamerasView::updateIsSimulating(bool is_simulating){
         if(!is_simulating){
             this->initializeVehiclesCounters();
+            this->speedUpLabel_.setString("");
         }
     }
     
@@ -231,7 +332,7 @@ namespace zpr {
 
     /**
      * Method responsible for update vector of cells for this view.
-     * @param cells - Vector of new cells.
+     * @param cells - Vector of new (not empty) cells.
      */
     void CamerasView::updateCells(std::vector<Cell> cells)
     {
@@ -12,6 +12,8 @@
 #include "../helpers/viewport_calculator.hpp"
 #include "../vehicles/vehicle.hpp"
 #include "../components/cell.hpp"
+#include "../profiling/profiler.hpp"
+#include <sstream>
 
 namespace zpr{
 
@@ -32,7 +34,12 @@ namespace zpr{
         void updateCells(std::vector<Cell> cells);
         void updateCarsLabel(int which_label);
         void updateTrucksLabel(int which_label);
+        void updateSpeedUp(int time_scale, float speed_up);
+        void toggleProfilerOverlay();
+        void toggleProfilerCounters();
 	private:
+        void drawProfilerOverlay();
+        void writeCountersTable(std::ostringstream& text);
         void initializeVehiclesCounters();
         void addButtons();
         sf::Text createLabel(std::string text, int y_position);
@@ -48,6 +55,11 @@ namespace zpr{
         std::vector<Cell> cells_;
         std::vector<sf::Text> camerasLabels_;
         sf::Text startSimulationLabel_;
+        sf::Text speedUpLabel_;
+        sf::Text profilerLabel_;
+        sf::RectangleShape profilerBackground_;
+        sf::Clock profilerRefreshClock_;
+        bool isShowingProfiler_;
         bool isSimulating_, isAddingCamera_;
         std::vector<bool> camerasOn_;
         int numberOfCars_[3], numberOfTrucks_[3];
@@ -4,9 +4,11 @@
  */
 
 #include "map_view.hpp"
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include "../states/save_state.hpp"
+#include "../profiling/profiler.hpp"
 
 namespace zpr {
 
@@ -34,22 +36,23 @@ namespace zpr {
      */
 	void MapView::init() {
         this->drawingHelper_ = std::make_unique<DrawingHelper>(this->data_);
-        this->converter_ = std::make_unique<Converter>(this->gridSize_);
+        this->converter_ = std::make_unique<Converter>(this->gridSize_, WORLD_CELL_SIZE);
         this->addingRectangleShapesHelper_ = std::make_unique<AddingHelper>(this->data_, this->gridSize_);
         this->deletingRectangleShapesHelper_ = std::make_unique<DeletingHelper>(this->data_, this->gridSize_);
         this->clicked_ = false;
         this->loadAssets();
-		this->backgroundTexture_.setTexture(this->data_->assets_.getTexture("Background"));
-		this->backgroundTexture_.setOrigin(sf::Vector2f(800, 800));
-		this->backgroundTexture_.setPosition(this->mapView_.getCenter());
-		this->cellSize_ = (SCREEN_HEIGHT / this->gridSize_);
+		this->cellSize_ = this->converter_->getCellSize();
 		this->row_ = -1;
 		this->col_ = -1;
         this->enterGridWidth_ = this->gridSize_;
         this->enterGridHeight_ = 2;
-		this->mapView_ = sf::View(sf::FloatRect(0.f, 0.f, (float)(SCREEN_HEIGHT), (float)(SCREEN_HEIGHT)));
+        float world_size = (float)(this->gridSize_ * this->cellSize_);
+		this->mapView_ = sf::View(sf::FloatRect(0.f, 0.f, world_size, world_size));
 		this->mapView_.setViewport(this->viewportCalculator_.calculateMapViewport());
-		this->generateGridLines();
+		this->backgroundTexture_.setTexture(this->data_->assets_.getTexture("Background"));
+		this->backgroundTexture_.setOrigin(sf::Vector2f(800, 800));
+		this->backgroundTexture_.setPosition(this->mapView_.getCenter());
+        this->backgroundTexture_.setScale(world_size / SCREEN_HEIGHT, world_size / SCREEN_HEIGHT);
         this->mapView_.zoom(1.4f);
         this->initializeCameras();
         
@@ -113,15 +116,10 @@ namespace zpr {
      */
 	void MapView::loadAssets()
 	{
-		this->data_->assets_.loadTexture("Selected Cell", SELECTED_CELL_TEXTURE);
-		this->data_->assets_.loadTexture("Background", BACKGROUND_TEXTURE_FILEPATH);
-		this->data_->assets_.loadTexture("Road", STREET_TEXTURE);
-		this->data_->assets_.loadTexture("Turn", TURN_TEXTURE);
-		this->data_->assets_.loadTexture("T_Intersection", T_INTERSECTION_TEXTURE);
-		this->data_->assets_.loadTexture("Intersection", INTERSECTION_TEXTURE);
-		this->data_->assets_.loadTexture("Crossing", CROSSING_TEXTURE);
-        this->data_->assets_.loadTexture("Entry", ENTRY_TEXTURE);
-        this->data_->assets_.loadTexture("Camera", CAMERA_TEXTURE);
+		this->data_->assets_.loadTextures({{"Selected Cell", SELECTED_CELL_TEXTURE}, {"Background", BACKGROUND_TEXTURE_FILEPATH},
+			{"Road", STREET_TEXTURE}, {"Turn", TURN_TEXTURE}, {"T_Intersection", T_INTERSECTION_TEXTURE},
+			{"Intersection", INTERSECTION_TEXTURE}, {"Crossing", CROSSING_TEXTURE}, {"Entry", ENTRY_TEXTURE},
+			{"Camera", CAMERA_TEXTURE}});
 	}
 
     /**
@@ -129,22 +127,40 @@ namespace zpr {
      */
 	void MapView::setupSelectedCellRect()
 	{
-		this->selectedCellRect_.setSize(sf::Vector2f(SCREEN_HEIGHT / this->gridSize_, SCREEN_HEIGHT / this->gridSize_));
+		this->selectedCellRect_.setSize(sf::Vector2f(this->cellSize_, this->cellSize_));
 		this->selectedCellRect_.setTexture(&this->data_->assets_.getTexture("Selected Cell"));
 	}
     
     /**
-     * Method responsible for generating grid lines representing map.
+     * Method responsible for generating grid lines representing map, only for rows and columns in the visible area.
+     * Lines are kept GRID_LINE_PIXELS pixels thick on the screen and are not generated when cells are too small to
+     * be seen apart.
      */
 	void MapView::generateGridLines() {
-		int draw_prefix = this->converter_->calculatePrefix();
-		for (int i = 0; i <= gridSize_; i++)
+        this->gridLines_.clear();
+        float world_per_pixel = this->mapView_.getSize().y / (this->mapView_.getViewport().height * SCREEN_HEIGHT);
+        if (this->cellSize_ < GRID_MIN_CELL_PIXELS * world_per_pixel) {
+            return;
+        }
+        AABB area = this->getVisibleArea();
+        int first_col = std::max(0, this->converter_->transformPixelsToRowCol(area.left_));
+        int last_col = std::min(this->gridSize_, this->converter_->transformPixelsToRowCol(area.right_) + 1);
+        int first_row = std::max(0, this->converter_->transformPixelsToRowCol(area.top_));
+        int last_row = std::min(this->gridSize_, this->converter_->transformPixelsToRowCol(area.bottom_) + 1);
+        if (first_col > last_col || first_row > last_row) {
+            return;
+        }
+        float thickness = GRID_LINE_PIXELS * world_per_pixel;
+		for (int i = first_col; i <= last_col; i++)
 		{
-			sf::RectangleShape vertical_line(sf::Vector2f(2, (gridSize_)*this->cellSize_));
-			vertical_line.setPosition(sf::Vector2f(i * this->cellSize_ + draw_prefix, draw_prefix));
-			sf::RectangleShape horizontal_line(sf::Vector2f((gridSize_)*this->cellSize_, 2));
-			horizontal_line.setPosition(sf::Vector2f(draw_prefix, i * this->cellSize_ + draw_prefix));
+			sf::RectangleShape vertical_line(sf::Vector2f(thickness, (last_row - first_row) * this->cellSize_));
+			vertical_line.setPosition(sf::Vector2f(i * this->cellSize_, first_row * this->cellSize_));
 			this->gridLines_.push_back(vertical_line);
+		}
+		for (int i = first_row; i <= last_row; i++)
+		{
+			sf::RectangleShape horizontal_line(sf::Vector2f((last_col - first_col) * this->cellSize_, thickness));
+			horizontal_line.setPosition(sf::Vector2f(first_col * this->cellSize_, i * this->cellSize_));
 			this->gridLines_.push_back(horizontal_line);
 		}
 	}
@@ -204,13 +220,33 @@ namespace zpr {
      */
 	void MapView::draw()
 	{
+        ZPR_PROFILE_FRAME(Draw, DrawVehicles);
 		this->data_->window_.setView(this->mapView_);
-		this->data_->window_.draw(this->backgroundTexture_);
-		this->fillCells();
-        this->drawingHelper_->drawRoads(this->roads_);
-        this->drawingHelper_->drawGrid(this->isSimulating_, gridLines_);
-        this->drawingHelper_->drawCameras(this->cameras_);
-        this->drawingHelper_->drawVehicles(this->vehicles_);
+        {
+            ZPR_PROFILE_SCOPE(DrawBackground);
+            this->data_->window_.draw(this->backgroundTexture_);
+        }
+        {
+            ZPR_PROFILE_SCOPE(DrawCells);
+            this->fillCells();
+        }
+        {
+            ZPR_PROFILE_SCOPE(DrawRoads);
+            this->drawingHelper_->drawRoads(this->roads_);
+        }
+        {
+            ZPR_PROFILE_SCOPE(DrawGrid);
+            if (!this->isSimulating_) {
+                this->generateGridLines();
+            }
+            this->drawingHelper_->drawGrid(this->isSimulating_, this->gridLines_);
+        }
+        {
+            ZPR_PROFILE_SCOPE(DrawCameras);
+            this->drawingHelper_->drawCameras(this->cameras_);
+        }
+        ZPR_PROFILE_SCOPE(DrawVehicles);
+        this->drawingHelper_->drawVehicles(this->vehicles_.read());
 	}
     
     
@@ -227,18 +263,19 @@ namespace zpr {
     }
 
     /**
-     * Method which handles moving view with keys.
+     * Method which handles moving view with keys, by the same part of the map regardless of grid size.
      * @param key - Which key was clicked.
      */
     void MapView::move(keysEnum key){
+        float step = 90.f * this->gridSize_ * this->cellSize_ / SCREEN_HEIGHT;
         switch (key){
-        case LEFT: this->mapView_.move(-90.f, 0);
+        case LEFT: this->mapView_.move(-step, 0);
             break;
-        case RIGHT: this->mapView_.move(90.f, 0);
+        case RIGHT: this->mapView_.move(step, 0);
             break;
-        case UP: this->mapView_.move(0, -90.f);
+        case UP: this->mapView_.move(0, -step);
             break;
-        case DOWN: this->mapView_.move(0, 90.f);
+        case DOWN: this->mapView_.move(0, step);
             break;
         }
     }
@@ -340,17 +377,13 @@ namespace zpr {
     }
 
     /**
-     * Method responsible for updating vector of vehicles that are on the map.
+     * Method responsible for updating vehicles that are on the map. It is called by the simulation thread, so
+     * vehicles are copied to the snapshot buffer and only these copies are drawn.
      * @param vehicles - Vector of the vehicles.
      */
-	void MapView::updateVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles)
+	void MapView::updateVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles)
 	{
-        if(vehicles.size()==0){
-            this->vehicles_.clear();
-        }
-        else{
-            this->vehicles_ = vehicles;
-        }
+        this->vehicles_.write(vehicles);
 	}
 
     /**
@@ -382,6 +415,17 @@ namespace zpr {
 		return this->mapView_;
 	}
 
+    /**
+     * Method returning part of the city visible in the view.
+     * @return - Visible area in world units.
+     */
+    AABB MapView::getVisibleArea() const
+    {
+        sf::Vector2f size = this->mapView_.getSize();
+        sf::Vector2f corner = this->mapView_.getCenter() - size / 2.f;
+        return AABB(corner.x, corner.y, corner.x + size.x, corner.y + size.y);
+    }
+
     /**
      * Overloaded << operator, which is responsible for printing mapView object.
      * @param os - Ofstream object.
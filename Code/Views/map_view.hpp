@@ -19,11 +19,13 @@
 #include "../helpers/adding_elements_map_view_helper.hpp"
 #include "../helpers/deleting_elements_helper.hpp"
 #include "../helpers/viewport_calculator.hpp"
+#include "../components/snapshot_buffer.hpp"
 
 
 namespace zpr {
     /**
      * Class responsible for drawing map, grids, vehicles, cameras and handling events in map.
+     * Every layer is drawn in world units (WORLD_CELL_SIZE per cell), the view maps them onto pixels of the window.
      */
 	class MapView : public CreatorObserver, public SimulationObserver
 	{
@@ -40,10 +42,11 @@ namespace zpr {
         void updateCameraAdded(int which_camera, int row, int col);
         void updateIsDeletingCamera(int which_camera);
         void saveToFile();
-		void updateVehicles(std::vector<std::shared_ptr<Vehicle>> vehicles);
+		void updateVehicles(const std::vector<std::shared_ptr<Vehicle>>& vehicles);
 		void draw();
 		sf::Vector2i handleInput(sf::Vector2f mousePosition);
         sf::View getView();
+        AABB getVisibleArea() const;
 		void init();
 		sf::Vector2i getRowCol();
 		bool isClicked(sf::Vector2i mousePosition);
@@ -85,7 +88,7 @@ namespace zpr {
         sf::RectangleShape cameras_[3];
 		std::vector<Cell> cells_;
         std::vector<Cell> enterCells_;
-		std::vector<std::shared_ptr<Vehicle>> vehicles_;
+        SnapshotBuffer vehicles_;
         std::unique_ptr<DrawingHelper> drawingHelper_;
         std::unique_ptr<Converter> converter_;
         std::unique_ptr<AddingHelper> addingRectangleShapesHelper_;
@@ -4,6 +4,7 @@
  */
 
 #include "asset_manager.hpp"
+#include "components/executor.hpp"
 
 namespace zpr {
 
@@ -19,6 +20,28 @@ namespace zpr {
             this-> textures_[name] = texture;
     }
 
+    /**
+     * Method which loads several textures. Image files are decoded in parallel by the Executor, textures are created
+     * by the calling thread, which owns the OpenGL context.
+     * @param textures - Names of textures and names of files from which they are loaded.
+     */
+    void AssetManager::loadTextures(const std::vector<std::pair<std::string, std::string>>& textures){
+        std::vector<sf::Image> images(textures.size());
+        std::vector<char> loaded(textures.size(), false);
+        TaskGroup task_group;
+        for (std::size_t i = 0; i < textures.size(); i++) {
+            task_group.run([&, i]() {
+                loaded[i] = images[i].loadFromFile(textures[i].second);
+            });
+        }
+        task_group.wait();
+        for (std::size_t i = 0; i < textures.size(); i++) {
+            sf::Texture texture;
+            if (loaded[i] && texture.loadFromImage(images[i]))
+                this-> textures_[textures[i].first] = texture;
+        }
+    }
+
     /**
      * Method which returns sf::Texture.
      * @param name - Name of texture.
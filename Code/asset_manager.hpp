@@ -6,6 +6,9 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 namespace zpr{
@@ -19,6 +22,7 @@ namespace zpr{
         ~AssetManager() {}
     
         void loadTexture(std::string name, std::string file_name);
+        void loadTextures(const std::vector<std::pair<std::string, std::string>>& textures);
         sf::Texture &getTexture(std::string name);
         void loadFont(std::string name, std::string file_name);
         sf::Font &getFont(std::string name);
@@ -30,29 +30,27 @@ namespace zpr {
         if (cells_.empty())
             this->generateBoard();
         else
-            this->grid_ = std::make_unique<Grid>(cells_, gridSize_);
+        {
+            this->grid_ = std::make_unique<ChunkedGrid>(cells_, gridSize_);
+            std::vector<Cell>().swap(this->cells_);
+        }
         
         this->generateEnterBoard();
         
         this->notifyEnterCells(this->enterGrid_->cells_);
-		this->notifyCells(this->grid_->cells_);
+		this->notifyCells(this->grid_->getOccupiedCells());
 		this->notifyIsDrawingRoad(this->isDrawingRoad_);
         this->notifyIsDeletingRoad(this->isDeletingRoad_);
 	}
 
     
     /**
-     * Method which generates grid containing cells of previously chosen size.
+     * Method which generates grid of previously chosen size. Cells are allocated lazily, chunk by chunk.
      */
 	void CreatorHandler::generateBoard()
 	{
-		std::vector<Cell> cells;
-		for (int i = 0; i < this->gridSize_ * this->gridSize_; i++)
-		{
-			cells.push_back(Cell(i / gridSize_, i % gridSize_));
-		}
-		cells.at(4).isStartingCell_ = true;
-        this->grid_ = std::make_unique<Grid>(cells, gridSize_);
+        this->grid_ = std::make_unique<ChunkedGrid>(gridSize_);
+		this->grid_->getCell(0, 4).isStartingCell_ = true;
 	}
 
     /**
@@ -82,9 +80,11 @@ namespace zpr {
      * Method which clears the vector of cells from drawn roads.
      */
     void CreatorHandler::clearRoads(){
-        for (Cell& cell: this->grid_->cells_){
-            cell.roadDrawn_ = false;
-        }
+        this->grid_->forEachChunk([](GridChunk& chunk) {
+            for (Cell& cell : chunk.cells_) {
+                cell.roadDrawn_ = false;
+            }
+        });
         //this->grid_ = std::make_unique<Grid>(this->grid_->cells_, gridSize_);
     }
 
@@ -131,13 +131,20 @@ namespace zpr {
     {
         this->whichCamera_ = which_camera;
         this->notifyIsDeletingCamera(this->whichCamera_);
-        for (Cell& cell : grid_->cells_){
-            if (cell.containsCamera_ == true && cell.whichCamera_ == which_camera){
-                cell.containsCamera_ = false;
-                cell.whichCamera_ = 0;
-                cell.cameraToDelete_ = false;
-                this->notifyCells(grid_->cells_);
+        bool camera_deleted = false;
+        this->grid_->forEachChunk([&](GridChunk& chunk) {
+            for (Cell& cell : chunk.cells_) {
+                if (cell.containsCamera_ == true && cell.whichCamera_ == which_camera) {
+                    cell.containsCamera_ = false;
+                    cell.whichCamera_ = 0;
+                    cell.cameraToDelete_ = false;
+                    camera_deleted = true;
+                }
             }
+        });
+        if (camera_deleted) {
+            this->grid_->releaseEmptyChunks();
+            this->notifyCells(this->grid_->getOccupiedCells());
         }
     }
 
@@ -155,10 +162,33 @@ namespace zpr {
     {
         this->isDeletingRoad_ = false;
         this->isDrawingRoad_ = false;
-		this->notifyCells(this->grid_->cells_);
+		this->notifyCells(this->grid_->getOccupiedCells());
     }
     
 
+    /**
+     * Method which deletes road from the selected cell. The cell is left empty, so its chunk is freed when nothing
+     * else is in it, and observers get it once marked to delete, to remove the drawn road.
+     */
+    void CreatorHandler::deleteRoad()
+    {
+        const Cell* cell = this->grid_->findCell(row_, col_);
+        if (!cell || !cell->containsRoad_) {
+            return;
+        }
+        Cell deleted_cell = *cell;
+        deleted_cell.containsRoad_ = false;
+        deleted_cell.toDelete_ = true;
+        Cell& grid_cell = this->grid_->getCell(row_, col_);
+        grid_cell.containsRoad_ = false;
+        grid_cell.toDelete_ = false;
+        grid_cell.roadDrawn_ = false;
+        this->grid_->releaseEmptyChunks();
+        std::vector<Cell> cells = this->grid_->getOccupiedCells();
+        cells.push_back(deleted_cell);
+        this->notifyCells(cells);
+    }
+
     /**
      * Method which handles user input (currently chosen cell, adding and deleting roads and cameras)
      * @param possible_selected_cell - Cell selected by user.
@@ -172,19 +202,18 @@ namespace zpr {
 		if (isDrawingRoad_) {
             this->grid_->getCell(row_, col_).toDelete_ = false;
 			this->grid_->getCell(row_, col_).containsRoad_ = true;
-            this->notifyCells(grid_->cells_);
+            this->notifyCells(this->grid_->getOccupiedCells());
             this->notifySelectedCell(sf::Vector2i(this->row_, this->col_));
 		}
         if (isDeletingRoad_) {
-            this->grid_->getCell(row_, col_).containsRoad_ = false;
-            this->grid_->getCell(row_, col_).toDelete_ = true;
-            this->notifyCells(grid_->cells_);
+            this->deleteRoad();
             this->notifySelectedCell(sf::Vector2i(this->row_, this->col_));
         }
-        if (isAddingCameras_ && this->grid_->getCell(row_, col_).toDelete_ == false && this->grid_->getCell(row_, col_).containsRoad_ == true){
+        const Cell* cell = this->grid_->findCell(row_, col_);
+        if (isAddingCameras_ && cell && cell->toDelete_ == false && cell->containsRoad_ == true){
             this->grid_->getCell(row_, col_).containsCamera_ = true;
             this->grid_->getCell(row_, col_).whichCamera_ = this->whichCamera_;
-            this->notifyCells(grid_->cells_);
+            this->notifyCells(this->grid_->getOccupiedCells());
             this->notifySelectedCell(sf::Vector2i(this->row_, this->col_));
             this->isAddingCameras_ = false;
             this->notifyIsAddingCamera(isAddingCameras_, whichCamera_);
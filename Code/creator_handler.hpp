@@ -7,6 +7,7 @@
 #pragma once
 #include "subjects/creator_subject.hpp"
 #include "components/grid.hpp"
+#include "components/chunked_grid.hpp"
 #include "observers/tools_observer.hpp"
 #include "observers/simulation_observer.hpp"
 #include "observers/cameras_observer.hpp"
@@ -35,7 +36,9 @@ namespace zpr {
         void saveToFile();
 		void handleInput(sf::Vector2i possible_selected_cell);
 	private:
-		std::unique_ptr<Grid> grid_, enterGrid_;
+        void deleteRoad();
+		std::unique_ptr<ChunkedGrid> grid_;
+        std::unique_ptr<Grid> enterGrid_;
         std::vector<Cell> cells_;
 		int row_, col_;
 		int gridSize_;
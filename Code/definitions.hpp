@@ -13,9 +13,55 @@
 #define ROAD_STRIPES_SIZE 3
 #define ROAD_IMAGE_SIZE 51
 
+#define WORLD_CELL_SIZE ROAD_IMAGE_SIZE
+#define GRID_LINE_PIXELS 2
+#define GRID_MIN_CELL_PIXELS 4
+
 #define STARTING_CELL_ROW 0
 #define STARTING_CELL_COL 4
 
+#define GRID_CHUNK_SIZE 64
+
+#define PROFILER_WINDOW_SIZE 256
+
+#define TRACER_BUFFER_SIZE 262144
+#define METRICS_DUMP_INTERVAL 10000
+
+#define CAMERAS_COUNT 3
+
+#define SPAWN_PERCENT 6
+#define VEHICLES_PER_ROADS_PERCENT 50
+#define VEHICLE_SPEED 3
+#define VEHICLE_UNBLOCK_TICKS 100
+
+#define SHARD_HALO_CELLS 3
+#define SHARD_RING_CAPACITY 256
+#define SHARDS_MAX_COUNT 64
+
+#define TILE_CELLS 8
+#define TILES_REBALANCE_TICKS 100
+
+#define EVENTS_MIN_QUIET_TICKS 4
+
+#define QUEUE_LINK_CAPACITY 3
+
+#define CA_CELL_SITES 4
+#define CA_MAX_SPEED 2
+#define CA_SLOWDOWN_PERCENT 20
+
+#define IDM_ACCELERATION 0.3f
+#define IDM_DECELERATION 0.6f
+#define IDM_TIME_HEADWAY 4.0f
+#define IDM_MIN_GAP 12.0f
+#define IDM_LOOKAHEAD 51
+#define IDM_MAX_TIME_STEP 4.0f
+
+#define VEHICLES_SORT_TICKS 64
+
+#define SIMULATION_TICK_MS 17
+#define FAST_FORWARD_BUDGET_MS 50
+#define SPEED_UP_REFRESH_MS 1000
+
 #define SPLASH_STATE_SHOW_TIME 1
 #define SPLASH_SCENE_BACKGROUND_FILEPATH "Resources/background_splash.jpeg"
 
@@ -1,15 +1,34 @@
 #include <iostream>
 #include "simulator.hpp"
 #include "definitions.hpp"
+#include "profiling/tracer.hpp"
+#include "profiling/metrics.hpp"
+#include "helpers/command_line.hpp"
 
 /**
 Main function which executes program.
+Option "--trace <file>" or ZPR_TRACE environment variable writes Chrome trace of the session to the file.
+Option "--metrics <file>" or ZPR_METRICS environment variable appends latency percentiles to the file every 10 seconds.
  */
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    std::string trace_path = zpr::CommandLine::getOptionValue(argc, argv, "--trace", "ZPR_TRACE");
+    std::string metrics_path = zpr::CommandLine::getOptionValue(argc, argv, "--metrics", "ZPR_METRICS");
+    if (!trace_path.empty())
+        zpr::Tracer::instance().start(trace_path);
+#ifndef ZPR_TRACING
+    if (!trace_path.empty())
+        std::cerr << "Trace events are not built in, configure with -D ENABLE_TRACING=ON to record them" << std::endl;
+#endif
+    if (!metrics_path.empty())
+        zpr::Metrics::instance().start(metrics_path, METRICS_DUMP_INTERVAL);
     zpr::Simulator simulator(SCREEN_WIDTH, SCREEN_HEIGHT, "CityTrafficSimulator");
+    if (!zpr::Tracer::instance().stop())
+        std::cerr << "Could not write trace file " << trace_path << std::endl;
+    if (!zpr::Metrics::instance().stop())
+        std::cerr << "Could not write metrics file " << metrics_path << std::endl;
     return EXIT_SUCCESS;
 }
 
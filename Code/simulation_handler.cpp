@@ -4,32 +4,374 @@
  */
 
 #include "simulation_handler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
 #include <random>
 #include "definitions.hpp"
+#include "profiling/profiler.hpp"
+#include "profiling/metrics.hpp"
 
 namespace zpr {
 
+    namespace {
+
+        /**
+         * Function returning how many steps a moving point surely makes without entering or leaving the box.
+         * @param box - Box to check.
+         * @param point - Starting point.
+         * @param step - Move of the point in one step, along one axis.
+         * @return - Number of steps after the starting point, -1 if even the first one may cross the box edge.
+         */
+        int getStepsBeforeCrossing(const AABB& box, sf::Vector2f point, sf::Vector2f step)
+        {
+            bool is_horizontal = step.x != 0;
+            float coordinate = is_horizontal ? point.x : point.y;
+            float across = is_horizontal ? point.y : point.x;
+            float speed = is_horizontal ? step.x : step.y;
+            float low = is_horizontal ? box.left_ : box.top_;
+            float high = is_horizontal ? box.right_ : box.bottom_;
+            float across_low = is_horizontal ? box.top_ : box.left_;
+            float across_high = is_horizontal ? box.bottom_ : box.right_;
+            if (speed == 0 || across < across_low || across >= across_high) {
+                return std::numeric_limits<int>::max() - 1;
+            }
+            float distance;
+            if (coordinate >= low && coordinate < high) {
+                distance = speed > 0 ? high - coordinate : coordinate - low;
+            }
+            else if ((coordinate < low) == (speed > 0)) {
+                distance = speed > 0 ? low - coordinate : coordinate - high;
+            }
+            else {
+                return std::numeric_limits<int>::max() - 1;
+            }
+            return static_cast<int>(std::floor(distance / std::abs(speed))) - 1;
+        }
+
+        /**
+         * Names of directions with indexes 0 to 3.
+         */
+        const std::string directionNames[4] = {"North", "South", "East", "West"};
+
+        /**
+         * Function returning index of direction: 0 for north, 1 for south, 2 for east and 3 for west.
+         * @param direction - Name of the direction.
+         * @return - Index of the direction.
+         */
+        int getDirectionIndex(const std::string& direction)
+        {
+            if (direction == "North") {
+                return 0;
+            }
+            else if (direction == "South") {
+                return 1;
+            }
+            else if (direction == "East") {
+                return 2;
+            }
+            return 3;
+        }
+
+        /**
+         * Function returning box which covers given box during given number of steps.
+         * @param box - Box at the start.
+         * @param step - Move of the box in one step, along one axis.
+         * @param steps - Number of steps.
+         * @return - Swept box.
+         */
+        AABB sweepBox(const AABB& box, sf::Vector2f step, int steps)
+        {
+            AABB swept = box;
+            (step.x > 0 ? swept.right_ : swept.left_) += step.x * steps;
+            (step.y > 0 ? swept.bottom_ : swept.top_) += step.y * steps;
+            return swept;
+        }
+
+        /**
+         * Function returning box enlarged on every side.
+         * @param box - Box to enlarge.
+         * @param margin - Distance added on every side.
+         * @return - Enlarged box.
+         */
+        AABB expandBox(const AABB& box, float margin)
+        {
+            return AABB(box.left_ - margin, box.top_ - margin, box.right_ + margin, box.bottom_ + margin);
+        }
+    }
+
     /**
      * Parametrized constructor of SimulationHandler class.
      * @param grid_size - Size of current grid.
      */
-    SimulationHandler::SimulationHandler(int grid_size) : isSimulating_(false), gridSize_(grid_size)
+    SimulationHandler::SimulationHandler(int grid_size) : isSimulating_(false), isEventDriven_(false), isHybrid_(false),
+        isDetailedAreaChanged_(false), isCellularAutomaton_(false), isAutomatonActive_(false), isCarFollowing_(false),
+        isCarFollowingRequested_(false), isCarFollowingChanged_(false), isMortonOrder_(false), timeStep_(1), timeScale_(1), ticksOwed_(0),
+        speedUpTicks_(0), gridSize_(grid_size),
+        engine_(std::chrono::high_resolution_clock::now().time_since_epoch().count()), detailedArea_(0, 0, 0, 0)
     {
         init();
     }
+
     /**
-     * Method which initializes elements of this class.
+     * Destructor of SimulationHandler class. It stops the simulation timer first and waits for ticks it is running,
+     * so they do not use members which are already destroyed.
+     */
+    SimulationHandler::~SimulationHandler()
+    {
+        this->startSimulationTimer_.stopTimer();
+    }
+
+    /**
+     * Method which initializes elements of this class. Simulation works in world units (WORLD_CELL_SIZE per cell),
+     * so vehicles speeds and sizes do not depend on grid size or window resolution.
      */
     void SimulationHandler::init()
     {
-        this->converter_ = std::make_unique<Converter>(this->gridSize_);
-        this->spawnPoints_ = std::make_unique<SpawnPoints>(this->gridSize_);
-        this->cellSize_ = (SCREEN_HEIGHT / this->gridSize_);
+        this->cellSize_ = WORLD_CELL_SIZE;
+        this->enterRoadsCount_ = 0;
+        this->ticksCount_ = 0;
+        this->exitedVehiclesCount_ = 0;
+        this->exitedVehiclesTicks_ = 0;
+        this->converter_ = std::make_unique<Converter>(this->gridSize_, this->cellSize_);
+        this->spawnPoints_ = std::make_unique<SpawnPoints>(this->gridSize_, this->cellSize_);
+        this->grid_ = std::make_unique<ChunkedGrid>(this->gridSize_);
         this->sidewalkSize_ = round(SIDEWALK_SIZE * cellSize_ / ROAD_IMAGE_SIZE);
         this->roadSize_ = round(ROAD_SIZE * cellSize_ / ROAD_IMAGE_SIZE);
         this->roadStripesSize_ = round(ROAD_STRIPES_SIZE * cellSize_ / ROAD_IMAGE_SIZE);
     }
 
+    /**
+     * Method which sets seed of the random engine deciding when and which vehicles appear.
+     * @param seed - New seed.
+     */
+    void SimulationHandler::setSeed(unsigned seed)
+    {
+        this->engine_.seed(seed);
+    }
+
+    /**
+     * Method which sets parameters of traffic. It has to be called before the simulation is prepared.
+     * @param parameters - New parameters.
+     */
+    void SimulationHandler::setParameters(const SimulationParameters& parameters)
+    {
+        this->parameters_ = parameters;
+    }
+
+    /**
+     * Method which sets number of threads moving vehicles. With more than one thread the map is split into tiles
+     * owned by threads, and vehicles still move in the same order, so results do not depend on the number of threads.
+     * @param threads - Number of threads, 1 moves every vehicle in the simulation thread.
+     */
+    void SimulationHandler::setThreadsCount(int threads)
+    {
+        if (threads > 1) {
+            this->tileScheduler_ = std::make_unique<TileScheduler>(this->gridSize_, this->cellSize_, this->converter_->calculatePrefix(), threads);
+            this->sightings_.resize(threads);
+        }
+        else {
+            this->tileScheduler_.reset();
+        }
+        this->wakeVehicles();
+    }
+
+    /**
+     * Method which turns on event-driven moving of vehicles. A vehicle which goes straight at full speed and surely
+     * meets no crossroads, camera or other vehicle in the next ticks only moves forward until that moment, instead of
+     * looking for its road, collisions and cameras in every tick. Results are the same as with checks in every tick.
+     * A vehicle stopped by another one sleeps until that vehicle moves. Vehicles moved by the tile scheduler are always
+     * checked in every tick.
+     * @param is_event_driven - True to skip checks of vehicles which have nothing to check.
+     */
+    void SimulationHandler::setEventDriven(bool is_event_driven)
+    {
+        this->isEventDriven_ = is_event_driven;
+        this->wakeVehicles();
+    }
+
+    /**
+     * Method which turns on continuous car following: instead of driving at full speed or standing, vehicles speed
+     * up and brake smoothly according to the gap to the vehicle ahead, with speeds of all vehicles computed at once
+     * by CarFollowing. Vehicles are then moved by the simulation thread and checked in every tick, so moving on tiles
+     * and event-driven moving wait until it is turned off. It may be called from another thread, the model is
+     * switched in the next tick.
+     * @param is_car_following - True to use the Intelligent Driver Model.
+     */
+    void SimulationHandler::setCarFollowing(bool is_car_following)
+    {
+        std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+        this->isCarFollowingRequested_ = is_car_following;
+        this->isCarFollowingChanged_ = true;
+    }
+
+    /**
+     * Method which turns on sorting vehicles by Morton codes of their cells every VEHICLES_SORT_TICKS ticks, so
+     * vehicles close to each other on the map are close in the vehicle list and in packed shapes, and workers of the
+     * tile scheduler get contiguous parts of them. VehicleStore then moves vehicles between its slots, so they lie
+     * in memory in the same order. Pointers to vehicles (shared or raw) therefore point to other vehicles after a
+     * sort; only vectors of the simulation are updated. Vehicles are found again by their handles (Vehicle::handle_),
+     * which do not change, with getVehicle(). Vehicles are then moved in that order instead of the order in which
+     * they appeared.
+     * @param is_morton_order - True to sort vehicles.
+     */
+    void SimulationHandler::setMortonOrder(bool is_morton_order)
+    {
+        this->isMortonOrder_ = is_morton_order;
+    }
+
+    /**
+     * Method which sets how many times faster than real time the simulation runs: the timer makes that many ticks of
+     * SIMULATION_TICK_MS per its run, or as many as fit in FAST_FORWARD_BUDGET_MS for 0. It can be called from any
+     * thread while the simulation runs.
+     * @param time_scale - Speed-up, 0 for as fast as possible.
+     */
+    void SimulationHandler::setTimeScale(int time_scale)
+    {
+        this->timeScale_.store(std::max(time_scale, 0));
+    }
+
+    /**
+     * Method returning speed-up of the simulation.
+     * @return - Speed-up, 0 for as fast as possible.
+     */
+    int SimulationHandler::getTimeScale() const
+    {
+        return this->timeScale_.load();
+    }
+
+    /**
+     * Method returning speed-up chosen after the given one: 1x, 10x, 100x, as fast as possible and again 1x.
+     * @param time_scale - Current speed-up, 0 for as fast as possible.
+     * @return - Next speed-up.
+     */
+    int SimulationHandler::getNextTimeScale(int time_scale)
+    {
+        if (time_scale == 0) {
+            return 1;
+        }
+        return time_scale >= 100 ? 0 : time_scale * 10;
+    }
+
+    /**
+     * Method which sets time step of car following: vehicles drive as far in one tick as in that many ticks of
+     * normal simulation. Vehicles are moved cell by cell and swept against crossing vehicles, so they do not jump
+     * over anything. The step is at most IDM_MAX_TIME_STEP, with longer ones speeds of followers oscillate.
+     * @param time_step - Time step in ticks, more than 0.
+     */
+    void SimulationHandler::setTimeStep(float time_step)
+    {
+        this->timeStep_ = std::min(std::max(time_step, 0.01f), IDM_MAX_TIME_STEP);
+    }
+
+    /**
+     * Method which turns on hybrid simulation: only roads near the detailed area, near cameras and the enter road
+     * are simulated with Vehicle objects, vehicles elsewhere are simulated by the queue model. Vehicles leaving
+     * detailed roads are demoted to queued vehicles and queued vehicles reaching them are promoted back, so cameras
+     * count every vehicle and every vehicle leaves the city through exit sites. After it is turned off, queued
+     * vehicles are promoted where they stand as soon as there is room for them. It may be called from another thread.
+     * @param is_hybrid - True to simulate vehicles far from the detailed area by the queue model.
+     */
+    void SimulationHandler::setHybrid(bool is_hybrid)
+    {
+        std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+        this->isHybrid_ = is_hybrid;
+        this->isDetailedAreaChanged_ = true;
+    }
+
+    /**
+     * Method which sets the area simulated in detail in hybrid simulation, usually the part of the city visible in
+     * the map view. It may be called from another thread, the area is used from the next tick.
+     * @param area - Area in world units.
+     */
+    void SimulationHandler::setDetailedArea(const AABB& area)
+    {
+        std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+        if (this->detailedArea_ != area) {
+            this->detailedArea_ = area;
+            this->isDetailedAreaChanged_ = true;
+        }
+    }
+
+    /**
+     * Method returning number of vehicles simulated by the queue model.
+     * @return - Number of queued vehicles, 0 if simulation is not hybrid.
+     */
+    std::size_t SimulationHandler::getQueuedVehiclesCount() const
+    {
+        return this->queueModel_ ? this->queueModel_->getVehiclesCount() : 0;
+    }
+
+    /**
+     * Method which switches the model of traffic between Vehicle objects and the cellular automaton. The automaton
+     * uses the same roads, spawn points, cameras and exit sites, but moves vehicles between sites of lanes instead of
+     * moving boxes, so it simulates big cities much faster when exact positions do not matter. Hybrid simulation is
+     * off while the automaton is used. Vehicles already in the city are moved to the other model as soon as there is
+     * room for them. It may be called from another thread.
+     * @param is_cellular_automaton - True to simulate traffic with the cellular automaton.
+     */
+    void SimulationHandler::setCellularAutomaton(bool is_cellular_automaton)
+    {
+        std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+        this->isCellularAutomaton_ = is_cellular_automaton;
+        this->isDetailedAreaChanged_ = true;
+    }
+
+    /**
+     * Method returning number of vehicles simulated by the cellular automaton.
+     * @return - Number of vehicles in the automaton, 0 if it is not used.
+     */
+    std::size_t SimulationHandler::getAutomatonVehiclesCount() const
+    {
+        return this->automaton_ ? this->automaton_->getVehiclesCount() : 0;
+    }
+
+    /**
+     * Method returning parameters of traffic.
+     * @return - Parameters of traffic.
+     */
+    const SimulationParameters& SimulationHandler::getParameters() const
+    {
+        return this->parameters_;
+    }
+
+    /**
+     * Method returning number of vehicles which left the city.
+     * @return - Number of vehicles which reached city exit.
+     */
+    std::uint64_t SimulationHandler::getExitedVehiclesCount() const
+    {
+        return this->exitedVehiclesCount_;
+    }
+
+    /**
+     * Method returning sum of ticks which vehicles that left the city spent in it.
+     * @return - Sum of lifetimes of exited vehicles in ticks.
+     */
+    std::uint64_t SimulationHandler::getExitedVehiclesTicks() const
+    {
+        return this->exitedVehiclesTicks_;
+    }
+
+    /**
+     * Method returning number of ticks made since the simulation was prepared.
+     * @return - Number of ticks.
+     */
+    std::uint64_t SimulationHandler::getTicksCount() const
+    {
+        return this->ticksCount_;
+    }
+
+    /**
+     * Method returning maximal number of vehicles of each type on the map.
+     * @return - Given percent of the number of roads.
+     */
+    std::size_t SimulationHandler::getMaxVehicles() const
+    {
+        return this->roads_.size() * this->parameters_.vehiclesPerRoadsPercent_ / 100;
+    }
+
     /**
      * Method which starts simulation. It also launches timer (new thread) to handle simulation.
      */
@@ -39,35 +381,263 @@ namespace zpr {
         this->isSimulating_ = !this->isSimulating_;
         
         if (isSimulating_){
-            this->separateUserRoadsFromCells();
-            this->separateCamerasFromCells();
-            this->spawnPoints_->setupExitSites(this->cityExitSite_);
+            this->prepareSimulation();
+            this->ticksOwed_ = 0;
+            this->speedUpTicks_ = 0;
+            this->lastRunTime_ = std::chrono::steady_clock::now();
+            this->speedUpStart_ = this->lastRunTime_;
             this->startSimulationTimer_.setInterval([&]() {
-                this->addCarsToSimulate();
-                this->moveVehicles();
-                this->deleteVehicles();
-            }, 17);
+                Tracer::instance().setThreadName("Simulation timer");
+                this->runTicks();
+            }, SIMULATION_TICK_MS);
         }
         else {
             this->startSimulationTimer_.stopTimer();
-            std::this_thread::sleep_for(std::chrono::milliseconds(400));
             this->vehicles_.clear();
+            this->carsPool_.clear();
+            this->trucksPool_.clear();
+            this->vehicleStore_.reset();
             this->notifyVehicles(this->vehicles_);
-            this->roads_.erase(roads_.begin()+15, roads_.end());
+            this->roads_.erase(roads_.begin() + this->enterRoadsCount_, roads_.end());
             this->cameras_.clear();
             this->cityExitSite_.clear();
+            this->queueModel_.reset();
+            this->automaton_.reset();
+            this->automatonVehicles_.clear();
         }
         this->notifyIsSimulating(this->isSimulating_);
 
     }
 
+    /**
+     * Method which prepares roads, cameras and exit sites for simulation, without any vehicles.
+     */
+    void SimulationHandler::prepareRoads()
+    {
+        this->separateUserRoadsFromCells();
+        this->separateCamerasFromCells();
+        this->spawnPoints_->setupExitSites(this->cityExitSite_);
+        this->straightRoads_.clear();
+        this->queueModel_.reset();
+        this->automaton_.reset();
+    }
+
+    /**
+     * Method which finds straight roads: a road is the straight road of another one in given direction if it is
+     * the only road of the next cell in that direction and a vehicle coming from the other road can only go on in
+     * the same direction, so it neither draws nor changes anything there. For every road and direction it also
+     * saves edge of the last cell which a vehicle going that way reaches by straight roads. Straight roads are found
+     * in the first event-driven tick after roads were prepared.
+     */
+    void SimulationHandler::prepareStraightRoads()
+    {
+        const sf::Vector2f steps[4] = {sf::Vector2f(0, -this->cellSize_), sf::Vector2f(0, this->cellSize_),
+                                       sf::Vector2f(this->cellSize_, 0), sf::Vector2f(-this->cellSize_, 0)};
+        std::map<std::pair<float, float>, std::vector<int>> cells;
+        for (std::size_t i = 0; i < this->roads_.size(); i++) {
+            sf::Vector2f position = this->roads_[i].getPosition();
+            cells[std::make_pair(position.x, position.y)].push_back(i);
+        }
+        auto find_cell = [&](sf::Vector2f position) {
+            std::map<std::pair<float, float>, std::vector<int>>::const_iterator cell = cells.find(std::make_pair(position.x, position.y));
+            return cell == cells.end() ? nullptr : &cell->second;
+        };
+        this->straightRoads_.assign(this->roads_.size(), {-1, -1, -1, -1});
+        for (std::size_t i = 0; i < this->roads_.size(); i++) {
+            for (int direction = 0; direction < 4; direction++) {
+                const std::vector<int>* next = find_cell(this->roads_[i].getPosition() + steps[direction]);
+                if (!next || next->size() != 1) {
+                    continue;
+                }
+                int neighbouring_roads = 0;
+                bool is_straight = false;
+                for (int neighbour = 0; neighbour < 4; neighbour++) {
+                    const std::vector<int>* roads = find_cell(this->roads_[next->front()].getPosition() + steps[neighbour]);
+                    for (std::size_t j = 0; roads && j < roads->size(); j++) {
+                        if (this->roads_[(*roads)[j]] != this->roads_[i]) {
+                            neighbouring_roads++;
+                            is_straight = neighbour == direction;
+                        }
+                    }
+                }
+                if (neighbouring_roads == 1 && is_straight) {
+                    this->straightRoads_[i][direction] = next->front();
+                }
+            }
+        }
+        this->straightRoadsEnds_.assign(this->roads_.size(), {0, 0, 0, 0});
+        for (int direction = 0; direction < 4; direction++) {
+            std::vector<bool> is_done(this->roads_.size(), false);
+            for (std::size_t i = 0; i < this->roads_.size(); i++) {
+                std::vector<int> chain;
+                int road = i;
+                while (!is_done[road] && this->straightRoads_[road][direction] >= 0) {
+                    chain.push_back(road);
+                    is_done[road] = true;
+                    road = this->straightRoads_[road][direction];
+                }
+                if (!is_done[road]) {
+                    const AABB& last = this->roads_[road];
+                    const float edges[4] = {last.top_, last.bottom_, last.right_, last.left_};
+                    this->straightRoadsEnds_[road][direction] = edges[direction];
+                    is_done[road] = true;
+                }
+                for (int chained : chain) {
+                    this->straightRoadsEnds_[chained][direction] = this->straightRoadsEnds_[road][direction];
+                }
+            }
+        }
+    }
+
+    /**
+     * Method returning roads of the simulation: enter roads, roads of the city and both starting roads, in this order.
+     * @return - Roads of the simulation.
+     */
+    const std::vector<AABB>& SimulationHandler::getRoads() const
+    {
+        return this->roads_;
+    }
+
+    /**
+     * Method returning cameras of the simulation.
+     * @return - Cameras of the simulation.
+     */
+    const std::vector<Camera>& SimulationHandler::getCameras() const
+    {
+        return this->cameras_;
+    }
+
+    /**
+     * Method returning sites where vehicles leave the city.
+     * @return - Exit sites.
+     */
+    const std::vector<AABB>& SimulationHandler::getExitSites() const
+    {
+        return this->cityExitSite_;
+    }
+
+    /**
+     * Method returning vehicles on the map, in order in which they appeared or, with setMortonOrder, sorted by cells.
+     * @return - Simulated vehicles.
+     */
+    const std::vector<std::shared_ptr<Vehicle>>& SimulationHandler::getVehicles() const
+    {
+        return this->vehicles_;
+    }
+
+    /**
+     * Method returning a vehicle by its handle (Vehicle::handle_). Unlike pointers, handles stay valid when vehicles
+     * are sorted, until the simulation is stopped.
+     * @param handle - Handle of the vehicle.
+     * @return - Pointer to the vehicle, valid until vehicles are sorted again.
+     */
+    std::shared_ptr<Vehicle> SimulationHandler::getVehicle(std::uint32_t handle) const
+    {
+        return this->vehicleStore_->getVehicle(handle);
+    }
+
+    /**
+     * Method which prepares roads, cameras and exit sites for simulation. It also creates every vehicle that can be
+     * on the map at once (by default half of the roads of each type) in one VehicleStore, so ticks only take vehicles
+     * from pools and give them back.
+     */
+    void SimulationHandler::prepareSimulation()
+    {
+        this->prepareRoads();
+        std::size_t max_vehicles = this->getMaxVehicles();
+        this->vehicles_.reserve(max_vehicles);
+        this->sortedVehicles_.reserve(max_vehicles);
+        this->mortonOrder_.reserve(max_vehicles);
+        this->carsPool_.reserve(max_vehicles);
+        this->trucksPool_.reserve(max_vehicles);
+        if (!this->vehicleStore_) {
+            this->vehicleStore_ = VehicleStore::create(max_vehicles, max_vehicles, this->cellSize_, this->roads_);
+            this->vehicleStore_->fillPools(this->carsPool_, this->trucksPool_);
+        }
+        for (std::vector<std::shared_ptr<Vehicle>>* pool : {&this->carsPool_, &this->trucksPool_}) {
+            for (const std::shared_ptr<Vehicle>& vehicle : *pool) {
+                vehicle->maxSpeed_ = this->parameters_.vehicleSpeed_;
+                vehicle->unblockTicks_ = this->parameters_.unblockTicks_;
+            }
+        }
+    }
+
+    /**
+     * Method which makes one step of simulation. After prepareSimulation() it does not allocate memory, apart from
+     * ticks which start hybrid simulation or the cellular automaton.
+     * @param is_snapshot - False to skip notifying observers about vehicles, when more ticks follow before they are
+     * drawn.
+     */
+    void SimulationHandler::tick(bool is_snapshot)
+    {
+        ZPR_PROFILE_FRAME(Tick, NotifyVehicles);
+        ScopedMetric tick_metric(Metric::TickDuration);
+        this->ticksCount_++;
+        this->updateAutomaton();
+        this->updateQueueModel();
+        this->updateCarFollowing();
+        this->addCarsToSimulate();
+        this->sortVehicles();
+        this->moveVehicles();
+        if (this->queueModel_) {
+            this->demoteVehicles();
+            this->queueModel_->tick(this->ticksCount_, [&](const QueuedVehicle& queued, int road, int from_road, int direction, sf::Vector2f position) {
+                return this->promoteVehicle(queued, road, from_road, direction, position);
+            });
+        }
+        this->tickAutomaton();
+        this->deleteVehicles();
+        if (is_snapshot) {
+            this->notifySnapshot();
+        }
+    }
+
+    /**
+     * Method run by the simulation timer every SIMULATION_TICK_MS after its previous run ends. It makes as many ticks
+     * as the time scale gives for the time since the previous run, or as many as fit in FAST_FORWARD_BUDGET_MS when
+     * running as fast as possible, and notifies observers only about vehicles after the last of them, since only that
+     * state is drawn. Ticks which do not fit in the budget are dropped, so a slow map does not build up a backlog.
+     * Every SPEED_UP_REFRESH_MS observers get the speed-up actually reached.
+     */
+    void SimulationHandler::runTicks()
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point deadline = start + std::chrono::milliseconds(FAST_FORWARD_BUDGET_MS);
+        int time_scale = this->timeScale_.load();
+        if (time_scale == 0) {
+            this->ticksOwed_ = std::numeric_limits<double>::max();
+        }
+        else {
+            this->ticksOwed_ += std::chrono::duration<double, std::milli>(start - this->lastRunTime_).count() * time_scale / SIMULATION_TICK_MS;
+        }
+        this->lastRunTime_ = start;
+        int ticks = 0;
+        while (this->ticksOwed_ >= 1 && (ticks == 0 || std::chrono::steady_clock::now() < deadline)) {
+            this->tick(false);
+            this->ticksOwed_--;
+            ticks++;
+        }
+        this->ticksOwed_ = std::min(this->ticksOwed_, 1.0);
+        if (ticks > 0) {
+            this->notifySnapshot();
+        }
+        this->speedUpTicks_ += ticks;
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::milli>(end - this->speedUpStart_).count();
+        if (elapsed >= SPEED_UP_REFRESH_MS) {
+            this->notifySpeedUp(time_scale, static_cast<float>(this->speedUpTicks_ * SIMULATION_TICK_MS / elapsed));
+            this->speedUpTicks_ = 0;
+            this->speedUpStart_ = end;
+        }
+    }
+
     /**
      * Method which update cells of object of this class.
-     * @param cells - Updated cells.
+     * @param cells - Updated cells (only not empty ones are needed).
      */
     void SimulationHandler::updateCells(std::vector<Cell> cells)
     {
-        this->cells_ = cells;
+        this->grid_ = std::make_unique<ChunkedGrid>(cells, this->gridSize_);
         this->separateCamerasFromCells();
     }
     /**
@@ -85,9 +655,11 @@ namespace zpr {
      */
     void SimulationHandler::separateUserRoadsFromCells()
     {
-        for (Cell& cell : cells_) {
-            this->separateRoadsFromCells(cell);
-        }
+        this->grid_->forEachChunk([&](GridChunk& chunk) {
+            for (Cell& cell : chunk.cells_) {
+                this->separateRoadsFromCells(cell);
+            }
+        });
         this->spawnPoints_->addStartingRoad(this->roads_);
     }
 
@@ -96,12 +668,13 @@ namespace zpr {
      */
     void SimulationHandler::separateEnterRoadsFromCells()
     {
+        this->roads_.clear();
         for (Cell& cell : enterCells_) {
             if (cell.containsRoad_) {
-                this->roads_.push_back(this->converter_->convertCellToCenteredRectShape(cell, "Enter"));
+                this->roads_.push_back(this->converter_->convertCellToCenteredBox(cell, "Enter"));
             }
         }
-        
+        this->enterRoadsCount_ = this->roads_.size();
     }
     /**
      * Method which checks if cell contains road and if yes, it adds this cell to vector of roads.
@@ -110,7 +683,7 @@ namespace zpr {
     void SimulationHandler::separateRoadsFromCells(Cell& cell)
     {
         if (cell.containsRoad_) {
-            this->roads_.push_back(this->converter_->convertCellToCenteredRectShape(cell, "User"));
+            this->roads_.push_back(this->converter_->convertCellToCenteredBox(cell, "User"));
         }
     }
 
@@ -121,132 +694,826 @@ namespace zpr {
     {
 
         this->cameras_.clear();
-        for (Cell& cell : this->cells_) {
-            if (cell.containsCamera_) {
-                this->cameras_.push_back(Camera(cell.whichCamera_, this->converter_->convertCellToCenteredRectShape(cell, "User")));
+        this->grid_->forEachChunk([&](GridChunk& chunk) {
+            for (Cell& cell : chunk.cells_) {
+                if (cell.containsCamera_) {
+                    this->cameras_.push_back(Camera(cell.whichCamera_, this->converter_->convertCellToCenteredBox(cell, "User")));
+                }
             }
-        }
+        });
     }
 
    
     /**
-     * Method which add cars to simulation.
+     * Method which add cars to simulation. A vehicle appears with spawnPercent_ chance; two thirds of them are cars
+     * and each type enters from both sides equally often.
      */
     void SimulationHandler::addCarsToSimulate()
     {
+        ZPR_PROFILE_SCOPE(AddCars);
 
-        if (this->startingCellFree() && this->vehicles_.size() < this->roads_.size() / 2) {
+        if (this->startingCellFree() && this->vehicles_.size() + this->getQueuedVehiclesCount() + this->getAutomatonVehiclesCount() < this->getMaxVehicles()) {
             
-            int x_start_1 = this->converter_->calculatePrefix() + cellSize_ * 0 +  ROAD_IMAGE_SIZE / 2;
-            int y_start_1 = this->converter_->calculatePrefix() + cellSize_ * -2 + this->sidewalkSize_ + this->roadSize_/4;
-            int x_start_2 = this->converter_->calculatePrefix() + cellSize_ * (sqrt(this->cells_.size())-1) + ROAD_IMAGE_SIZE / 2;
-            int y_start_2 = this->converter_->calculatePrefix() + cellSize_ * -2 + this->sidewalkSize_ + this->roadSize_ / 4;
-        
-            std::random_device rng;
-            std::mt19937 eng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-            std::uniform_int_distribution<> dist(1, 100);
-            int num = dist(eng);
+            sf::Vector2i start_1 = this->getStartingPosition(false);
+            sf::Vector2i start_2 = this->getStartingPosition(true);
 
-            if (num > 0 && num < 7) {
+            int num = drawSpawn(this->engine_, this->parameters_);
+
+            if (num != 0) {
                 if (num > 4) {
                     if (num == 5) {
-                        this->vehicles_.push_back(VehicleFactory::createTruck(x_start_1, y_start_1, this->cellSize_, this->roads_, "East"));
+                        this->spawnVehicle(this->trucksPool_, start_1.x, start_1.y, "East");
                     }
                     else {
-                        this->vehicles_.push_back(VehicleFactory::createTruck(x_start_2, y_start_2, this->cellSize_, this->roads_, "West"));
+                        this->spawnVehicle(this->trucksPool_, start_2.x, start_2.y, "West");
                     }
                 }
                 else {
                     if (num <= 2) {
-                        this->vehicles_.push_back(VehicleFactory::createCar(x_start_1, y_start_1, this->cellSize_, this->roads_, "East"));
+                        this->spawnVehicle(this->carsPool_, start_1.x, start_1.y, "East");
                     }
                     else {
-                        this->vehicles_.push_back(VehicleFactory::createCar(x_start_2, y_start_2, this->cellSize_, this->roads_, "West"));
+                        this->spawnVehicle(this->carsPool_, start_2.x, start_2.y, "West");
                     }
                 }
             }
         }
     }
 
+    /**
+     * Method drawing which vehicle appears in this tick: 1-2 car from the west, 3-4 car from the east, 5 truck from
+     * the west, 6 truck from the east.
+     * @param engine - Random engine of the simulation.
+     * @param parameters - Parameters of traffic.
+     * @return - Drawn number, 0 if no vehicle appears.
+     */
+    int SimulationHandler::drawSpawn(std::mt19937& engine, const SimulationParameters& parameters)
+    {
+        std::uniform_int_distribution<> dist(1, 100);
+        int drawn = dist(engine);
+        return drawn <= parameters.spawnPercent_ ? (drawn - 1) * 6 / parameters.spawnPercent_ + 1 : 0;
+    }
+
+    /**
+     * Method returning position where vehicles appear, in the enter road above the city.
+     * @param is_east - True for the east end of the enter road (vehicles going west), false for the west end.
+     * @return - Position in world units.
+     */
+    sf::Vector2i SimulationHandler::getStartingPosition(bool is_east) const
+    {
+        int x = this->converter_->calculatePrefix() + this->cellSize_ * (is_east ? this->gridSize_ - 1 : 0) + this->cellSize_ / 2;
+        int y = this->converter_->calculatePrefix() + this->cellSize_ * -2 + this->sidewalkSize_ + this->roadSize_ / 4;
+        return sf::Vector2i(x, y);
+    }
+
+    /**
+     * Method which takes vehicle from pool, puts it on starting position and adds it to simulation. While the
+     * cellular automaton is used the vehicle is added to the automaton instead.
+     * @param pool - Pool of cars or trucks.
+     * @param x - Position x of the vehicle.
+     * @param y - Position y of the vehicle.
+     * @param direction - Starting direction.
+     */
+    void SimulationHandler::spawnVehicle(std::vector<std::shared_ptr<Vehicle>>& pool, int x, int y, const std::string& direction)
+    {
+        if (this->isAutomatonActive_) {
+            this->automaton_->add(sf::Vector2f(x, y), getDirectionIndex(direction), &pool == &this->trucksPool_, this->ticksCount_);
+            return;
+        }
+        if (pool.empty()) {
+            return;
+        }
+        std::shared_ptr<Vehicle> vehicle = std::move(pool.back());
+        pool.pop_back();
+        vehicle->reset(x, y, direction, this->engine_());
+        vehicle->spawnTick_ = this->ticksCount_;
+        this->vehicles_.push_back(std::move(vehicle));
+    }
+
+    /**
+     * Method which sorts vehicles by Morton codes of cells they are on, every VEHICLES_SORT_TICKS ticks if it is
+     * turned on. Vehicles on the same cell keep their order, so the order does not depend on the sorting algorithm.
+     * The vehicles themselves are moved in the store to the same order, so neighbours lie next to each other in
+     * memory; wake lists link vehicles by address, so every vehicle is woken first.
+     */
+    void SimulationHandler::sortVehicles()
+    {
+        if (!this->isMortonOrder_ || this->ticksCount_ % VEHICLES_SORT_TICKS != 0) {
+            return;
+        }
+        this->mortonOrder_.clear();
+        for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+            this->mortonOrder_.push_back(std::make_pair(this->converter_->getMortonCode(this->vehicles_[i]->getShape().getPosition()), i));
+        }
+        std::sort(this->mortonOrder_.begin(), this->mortonOrder_.end());
+        this->sortedVehicles_.clear();
+        for (const std::pair<std::uint32_t, std::size_t>& vehicle : this->mortonOrder_) {
+            this->sortedVehicles_.push_back(std::move(this->vehicles_[vehicle.second]));
+        }
+        this->vehicles_.swap(this->sortedVehicles_);
+        this->wakeVehicles();
+        this->vehicleStore_->reorder(this->vehicles_, this->carsPool_, this->trucksPool_);
+    }
+
     /**
      * Method responsible for moving vehicles - triggering certain methods to properly move the vehicle.
+     * Only the vehicle being moved changes its position, so only its speed and its visibility for cameras are checked.
      */
     void SimulationHandler::moveVehicles()
     {
-        for (std::shared_ptr<Vehicle> vehicle : this->vehicles_) {
+        ZPR_PROFILE_SCOPE(MoveVehicles);
+        if (this->isCarFollowing_) {
+            this->moveVehiclesFollowing();
+            return;
+        }
+        if (this->tileScheduler_) {
+            this->moveVehiclesOnTiles();
+            return;
+        }
+        if (this->isEventDriven_ && this->straightRoads_.size() != this->roads_.size()) {
+            this->prepareStraightRoads();
+        }
+        this->packedVehicles_.resize(this->vehicles_.size());
+        for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+            this->packedVehicles_.setShape(i, this->vehicles_[i]->getShape());
+        }
+        for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+            const std::shared_ptr<Vehicle>& vehicle = this->vehicles_[i];
+            AABB shape = vehicle->getShape();
+            if (vehicle->wakeTick_ <= this->ticksCount_) {
+                vehicle->stopSleeping();
+                Vehicle* blocker = nullptr;
+                AABB colision_box;
+                unsigned sightings = moveVehicle(vehicle, this->cameras_, [&]() {
+                    blocker = this->vehicleColision(vehicle);
+                    colision_box = vehicle->colisionBox_;
+                    return blocker != nullptr;
+                });
+                this->notifySightings(sightings, vehicle->isTruck());
+                if (this->isEventDriven_) {
+                    vehicle->straightUntilTick_ = this->ticksCount_ + this->getStraightMoves(vehicle);
+                    if (!blocker || !this->sleepVehicle(vehicle, *blocker, colision_box)) {
+                        vehicle->wakeTick_ = this->ticksCount_ + this->getQuietTicks(vehicle);
+                    }
+                }
+            }
+            else if (vehicle->speed_ == 0) {
+                vehicle->stopCounter_++;
+            }
+            else {
+                if (!vehicle->currentRoad_->contains(vehicle->getShape().getPosition())) {
+                    int road = vehicle->currentRoad_ - this->roads_.data();
+                    vehicle->currentRoad_ = &this->roads_[this->straightRoads_[road][getDirectionIndex(vehicle->direction_)]];
+                    vehicle->previousRoad_ = vehicle->currentRoad_;
+                }
+                vehicle->move();
+            }
+            if (vehicle->getShape() != shape) {
+                this->packedVehicles_.setShape(i, vehicle->getShape());
+                if (vehicle->firstSleeper_) {
+                    vehicle->wakeSleepers(this->ticksCount_);
+                }
+            }
+        }
+    }
+
+    /**
+     * Method moving vehicles on workers of the tile scheduler. Cameras are checked by the workers, but observers are
+     * notified by the simulation thread after every vehicle moved.
+     */
+    void SimulationHandler::moveVehiclesOnTiles()
+    {
+        this->tileScheduler_->prepare(this->vehicles_);
+        this->tileScheduler_->run([&](std::size_t index, int worker) {
+            const std::shared_ptr<Vehicle>& vehicle = this->vehicles_[index];
+            unsigned sightings = moveVehicle(vehicle, this->cameras_, [&]() {
+                return this->tileScheduler_->checkColision(index, worker);
+            });
+            if (sightings != 0) {
+                this->sightings_[worker].push_back(std::make_pair(sightings, vehicle->isTruck()));
+            }
+        });
+        for (std::vector<std::pair<unsigned, bool>>& worker_sightings : this->sightings_) {
+            for (const std::pair<unsigned, bool>& sighting : worker_sightings) {
+                this->notifySightings(sighting.first, sighting.second);
+            }
+            worker_sightings.clear();
+        }
+    }
+
+    /**
+     * Method moving vehicles with car following. Gaps to leaders of all vehicles are found before any of them moves,
+     * then CarFollowing computes their speeds and distances in one pass, and vehicles move by whole world units,
+     * keeping the rest of the distance for the next tick. Vehicles crossing the way are not leaders: like in the
+     * default model, a vehicle does not drive into one of them with its colision box, checked right before it moves
+     * along the whole distance, so two vehicles do not enter a crossroads at once even with a long time step.
+     */
+    void SimulationHandler::moveVehiclesFollowing()
+    {
+        this->carFollowing_->resize(this->vehicles_.size());
+        for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+            const std::shared_ptr<Vehicle>& vehicle = this->vehicles_[i];
             vehicle->checkOnWhichCell();
-            this->vehiclesColision();
-            vehicle->move();
+            float leader_speed = 0;
+            float gap = this->findLeader(vehicle, leader_speed);
+            this->carFollowing_->setVehicle(i, vehicle->velocity_, vehicle->maxSpeed_, gap, leader_speed);
+        }
+        this->carFollowing_->update(this->timeStep_);
+        for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+            const std::shared_ptr<Vehicle>& vehicle = this->vehicles_[i];
+            float distance = this->findCrossingDistance(vehicle, this->carFollowing_->getDistance(i));
+            vehicle->velocity_ = distance < this->carFollowing_->getDistance(i) ? distance / this->timeStep_ : this->carFollowing_->getSpeed(i);
+            vehicle->travelled_ += distance;
+            int whole_distance = static_cast<int>(vehicle->travelled_);
+            vehicle->travelled_ -= whole_distance;
+            vehicle->speed_ = this->driveThroughCells(vehicle, whole_distance);
             vehicle->checkVehicleStopped();
             vehicle->unblockVehicle();
+            if (!this->isInExitSite(vehicle)) {
+                vehicle->checkTurn();
+            }
+            this->notifySightings(checkCameraVision(this->cameras_, vehicle), vehicle->isTruck());
+        }
+    }
+
+    /**
+     * Method finding the nearest vehicle going in the same direction ahead of the vehicle, in the strip of its width
+     * which starts in its middle and reaches IDM_LOOKAHEAD in front of it, plus the distance the vehicle can drive in
+     * one time step, so it cannot pass a leader it did not see. Of two overlapping vehicles, eg. after one turned
+     * into the lane of the other, only the one behind waits.
+     * @param vehicle - Vehicle which looks for its leader.
+     * @param leader_speed - Set to speed of the leader along the direction of the vehicle.
+     * @return - Distance the vehicle may drive before it is as close to the leader as a stopped vehicle in the default
+     * model, the biggest float if there is no leader.
+     */
+    float SimulationHandler::findLeader(const std::shared_ptr<Vehicle>& vehicle, float& leader_speed) const
+    {
+        const AABB& shape = vehicle->getShape();
+        sf::Vector2f middle = shape.getPosition();
+        int direction = getDirectionIndex(vehicle->direction_);
+        const float lookahead = IDM_LOOKAHEAD + vehicle->maxSpeed_ * this->timeStep_;
+        const AABB aheads[4] = {AABB(shape.left_, shape.top_ - lookahead, shape.right_, middle.y),
+                                AABB(shape.left_, middle.y, shape.right_, shape.bottom_ + lookahead),
+                                AABB(middle.x, shape.top_, shape.right_ + lookahead, shape.bottom_),
+                                AABB(shape.left_ - lookahead, shape.top_, middle.x, shape.bottom_)};
+        float gap = std::numeric_limits<float>::max();
+        for (const std::shared_ptr<Vehicle>& other : this->vehicles_) {
+            const AABB& other_shape = other->getShape();
+            sf::Vector2f other_middle = other_shape.getPosition();
+            const float aheads_of_middle[4] = {middle.y - other_middle.y, other_middle.y - middle.y, other_middle.x - middle.x, middle.x - other_middle.x};
+            if (other->direction_ != vehicle->direction_ || aheads_of_middle[direction] <= 0 || !aheads[direction].intersects(other_shape)) {
+                continue;
+            }
+            const float distances[4] = {shape.top_ - other_shape.bottom_, other_shape.top_ - shape.bottom_,
+                                        other_shape.left_ - shape.right_, shape.left_ - other_shape.right_};
+            float distance = std::max(distances[direction] - this->roadStripesSize_, 0.0f);
+            if (distance < gap) {
+                gap = distance;
+                leader_speed = other->velocity_;
+            }
+        }
+        return gap;
+    }
+
+    /**
+     * Method sweeping colision box of the vehicle along its lane and finding how far it can drive before the box
+     * touches a vehicle going another way. Only vehicles beside the lane of the box are checked, so the sweep gives
+     * the same answer as moving the box in steps of any size, and the vehicle cannot jump over a crossing vehicle.
+     * @param vehicle - Vehicle which is about to move.
+     * @param distance - Distance the vehicle wants to drive.
+     * @return - Distance the vehicle may drive, 0 if a crossing vehicle is already in its colision box.
+     */
+    float SimulationHandler::findCrossingDistance(const std::shared_ptr<Vehicle>& vehicle, float distance) const
+    {
+        sf::Vector2f position = vehicle->getShape().getPosition();
+        const AABB colision_box = vehicle->getColisionBoxAt(position);
+        int direction = getDirectionIndex(vehicle->direction_);
+        for (const std::shared_ptr<Vehicle>& other : this->vehicles_) {
+            const AABB& other_shape = other->getShape();
+            if (other->direction_ == vehicle->direction_ || other_shape.getPosition() == position) {
+                continue;
+            }
+            bool is_beside = direction < 2 ? std::max(colision_box.left_, other_shape.left_) < std::min(colision_box.right_, other_shape.right_)
+                                           : std::max(colision_box.top_, other_shape.top_) < std::min(colision_box.bottom_, other_shape.bottom_);
+            if (!is_beside) {
+                continue;
+            }
+            if (colision_box.intersects(other_shape)) {
+                return 0;
+            }
+            const float gaps[4] = {colision_box.top_ - other_shape.bottom_, other_shape.top_ - colision_box.bottom_,
+                                   other_shape.left_ - colision_box.right_, colision_box.left_ - other_shape.right_};
+            if (gaps[direction] >= 0) {
+                distance = std::min(distance, gaps[direction]);
+            }
+        }
+        return distance;
+    }
+
+    /**
+     * Method moving the vehicle along its lane cell by cell: it stops at every border of a cell, checks which cell
+     * it entered and turns there, like a vehicle driving small steps would. After a turn the vehicle goes to its new
+     * lane at once and the rest of the distance is cut to what is free in the new direction. A vehicle which entered
+     * an exit site stays there until it is deleted, so it does not turn back before deleteVehicles finds it.
+     * @param vehicle - Vehicle to move.
+     * @param distance - Distance in whole world units.
+     * @return - Distance the vehicle drove.
+     */
+    int SimulationHandler::driveThroughCells(const std::shared_ptr<Vehicle>& vehicle, int distance)
+    {
+        int driven = 0;
+        vehicle->speed_ = 0;
+        if (distance == 0 || this->isInExitSite(vehicle)) {
+            vehicle->move();
+            return 0;
+        }
+        while (driven < distance) {
+            int direction = getDirectionIndex(vehicle->direction_);
+            int cell_exit_distance = vehicle->getCellExitDistance();
+            vehicle->speed_ = std::min(distance - driven, cell_exit_distance);
+            vehicle->move();
+            driven += vehicle->speed_;
+            if (vehicle->speed_ < cell_exit_distance) {
+                break;
+            }
+            vehicle->checkOnWhichCell();
+            if (this->isInExitSite(vehicle)) {
+                break;
+            }
             vehicle->checkTurn();
-            this->checkCameraVision();
+            if (getDirectionIndex(vehicle->direction_) != direction) {
+                vehicle->speed_ = 0;
+                vehicle->move();
+                float leader_speed = 0;
+                float free = std::min(this->findLeader(vehicle, leader_speed), this->findCrossingDistance(vehicle, static_cast<float>(distance - driven)));
+                distance = driven + static_cast<int>(free);
+            }
+        }
+        return driven;
+    }
+
+    /**
+     * Method which applies the model chosen by setCarFollowing since the previous tick. Vehicles are woken up, so
+     * event-driven moving checks all of them again, and CarFollowing is created with speeds of vehicles as they are,
+     * or removed when car following is turned off.
+     */
+    void SimulationHandler::updateCarFollowing()
+    {
+        bool is_car_following;
+        {
+            std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+            if (!this->isCarFollowingChanged_) {
+                return;
+            }
+            is_car_following = this->isCarFollowingRequested_;
+            this->isCarFollowingChanged_ = false;
+        }
+        if (is_car_following == this->isCarFollowing_) {
+            return;
+        }
+        this->isCarFollowing_ = is_car_following;
+        this->wakeVehicles();
+        if (!is_car_following) {
+            this->carFollowing_.reset();
+            return;
+        }
+        this->carFollowing_ = std::make_unique<CarFollowing>(2 * this->getMaxVehicles());
+        for (const std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
+            vehicle->velocity_ = vehicle->speed_;
+            vehicle->travelled_ = 0;
+        }
+    }
+
+    /**
+     * Method which applies changes of hybrid simulation made since the previous tick: it creates the queue model when
+     * hybrid simulation starts, marks roads simulated in detail and removes the queue model when simulation is not
+     * hybrid anymore and every queued vehicle was promoted. A road is detailed if it is at most one cell away from the
+     * detailed area or from a camera, or if it belongs to the enter road.
+     */
+    void SimulationHandler::updateQueueModel()
+    {
+        bool is_hybrid;
+        bool is_changed;
+        AABB area;
+        {
+            std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+            is_hybrid = this->isHybrid_ && !this->isCellularAutomaton_;
+            is_changed = this->isDetailedAreaChanged_;
+            area = this->detailedArea_;
+            this->isDetailedAreaChanged_ = false;
+        }
+        if (this->queueModel_ && !is_hybrid && this->queueModel_->getVehiclesCount() == 0) {
+            this->queueModel_.reset();
+        }
+        if (!this->queueModel_) {
+            if (!is_hybrid || this->roads_.empty()) {
+                return;
+            }
+            this->queueModel_ = std::make_unique<QueueModel>(this->roads_, this->cellSize_, this->parameters_.vehicleSpeed_, this->getMaxVehicles(), this->ticksCount_);
+            is_changed = true;
+        }
+        if (!is_changed) {
+            return;
+        }
+        bool has_area = area.right_ > area.left_ && area.bottom_ > area.top_;
+        AABB detailed_area = expandBox(area, this->cellSize_);
+        for (std::size_t i = 0; i < this->roads_.size(); i++) {
+            bool is_detailed = !is_hybrid || static_cast<int>(i) < this->enterRoadsCount_ || i + 2 >= this->roads_.size()
+                || (has_area && detailed_area.intersects(this->roads_[i]));
+            for (std::size_t j = 0; j < this->cameras_.size() && !is_detailed; j++) {
+                is_detailed = expandBox(this->cameras_[j].getDetectionBox(), this->cellSize_).intersects(this->roads_[i]);
+            }
+            this->queueModel_->setDetailed(i, is_detailed);
+        }
+    }
+
+    /**
+     * Method which demotes vehicles standing in their lanes on roads which are not detailed to queued vehicles.
+     */
+    void SimulationHandler::demoteVehicles()
+    {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+            if (!this->demoteVehicle(this->vehicles_[i])) {
+                if (kept != i) {
+                    this->vehicles_[kept] = std::move(this->vehicles_[i]);
+                }
+                kept++;
+            }
+        }
+        this->vehicles_.erase(this->vehicles_.begin() + kept, this->vehicles_.end());
+    }
+
+    /**
+     * Method which demotes the vehicle to queued vehicle if it stands in its lane on a road which is not detailed and
+     * its link has room. The queued vehicle reaches the end of the link when the vehicle would reach the edge of the
+     * road at full speed, and the vehicle goes back to its pool.
+     * @param vehicle - Vehicle to demote.
+     * @return - True if the vehicle was demoted, false otherwise.
+     */
+    bool SimulationHandler::demoteVehicle(std::shared_ptr<Vehicle>& vehicle)
+    {
+        if (!vehicle->previousRoad_ || vehicle->currentRoad_->getPosition() != vehicle->previousRoad_->getPosition() || !vehicle->isInLane()) {
+            return false;
+        }
+        int road = vehicle->currentRoad_ - this->roads_.data();
+        sf::Vector2f position = vehicle->getShape().getPosition();
+        if (this->queueModel_->isDetailed(road) || !vehicle->currentRoad_->contains(position)) {
+            return false;
+        }
+        int direction = getDirectionIndex(vehicle->direction_);
+        const AABB& box = *vehicle->currentRoad_;
+        const float distances[4] = {position.y - box.top_, box.bottom_ - position.y, box.right_ - position.x, position.x - box.left_};
+        int speed = std::max(vehicle->maxSpeed_, 1);
+        QueuedVehicle queued = {this->ticksCount_ + static_cast<std::uint64_t>(std::ceil(distances[direction] / speed)), vehicle->spawnTick_, vehicle->isTruck()};
+        if (!this->queueModel_->push(road, direction, queued)) {
+            return false;
         }
+        vehicle->stopSleeping();
+        vehicle->wakeSleepers(this->ticksCount_);
+        std::vector<std::shared_ptr<Vehicle>>& pool = vehicle->isTruck() ? this->trucksPool_ : this->carsPool_;
+        pool.push_back(std::move(vehicle));
+        return true;
     }
 
     /**
-     * Method responsible for checking vehicles colisions with other vehicles.
+     * Method which promotes queued vehicle to vehicle taken from pool, if it does not overlap any vehicle and its
+     * colision box is free. The vehicle stands in its lane, and if it comes from another road it chooses where to go
+     * in its first tick, like a vehicle which has just entered the road.
+     * @param queued - Queued vehicle.
+     * @param road - Index of the road of the vehicle.
+     * @param from_road - Index of the road from which the vehicle comes, the same as road if it does not change road.
+     * @param direction - Index of direction of the vehicle.
+     * @param position - Position of the vehicle.
+     * @return - True if the vehicle was promoted, false if there is no room for it.
      */
-    void SimulationHandler::vehiclesColision()
+    bool SimulationHandler::promoteVehicle(const QueuedVehicle& queued, int road, int from_road, int direction, sf::Vector2f position)
     {
-        for (std::shared_ptr<Vehicle> vehicle : this->vehicles_) {
-            int colision_counter = 0;
-            for (std::shared_ptr<Vehicle> colider : this->vehicles_) {
-                if (vehicle->checkColision(colider)) {
-                    colision_counter++;
+        std::vector<std::shared_ptr<Vehicle>>& pool = queued.isTruck_ ? this->trucksPool_ : this->carsPool_;
+        if (pool.empty()) {
+            return false;
+        }
+        std::shared_ptr<Vehicle>& vehicle = pool.back();
+        vehicle->reset(static_cast<int>(position.x), static_cast<int>(position.y), directionNames[direction], 0);
+        vehicle->currentRoad_ = &this->roads_[road];
+        vehicle->speed_ = 0;
+        vehicle->move();
+        vehicle->move();
+        for (const std::shared_ptr<Vehicle>& other : this->vehicles_) {
+            if (other->getShape().intersects(vehicle->getShape()) || other->getShape().intersects(vehicle->colisionBox_)) {
+                return false;
+            }
+        }
+        vehicle->currentRoad_ = &this->roads_[from_road];
+        vehicle->previousRoad_ = vehicle->currentRoad_;
+        vehicle->speed_ = vehicle->maxSpeed_;
+        vehicle->spawnTick_ = queued.spawnTick_;
+        vehicle->engine_.seed(queued.spawnTick_ * 2654435761u + this->ticksCount_);
+        this->vehicles_.push_back(std::move(vehicle));
+        pool.pop_back();
+        return true;
+    }
+
+    /**
+     * Method which applies the model of traffic chosen since the previous tick. It creates the cellular automaton when
+     * it is chosen and moves Vehicle objects into it. When Vehicle objects are chosen again, vehicles of the automaton
+     * are promoted where they stand, like queued vehicles, and the automaton is removed when it is empty. Vehicles
+     * shown in place of vehicles of the automaton go back to their pools first.
+     */
+    void SimulationHandler::updateAutomaton()
+    {
+        bool is_cellular_automaton;
+        {
+            std::lock_guard<std::mutex> lock(this->detailedAreaMutex_);
+            is_cellular_automaton = this->isCellularAutomaton_;
+        }
+        for (std::shared_ptr<Vehicle>& vehicle : this->automatonVehicles_) {
+            std::vector<std::shared_ptr<Vehicle>>& pool = vehicle->isTruck() ? this->trucksPool_ : this->carsPool_;
+            pool.push_back(std::move(vehicle));
+        }
+        this->automatonVehicles_.clear();
+        this->isAutomatonActive_ = false;
+        if (!this->automaton_) {
+            if (!is_cellular_automaton || this->roads_.empty()) {
+                return;
+            }
+            this->automaton_ = std::make_unique<CellularAutomaton>(this->roads_, this->cameras_, this->cityExitSite_, this->cellSize_,
+                this->roadSize_ / 2 + this->roadStripesSize_, this->parameters_.vehicleSpeed_, this->parameters_.unblockTicks_,
+                this->getMaxVehicles(), this->ticksCount_);
+            this->automatonVehicles_.reserve(this->getMaxVehicles());
+        }
+        if (is_cellular_automaton) {
+            this->isAutomatonActive_ = true;
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < this->vehicles_.size(); i++) {
+                std::shared_ptr<Vehicle>& vehicle = this->vehicles_[i];
+                if (this->automaton_->add(vehicle->getShape().getPosition(), getDirectionIndex(vehicle->direction_), vehicle->isTruck(), vehicle->spawnTick_)) {
+                    vehicle->stopSleeping();
+                    vehicle->wakeSleepers(this->ticksCount_);
+                    std::vector<std::shared_ptr<Vehicle>>& pool = vehicle->isTruck() ? this->trucksPool_ : this->carsPool_;
+                    pool.push_back(std::move(vehicle));
+                    continue;
+                }
+                if (kept != i) {
+                    this->vehicles_[kept] = std::move(vehicle);
                 }
+                kept++;
             }
-            if (colision_counter > 0) {
-                vehicle->stopVehicle();
+            this->vehicles_.erase(this->vehicles_.begin() + kept, this->vehicles_.end());
+            return;
+        }
+        for (std::size_t i = this->automaton_->getVehiclesCount(); i-- > 0;) {
+            QueuedVehicle queued = {0, this->automaton_->getSpawnTick(i), this->automaton_->isTruck(i)};
+            int road = this->automaton_->getRoad(i);
+            if (this->promoteVehicle(queued, road, road, this->automaton_->getDirection(i), this->automaton_->getPosition(i))) {
+                for (const Camera& camera : this->cameras_) {
+                    this->vehicles_.back()->seenByCamera_[camera.cameraNumber_-1] = camera.checkColision(this->vehicles_.back());
+                }
+                this->automaton_->remove(i);
+            }
+        }
+        if (this->automaton_->getVehiclesCount() == 0) {
+            this->automaton_.reset();
+        }
+    }
+
+    /**
+     * Method which makes one tick of the cellular automaton, if it is used: cameras count vehicles which entered
+     * their roads and vehicles which reached exit sites leave the city.
+     */
+    void SimulationHandler::tickAutomaton()
+    {
+        if (!this->automaton_) {
+            return;
+        }
+        this->automaton_->tick(this->ticksCount_);
+        for (const std::pair<int, bool>& sighting : this->automaton_->getSightings()) {
+            if (sighting.second) {
+                this->notifyTrucksLabel(sighting.first);
             }
             else {
-                vehicle->noColision();
+                this->notifyCarsLabel(sighting.first);
             }
         }
+        for (std::uint64_t spawn_tick : this->automaton_->getExitedSpawnTicks()) {
+            Metrics::instance().record(Metric::VehicleLifetime, this->ticksCount_ - spawn_tick);
+            this->exitedVehiclesCount_++;
+            this->exitedVehiclesTicks_ += this->ticksCount_ - spawn_tick;
+        }
     }
 
     /**
-     * Method responsible for checking what do cameras see.
+     * Method which notifies observers about vehicles while the cellular automaton is used. When the simulation is
+     * shown, vehicles from pools are put in sites of vehicles of the automaton, so the map view draws them like
+     * Vehicle objects; they go back to pools in the next tick.
      */
-    void SimulationHandler::checkCameraVision()
+    void SimulationHandler::notifyAutomatonVehicles()
     {
-        for (Camera camera : this->cameras_) {
-            this->checkCameraColision(camera);
+        if (this->isSimulating_) {
+            for (std::size_t i = 0; i < this->automaton_->getVehiclesCount(); i++) {
+                std::vector<std::shared_ptr<Vehicle>>& pool = this->automaton_->isTruck(i) ? this->trucksPool_ : this->carsPool_;
+                if (pool.empty()) {
+                    continue;
+                }
+                std::shared_ptr<Vehicle>& vehicle = pool.back();
+                sf::Vector2f position = this->automaton_->getPosition(i);
+                int direction = this->automaton_->getDirection(i);
+                vehicle->reset(static_cast<int>(position.x), static_cast<int>(position.y), directionNames[direction], 0);
+                vehicle->rotation_ = direction < 2 ? 0 : 90;
+                this->automatonVehicles_.push_back(std::move(vehicle));
+                pool.pop_back();
+            }
         }
+        std::size_t shown = this->automatonVehicles_.size();
+        this->automatonVehicles_.insert(this->automatonVehicles_.end(), this->vehicles_.begin(), this->vehicles_.end());
+        this->notifyVehicles(this->automatonVehicles_);
+        this->automatonVehicles_.resize(shown);
     }
 
     /**
-     * Method responsible for checking if camera sees the car.
-     * @param camera - Camera object which the method is checking.s
+     * Method responsible for checking vehicle colisions with other vehicles. Shapes of vehicles are read from packed
+     * arrays, which moveVehicles keeps up to date.
+     * @param vehicle - Vehicle which is going to move.
+     * @return - First vehicle which stops the vehicle, nullptr if there is none.
      */
-    void SimulationHandler::checkCameraColision(Camera camera)
+    Vehicle* SimulationHandler::vehicleColision(const std::shared_ptr<Vehicle>& vehicle)
     {
+        ZPR_PROFILE_SCOPE(Collision);
+        std::size_t colider = this->packedVehicles_.findColision(vehicle->colisionBox_, vehicle->getShape().getPosition());
+        return colider < this->vehicles_.size() ? this->vehicles_[colider].get() : nullptr;
+    }
 
-        for (std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
-            if (camera.checkColision(vehicle)) {
-                this->checkVehicleTypeAndNotify(vehicle, camera.cameraNumber_);
-                vehicle->seenByCamera_[camera.cameraNumber_-1] = true;
+    /**
+     * Method which puts the vehicle stopped by another one to sleep, if nothing but the blocker can change what
+     * happens to it: it stands in its lane in the middle of its road and its colision box stays where it was checked,
+     * so until the blocker moves it only counts ticks of waiting. It sleeps on the wake list of the blocker and is woken when the blocker moves or leaves the city,
+     * or in the tick in which it waited long enough to turn back.
+     * @param vehicle - Vehicle which has just been checked and stopped.
+     * @param blocker - Vehicle which stopped it.
+     * @param colision_box - Colision box with which the vehicle was checked.
+     * @return - True if the vehicle sleeps, false if it has to be checked as usual.
+     */
+    bool SimulationHandler::sleepVehicle(const std::shared_ptr<Vehicle>& vehicle, Vehicle& blocker, const AABB& colision_box)
+    {
+        sf::Vector2f position = vehicle->getShape().getPosition();
+        if (!vehicle->previousRoad_ || vehicle->currentRoad_->getPosition() != vehicle->previousRoad_->getPosition()
+            || !vehicle->currentRoad_->contains(position) || !vehicle->isInLane()
+            || vehicle->colisionBox_ != colision_box || vehicle->colisionBox_ != vehicle->getColisionBoxAt(position)) {
+            return false;
+        }
+        std::uint64_t wake_tick = std::numeric_limits<std::uint64_t>::max();
+        if (vehicle->stopCounter_ < vehicle->unblockTicks_) {
+            wake_tick = this->ticksCount_ + vehicle->unblockTicks_ - vehicle->stopCounter_ + 1;
+        }
+        else if (vehicle->canTurnBack()) {
+            return false;
+        }
+        vehicle->sleepOn(blocker, wake_tick);
+        return true;
+    }
+
+    /**
+     * Method which wakes every vehicle, so that each of them is checked in the next tick.
+     */
+    void SimulationHandler::wakeVehicles()
+    {
+        for (const std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
+            vehicle->stopSleeping();
+            vehicle->wakeSleepers(0);
+            vehicle->wakeTick_ = 0;
+        }
+    }
+
+    /**
+     * Method returning in how many ticks the vehicle has to be checked again. Until then it keeps its lane and speed
+     * and goes only through straight roads, so its position in roads and in detection boxes of cameras is known in
+     * advance, and its colision box, which follows the vehicle one move late, sweeps known part of the lane. Other
+     * vehicles sweep their lanes as well until the tick in which they may leave straight roads, saved when they were
+     * checked; vehicles which may turn in that time, and vehicles which may appear at starting positions, are assumed
+     * to move up to two cells and four times their speed per tick in any direction.
+     * @param vehicle - Vehicle which has just moved and was checked.
+     * @return - Number of ticks after which the vehicle is checked again, 1 if it has to be checked in the next tick.
+     */
+    int SimulationHandler::getQuietTicks(const std::shared_ptr<Vehicle>& vehicle) const
+    {
+        if (vehicle->speed_ == 0 || vehicle->speed_ != vehicle->maxSpeed_ || this->queueModel_) {
+            return 1;
+        }
+        sf::Vector2f position = vehicle->getShape().getPosition();
+        sf::Vector2f step = vehicle->getStep();
+        int quiet_ticks = vehicle->straightUntilTick_ - this->ticksCount_;
+        for (const Camera& camera : this->cameras_) {
+            quiet_ticks = std::min(quiet_ticks, getStepsBeforeCrossing(camera.getDetectionBox(), position, step) + 1);
+        }
+        if (quiet_ticks < EVENTS_MIN_QUIET_TICKS) {
+            return 1;
+        }
+        AABB next_colision_box = vehicle->getColisionBoxAt(position);
+        auto is_reachable = [&](const AABB& region, int ticks) {
+            return ticks > 1 && (region.intersects(vehicle->colisionBox_) || region.intersects(sweepBox(next_colision_box, step, ticks - 2)));
+        };
+        auto limit = [&](auto get_region) {
+            if (!is_reachable(get_region(quiet_ticks), quiet_ticks)) {
+                return;
             }
-            else {
-                vehicle->seenByCamera_[camera.cameraNumber_-1] = false;
+            int low = EVENTS_MIN_QUIET_TICKS;
+            if (is_reachable(get_region(low), low)) {
+                quiet_ticks = 1;
+                return;
             }
+            while (quiet_ticks - low > 1) {
+                int middle = (low + quiet_ticks) / 2;
+                (is_reachable(get_region(middle), middle) ? quiet_ticks : low) = middle;
+            }
+            quiet_ticks = low;
+        };
+        int reach = 2 * this->cellSize_;
+        int speed = 4 * std::max(this->parameters_.vehicleSpeed_, 1);
+        for (bool is_east : {false, true}) {
+            AABB start = AABB::fromCenter(this->getStartingPosition(is_east).x, this->getStartingPosition(is_east).y, 0, 0);
+            limit([&](int ticks) {
+                return expandBox(start, reach + speed * ticks);
+            });
         }
+        for (const std::shared_ptr<Vehicle>& other : this->vehicles_) {
+            if (quiet_ticks < EVENTS_MIN_QUIET_TICKS) {
+                return 1;
+            }
+            if (other == vehicle || !is_reachable(expandBox(other->getShape(), reach + speed * quiet_ticks), quiet_ticks)) {
+                continue;
+            }
+            int straight_moves = other->straightUntilTick_ > this->ticksCount_ ? other->straightUntilTick_ - this->ticksCount_ : 0;
+            limit([&](int ticks) {
+                return ticks <= straight_moves ? expandBox(sweepBox(other->getShape(), other->getStep(), ticks), 1)
+                                               : expandBox(other->getShape(), reach + speed * ticks);
+            });
+        }
+        return quiet_ticks < EVENTS_MIN_QUIET_TICKS ? 1 : quiet_ticks;
     }
 
     /**
-     * Method responsible for checking if vehicle is a car or truck and notify proper labels.
+     * Method returning how many next moves of the vehicle surely only move it forward in its lane: before them it goes
+     * only through straight roads, so it neither turns nor turns back, and it does not wait long enough to turn back.
      * @param vehicle - Vehicle to check.
-     * @param camera_label_number - Label number to update.
+     * @return - Number of moves, 0 if even the next one may move the vehicle to another lane.
      */
-    void SimulationHandler::checkVehicleTypeAndNotify(std::shared_ptr<Vehicle> vehicle, int camera_label_number)
+    int SimulationHandler::getStraightMoves(const std::shared_ptr<Vehicle>& vehicle) const
     {
-        if (!vehicle->seenByCamera_[camera_label_number-1]) {
-            if (vehicle->getShape().getSize().x == vehicle->getShape().getSize().y)
-                this->notifyCarsLabel(camera_label_number);
-            
-            else
-                this->notifyTrucksLabel(camera_label_number);
-            
+        if (!vehicle->previousRoad_ || vehicle->currentRoad_->getPosition() != vehicle->previousRoad_->getPosition()) {
+            return 0;
+        }
+        sf::Vector2f position = vehicle->getShape().getPosition();
+        if (!vehicle->currentRoad_->contains(position) || !vehicle->isInLane()) {
+            return 0;
+        }
+        int direction = getDirectionIndex(vehicle->direction_);
+        AABB straight_roads = *vehicle->currentRoad_;
+        float* edges[4] = {&straight_roads.top_, &straight_roads.bottom_, &straight_roads.right_, &straight_roads.left_};
+        *edges[direction] = this->straightRoadsEnds_[vehicle->currentRoad_ - this->roads_.data()][direction];
+        const sf::Vector2f steps[4] = {sf::Vector2f(0, -1), sf::Vector2f(0, 1), sf::Vector2f(1, 0), sf::Vector2f(-1, 0)};
+        int moves = getStepsBeforeCrossing(straight_roads, position, steps[direction] * static_cast<float>(vehicle->maxSpeed_)) + 1;
+        return std::max(std::min(moves, vehicle->unblockTicks_ - vehicle->stopCounter_), 0);
+    }
+
+    /**
+     * Method responsible for checking which cameras see the vehicle. It remembers which ones see it, so every camera
+     * counts the vehicle once while it passes.
+     * @param cameras - Cameras of the map.
+     * @param vehicle - Vehicle which has just moved.
+     * @return - Bit mask of cameras which see the vehicle for the first time, bit n - 1 for camera number n.
+     */
+    unsigned SimulationHandler::checkCameraVision(const std::vector<Camera>& cameras, const std::shared_ptr<Vehicle>& vehicle)
+    {
+        ZPR_PROFILE_SCOPE(CameraVision);
+        unsigned sightings = 0;
+        for (const Camera& camera : cameras) {
+            bool& seen = vehicle->seenByCamera_[camera.cameraNumber_ - 1];
+            bool is_seen = camera.checkColision(vehicle);
+            if (is_seen && !seen) {
+                sightings |= 1u << (camera.cameraNumber_ - 1);
+            }
+            seen = is_seen;
+        }
+        return sightings;
+    }
+
+    /**
+     * Method responsible for notifying labels of cameras which saw a car or a truck for the first time.
+     * @param sightings - Bit mask of cameras returned by checkCameraVision.
+     * @param is_truck - True if the vehicle is a truck.
+     */
+    void SimulationHandler::notifySightings(unsigned sightings, bool is_truck)
+    {
+        for (int camera_number = 1; sightings != 0; camera_number++, sightings >>= 1) {
+            if (!(sightings & 1u)) {
+                continue;
+            }
+            if (is_truck) {
+                this->notifyTrucksLabel(camera_number);
+            }
+            else {
+                this->notifyCarsLabel(camera_number);
+            }
         }
     }
 
@@ -256,8 +1523,8 @@ namespace zpr {
      */
     bool SimulationHandler::startingCellFree()
     {
-        for (std::shared_ptr<Vehicle> vehicle : this->vehicles_) {
-            if (this->roads_.back().getGlobalBounds().contains(vehicle->getShape().getPosition()) || this->roads_.at(this->roads_.size()-2).getGlobalBounds().contains(vehicle->getShape().getPosition())) {
+        for (const std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
+            if (this->roads_.back().contains(vehicle->getShape().getPosition()) || this->roads_.at(this->roads_.size()-2).contains(vehicle->getShape().getPosition())) {
                 return false;
             }   
         }
@@ -265,21 +1532,56 @@ namespace zpr {
     }
 
     /**
-     * Method responsible for deleting the vehicles.
+     * Method responsible for deleting the vehicles. Deleted vehicle goes back to its pool.
      */
     void SimulationHandler::deleteVehicles()
     {
+        ZPR_PROFILE_SCOPE(DeleteVehicles);
         int i = 0;
-        for (std::shared_ptr<Vehicle> vehicle : this->vehicles_) {
-            for (sf::RectangleShape exit_site : this->cityExitSite_) {
-                if (exit_site.getGlobalBounds().contains(vehicle->getShape().getPosition())) {
-                    this->vehicles_.erase(vehicles_.begin() + i);
-                    return;
-                }
+        for (std::shared_ptr<Vehicle>& vehicle : this->vehicles_) {
+            if (this->isInExitSite(vehicle)) {
+                Metrics::instance().record(Metric::VehicleLifetime, this->ticksCount_ - vehicle->spawnTick_);
+                this->exitedVehiclesCount_++;
+                this->exitedVehiclesTicks_ += this->ticksCount_ - vehicle->spawnTick_;
+                vehicle->stopSleeping();
+                vehicle->wakeSleepers(this->ticksCount_);
+                std::vector<std::shared_ptr<Vehicle>>& pool = vehicle->isTruck() ? this->trucksPool_ : this->carsPool_;
+                pool.push_back(std::move(vehicle));
+                this->vehicles_.erase(vehicles_.begin() + i);
+                return;
             }
             i++;
         }
-        this->notifyVehicles(this->vehicles_);
+    }
+
+    /**
+     * Method checking if the vehicle is in one of exit sites of the city.
+     * @param vehicle - Vehicle to check.
+     * @return - True if the vehicle is in an exit site, false otherwise.
+     */
+    bool SimulationHandler::isInExitSite(const std::shared_ptr<Vehicle>& vehicle) const
+    {
+        for (const AABB& exit_site : this->cityExitSite_) {
+            if (exit_site.contains(vehicle->getShape().getPosition())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Method notifying observers about vehicles after the tick, to be drawn.
+     */
+    void SimulationHandler::notifySnapshot()
+    {
+        ZPR_PROFILE_SCOPE(NotifyVehicles);
+        ScopedMetric notify_metric(Metric::NotifyLatency);
+        if (this->automaton_) {
+            this->notifyAutomatonVehicles();
+        }
+        else {
+            this->notifyVehicles(this->vehicles_);
+        }
     }
     
     /**
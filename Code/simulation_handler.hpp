@@ -8,10 +8,24 @@
 #include "observers/cameras_observer.hpp"
 #include "observers/creator_observer.hpp"
 #include "vehicles/vehicle_factory.hpp"
+#include "vehicles/vehicle_store.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <cstdint>
 #include "components/timer.hpp"
 #include "components/cell.hpp"
+#include "components/chunked_grid.hpp"
 #include "components/camera.hpp"
+#include "components/simulation_parameters.hpp"
+#include "components/tile_scheduler.hpp"
+#include "components/queue_model.hpp"
+#include "components/cellular_automaton.hpp"
+#include "components/car_following.hpp"
+#include "components/packed_vehicles.hpp"
 #include "helpers/converter.hpp"
 #include "helpers/spawn_points.hpp"
 
@@ -24,7 +38,66 @@ namespace zpr {
     class SimulationHandler : public SimulationSubject, public CamerasObserver, public CreatorObserver{
     public:
         SimulationHandler(int grid_size);
+        ~SimulationHandler();
         void init();
+        void setSeed(unsigned seed);
+        void setParameters(const SimulationParameters& parameters);
+        void setThreadsCount(int threads);
+        void setEventDriven(bool is_event_driven);
+        void setCarFollowing(bool is_car_following);
+        void setTimeStep(float time_step);
+        void setMortonOrder(bool is_morton_order);
+        void setTimeScale(int time_scale);
+        int getTimeScale() const;
+        static int getNextTimeScale(int time_scale);
+        void setHybrid(bool is_hybrid);
+        void setDetailedArea(const AABB& area);
+        std::size_t getQueuedVehiclesCount() const;
+        void setCellularAutomaton(bool is_cellular_automaton);
+        std::size_t getAutomatonVehiclesCount() const;
+        const SimulationParameters& getParameters() const;
+        std::uint64_t getExitedVehiclesCount() const;
+        std::uint64_t getExitedVehiclesTicks() const;
+        std::uint64_t getTicksCount() const;
+        void prepareSimulation();
+        void prepareRoads();
+        const std::vector<AABB>& getRoads() const;
+        const std::vector<Camera>& getCameras() const;
+        const std::vector<AABB>& getExitSites() const;
+        const std::vector<std::shared_ptr<Vehicle>>& getVehicles() const;
+        std::shared_ptr<Vehicle> getVehicle(std::uint32_t handle) const;
+        std::size_t getMaxVehicles() const;
+        sf::Vector2i getStartingPosition(bool is_east) const;
+        static int drawSpawn(std::mt19937& engine, const SimulationParameters& parameters);
+        static unsigned checkCameraVision(const std::vector<Camera>& cameras, const std::shared_ptr<Vehicle>& vehicle);
+
+        /**
+         * Template method making one step of the vehicle, used by every way of moving vehicles one by one, also by
+         * processes of ShardedRunner, so all of them move vehicles the same way.
+         * @param vehicle - Vehicle to move.
+         * @param cameras - Cameras of the map.
+         * @param check_colision - Function called after the vehicle found its cell, returning true if the vehicle is
+         * going to hit another one.
+         * @return - Cameras which see the vehicle for the first time, as in checkCameraVision.
+         */
+        template <typename Colision>
+        static unsigned moveVehicle(const std::shared_ptr<Vehicle>& vehicle, const std::vector<Camera>& cameras, Colision check_colision) {
+            vehicle->checkOnWhichCell();
+            if (check_colision()) {
+                vehicle->stopVehicle();
+            }
+            else {
+                vehicle->noColision();
+            }
+            vehicle->move();
+            vehicle->checkVehicleStopped();
+            vehicle->unblockVehicle();
+            vehicle->checkTurn();
+            return checkCameraVision(cameras, vehicle);
+        }
+
+        void tick(bool is_snapshot = true);
+        void runTicks();
         void updateIsSimulating();
         void updateCells(std::vector<Cell> cells);
         void updateEnterCells(std::vector<Cell> enter_cells);
@@ -33,26 +106,72 @@ namespace zpr {
     private:
         Timer startSimulationTimer_, clearDataTimer_;
         void addCarsToSimulate();
+        void spawnVehicle(std::vector<std::shared_ptr<Vehicle>>& pool, int x, int y, const std::string& direction);
+        void sortVehicles();
         void moveVehicles();
-        void vehiclesColision();
-        void checkCameraVision();
-        void checkCameraColision(Camera camera);
-        void checkVehicleTypeAndNotify(std::shared_ptr<Vehicle> vehicle, int camera_number);
+        void moveVehiclesOnTiles();
+        void moveVehiclesFollowing();
+        float findLeader(const std::shared_ptr<Vehicle>& vehicle, float& leader_speed) const;
+        float findCrossingDistance(const std::shared_ptr<Vehicle>& vehicle, float distance) const;
+        int driveThroughCells(const std::shared_ptr<Vehicle>& vehicle, int distance);
+        void updateCarFollowing();
+        void updateQueueModel();
+        void demoteVehicles();
+        bool demoteVehicle(std::shared_ptr<Vehicle>& vehicle);
+        bool promoteVehicle(const QueuedVehicle& queued, int road, int from_road, int direction, sf::Vector2f position);
+        void updateAutomaton();
+        void tickAutomaton();
+        void notifyAutomatonVehicles();
+        Vehicle* vehicleColision(const std::shared_ptr<Vehicle>& vehicle);
+        bool sleepVehicle(const std::shared_ptr<Vehicle>& vehicle, Vehicle& blocker, const AABB& colision_box);
+        void wakeVehicles();
+        int getQuietTicks(const std::shared_ptr<Vehicle>& vehicle) const;
+        int getStraightMoves(const std::shared_ptr<Vehicle>& vehicle) const;
+        void notifySightings(unsigned sightings, bool is_truck);
         bool startingCellFree();
         void deleteVehicles();
+        bool isInExitSite(const std::shared_ptr<Vehicle>& vehicle) const;
+        void notifySnapshot();
+        void prepareStraightRoads();
         void separateUserRoadsFromCells();
         void separateRoadsFromCells(Cell& cell);
         void separateEnterRoadsFromCells();
         void separateCamerasFromCells();
-        bool isSimulating_;
+        bool isSimulating_, isEventDriven_, isHybrid_, isDetailedAreaChanged_, isCellularAutomaton_, isAutomatonActive_, isCarFollowing_,
+            isCarFollowingRequested_, isCarFollowingChanged_, isMortonOrder_;
+        float timeStep_;
+        std::atomic<int> timeScale_;
+        double ticksOwed_;
+        std::uint64_t speedUpTicks_;
+        std::chrono::steady_clock::time_point lastRunTime_, speedUpStart_;
         int gridSize_, cellSize_;
+        int enterRoadsCount_;
+        std::uint64_t ticksCount_;
+        std::uint64_t exitedVehiclesCount_, exitedVehiclesTicks_;
+        SimulationParameters parameters_;
         int roadSize_, sidewalkSize_, roadStripesSize_;
-        std::vector<sf::RectangleShape> cityExitSite_;
-        std::vector<Cell> cells_, enterCells_;
-        std::vector<sf::RectangleShape> roads_;
+        std::vector<AABB> cityExitSite_;
+        std::unique_ptr<ChunkedGrid> grid_;
+        std::vector<Cell> enterCells_;
+        std::vector<AABB> roads_;
         std::vector<Camera> cameras_;
+        std::vector<std::array<int, 4>> straightRoads_;
+        std::vector<std::array<float, 4>> straightRoadsEnds_;
         std::vector<std::shared_ptr<Vehicle>> vehicles_;
+        std::shared_ptr<VehicleStore> vehicleStore_;
+        std::vector<std::shared_ptr<Vehicle>> carsPool_, trucksPool_, sortedVehicles_;
+        std::vector<std::pair<std::uint32_t, std::size_t>> mortonOrder_;
+        std::mt19937 engine_;
         std::unique_ptr<Converter> converter_;
         std::unique_ptr<SpawnPoints> spawnPoints_;
+        std::unique_ptr<TileScheduler> tileScheduler_;
+        std::unique_ptr<QueueModel> queueModel_;
+        std::unique_ptr<CellularAutomaton> automaton_;
+        std::unique_ptr<CarFollowing> carFollowing_;
+        PackedVehicles packedVehicles_;
+        std::vector<std::shared_ptr<Vehicle>> automatonVehicles_;
+        AABB detailedArea_;
+        std::mutex detailedAreaMutex_;
+        std::vector<std::vector<std::pair<unsigned, bool>>> sightings_;
     };
 }
@@ -5,6 +5,8 @@
 
 #include "simulator.hpp"
 #include "states/splash_state.hpp"
+#include "profiling/tracer.hpp"
+#include "profiling/metrics.hpp"
 
 namespace zpr{
 
@@ -28,8 +30,11 @@ namespace zpr{
         float new_time, frame_time, interpolation;
         float current_time = this->clock_.getElapsedTime().asSeconds();
         float accumulator = 0.0f;
+        Tracer::instance().setThreadName("Render loop");
     
         while(this->data_->window_.isOpen()){
+            ZPR_TRACE_SCOPE("Frame");
+            ScopedMetric frame_metric(Metric::FrameDuration);
             this->data_->machine_.processStateChanges();
         
             new_time = this-> clock_.getElapsedTime().asSeconds();
@@ -0,0 +1,49 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/aabb.hpp"
+#include "SFML/Graphics.hpp"
+#include <boost/test/unit_test.hpp>
+
+struct AABBFixture {
+    AABBFixture()
+    {
+        box_ = zpr::AABB::fromCenter(25, 25, 50, 50);
+    }
+    zpr::AABB box_;
+    ~AABBFixture() = default;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AABBTest, AABBFixture)
+
+BOOST_AUTO_TEST_CASE(AABB_positionAndSize)
+{
+    BOOST_CHECK_EQUAL(25, box_.getPosition().x);
+    BOOST_CHECK_EQUAL(25, box_.getPosition().y);
+    BOOST_CHECK_EQUAL(50, box_.getSize().x);
+    BOOST_CHECK_EQUAL(50, box_.getSize().y);
+}
+
+BOOST_AUTO_TEST_CASE(AABB_containsLikeSfmlRect)
+{
+    sf::FloatRect rect(0, 0, 50, 50);
+    std::vector<sf::Vector2f> points = { {0, 0}, {49.5f, 10}, {50, 10}, {10, 50}, {-1, 10}, {25, 25} };
+    for (sf::Vector2f point : points) {
+        BOOST_CHECK_EQUAL(rect.contains(point), box_.contains(point));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AABB_touchingBoxesDoNotIntersect)
+{
+    BOOST_CHECK_EQUAL(false, box_.intersects(zpr::AABB(50, 0, 60, 50)));
+    BOOST_CHECK_EQUAL(true, box_.intersects(zpr::AABB(49, 0, 60, 50)));
+    BOOST_CHECK_EQUAL(false, box_.intersects(zpr::AABB(0, 50, 50, 60)));
+}
+
+BOOST_AUTO_TEST_CASE(AABB_movingCenterKeepsSize)
+{
+    box_.moveCenterTo(100, -100);
+    BOOST_CHECK_EQUAL(100, box_.getPosition().x);
+    BOOST_CHECK_EQUAL(-100, box_.getPosition().y);
+    BOOST_CHECK(box_ == zpr::AABB(75, -125, 125, -75));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
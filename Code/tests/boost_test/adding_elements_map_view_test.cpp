@@ -55,13 +55,13 @@ BOOST_AUTO_TEST_CASE(AddingHelperTest_add_3_roads)
 BOOST_AUTO_TEST_CASE(AddingHelperTest_centeredPositionOfRoadX)
 {
     road_ = addingHelper_->addElement(roadName_, sf::Vector2i(1, -2));
-    BOOST_CHECK_EQUAL(97, road_.getPosition().x);
+    BOOST_CHECK_EQUAL(76, road_.getPosition().x);
 }
 
 BOOST_AUTO_TEST_CASE(AddingHelperTest_centeredPositionOfRoadY)
 {
     road_ = addingHelper_->addElement(roadName_, sf::Vector2i(1, -2));
-    BOOST_CHECK_EQUAL(-89, road_.getPosition().y);
+    BOOST_CHECK_EQUAL(-77, road_.getPosition().y);
 }
 BOOST_AUTO_TEST_CASE(AddingHelperTest_sizeOfRoad)
 {
@@ -0,0 +1,75 @@
+/**
+ * allocation_counter.cpp
+ * Implementation of functions counting allocations made by tests. Every form of operator new and operator delete
+ * is replaced here, in pairs, so memory is always allocated and freed the same way.
+ */
+
+#include "allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<bool> countAllocations(false);
+    std::atomic<long> allocationsCount(0);
+}
+
+namespace zpr {
+    namespace test {
+
+        /**
+         * Function starting counting allocations from zero.
+         */
+        void startCountingAllocations()
+        {
+            allocationsCount = 0;
+            countAllocations = true;
+        }
+
+        /**
+         * Function stopping counting allocations.
+         * @return - Number of allocations made since counting started.
+         */
+        long stopCountingAllocations()
+        {
+            countAllocations = false;
+            return allocationsCount.load();
+        }
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations) {
+        allocationsCount++;
+    }
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
@@ -0,0 +1,13 @@
+/**
+ * allocation_counter.hpp
+ * Header of functions counting allocations made by tests.
+ */
+
+#pragma once
+
+namespace zpr {
+    namespace test {
+        void startCountingAllocations();
+        long stopCountingAllocations();
+    }
+}
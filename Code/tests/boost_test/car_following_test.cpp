@@ -0,0 +1,76 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/car_following.hpp"
+#include <boost/test/unit_test.hpp>
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE(CarFollowingTest)
+
+BOOST_AUTO_TEST_CASE(CarFollowing_vehicleSpeedsUpSmoothlyOnFreeRoad)
+{
+    zpr::CarFollowing car_following(1);
+    car_following.resize(1);
+    float speed = 0;
+    for (int tick = 0; tick < 200; tick++) {
+        car_following.setVehicle(0, speed, VEHICLE_SPEED, std::numeric_limits<float>::max(), 0);
+        car_following.update(1);
+        BOOST_REQUIRE_GE(car_following.getSpeed(0), speed);
+        BOOST_REQUIRE_LE(car_following.getSpeed(0) - speed, IDM_ACCELERATION + 1e-6f);
+        speed = car_following.getSpeed(0);
+    }
+    BOOST_CHECK_CLOSE(speed, static_cast<float>(VEHICLE_SPEED), 5.0f);
+}
+
+BOOST_AUTO_TEST_CASE(CarFollowing_vehicleStopsBehindStandingLeaderWithAnyTimeStep)
+{
+    for (float time_step : {0.5f, 1.0f, IDM_MAX_TIME_STEP}) {
+        zpr::CarFollowing car_following(1);
+        car_following.resize(1);
+        float speed = VEHICLE_SPEED;
+        float gap = 100;
+        for (float time = 0; time < 1000; time += time_step) {
+            car_following.setVehicle(0, speed, VEHICLE_SPEED, gap, 0);
+            car_following.update(time_step);
+            BOOST_REQUIRE_GE(car_following.getSpeed(0), 0);
+            BOOST_REQUIRE_LE(car_following.getDistance(0), gap);
+            speed = car_following.getSpeed(0);
+            gap -= car_following.getDistance(0);
+        }
+        BOOST_CHECK_LT(speed, 0.01f);
+        BOOST_CHECK_GE(gap, 0);
+        BOOST_CHECK_LE(gap, IDM_MIN_GAP + 0.5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CarFollowing_followerMatchesLeaderSpeedWithoutOscillating)
+{
+    zpr::CarFollowing car_following(2);
+    car_following.resize(2);
+    float leader_position = 60, follower_position = 0;
+    float leader_speed = 0, follower_speed = 0;
+    float previous_gap = leader_position - follower_position;
+    int gap_direction_changes = 0;
+    float previous_change = 0;
+    for (int tick = 0; tick < 2000; tick++) {
+        car_following.setVehicle(0, leader_speed, VEHICLE_SPEED / 2.0f, std::numeric_limits<float>::max(), 0);
+        car_following.setVehicle(1, follower_speed, VEHICLE_SPEED, leader_position - follower_position, leader_speed);
+        car_following.update(IDM_MAX_TIME_STEP);
+        leader_position += car_following.getDistance(0);
+        follower_position += car_following.getDistance(1);
+        leader_speed = car_following.getSpeed(0);
+        follower_speed = car_following.getSpeed(1);
+        float gap = leader_position - follower_position;
+        BOOST_REQUIRE_GE(gap, 0);
+        float change = gap - previous_gap;
+        if (std::abs(change) > 1e-2f && previous_change * change < 0) {
+            gap_direction_changes++;
+        }
+        if (std::abs(change) > 1e-2f) {
+            previous_change = change;
+        }
+        previous_gap = gap;
+    }
+    BOOST_CHECK_CLOSE(follower_speed, VEHICLE_SPEED / 2.0f, 1.0f);
+    BOOST_CHECK_LE(gap_direction_changes, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/cellular_automaton.hpp"
+#include <boost/test/unit_test.hpp>
+#include <set>
+
+namespace {
+
+    std::vector<zpr::AABB> createStraightRoad(int length)
+    {
+        std::vector<zpr::AABB> roads;
+        for (int i = 0; i < length; i++) {
+            roads.push_back(zpr::AABB::fromCenter(WORLD_CELL_SIZE * i + WORLD_CELL_SIZE / 2.f, WORLD_CELL_SIZE / 2.f, WORLD_CELL_SIZE, WORLD_CELL_SIZE));
+        }
+        return roads;
+    }
+
+    sf::Vector2f getRoadStart(const zpr::AABB& road)
+    {
+        return sf::Vector2f(road.left_ + 1, road.getPosition().y + 10);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(CellularAutomatonTest)
+
+BOOST_AUTO_TEST_CASE(CellularAutomaton_vehicleDrivesForwardAndTurnsBackAtDeadEnd)
+{
+    std::vector<zpr::AABB> roads = createStraightRoad(4);
+    zpr::CellularAutomaton automaton(roads, {}, {}, WORLD_CELL_SIZE, 10, VEHICLE_SPEED, VEHICLE_UNBLOCK_TICKS, 10, 0);
+    BOOST_REQUIRE(automaton.add(getRoadStart(roads[0]), 2, false, 1));
+    BOOST_CHECK(!automaton.add(getRoadStart(roads[0]), 2, false, 1));
+    float previous_x = automaton.getPosition(0).x;
+    std::uint64_t tick = 1;
+    for (; tick < 1000 && automaton.getDirection(0) == 2; tick++) {
+        automaton.tick(tick);
+        float x = automaton.getPosition(0).x;
+        if (automaton.getDirection(0) != 2) {
+            break;
+        }
+        BOOST_REQUIRE_GE(x, previous_x);
+        BOOST_REQUIRE_LE(x - previous_x, CA_MAX_SPEED * WORLD_CELL_SIZE / static_cast<float>(CA_CELL_SITES));
+        previous_x = x;
+    }
+    BOOST_CHECK_EQUAL(3, automaton.getDirection(0));
+    BOOST_CHECK_EQUAL(3, automaton.getRoad(0));
+    BOOST_CHECK_GE(tick, static_cast<std::uint64_t>(4 * CA_CELL_SITES / CA_MAX_SPEED * automaton.getStepTicks()));
+}
+
+BOOST_AUTO_TEST_CASE(CellularAutomaton_vehiclesNeverShareSite)
+{
+    std::vector<zpr::AABB> roads = createStraightRoad(3);
+    zpr::CellularAutomaton automaton(roads, {}, {}, WORLD_CELL_SIZE, 10, VEHICLE_SPEED, VEHICLE_UNBLOCK_TICKS, 20, 0);
+    for (int i = 0; i < CA_CELL_SITES; i++) {
+        BOOST_REQUIRE(automaton.add(getRoadStart(roads[1]) + sf::Vector2f(i * WORLD_CELL_SIZE / CA_CELL_SITES, 0), 2, i % 2 == 0, 1));
+    }
+    for (std::uint64_t tick = 1; tick < 2000; tick++) {
+        automaton.tick(tick);
+        std::set<std::pair<float, float>> positions;
+        for (std::size_t i = 0; i < automaton.getVehiclesCount(); i++) {
+            positions.emplace(automaton.getPosition(i).x, automaton.getPosition(i).y);
+        }
+        BOOST_REQUIRE_EQUAL(static_cast<std::size_t>(CA_CELL_SITES), positions.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CellularAutomaton_camerasCountAndExitSitesRemoveVehicles)
+{
+    std::vector<zpr::AABB> roads = createStraightRoad(3);
+    std::vector<zpr::Camera> cameras = {zpr::Camera(2, roads[1])};
+    std::vector<zpr::AABB> exit_sites = {roads[2]};
+    zpr::CellularAutomaton automaton(roads, cameras, exit_sites, WORLD_CELL_SIZE, 10, VEHICLE_SPEED, VEHICLE_UNBLOCK_TICKS, 10, 0);
+    BOOST_REQUIRE(automaton.add(getRoadStart(roads[0]), 2, true, 7));
+    std::vector<std::pair<int, bool>> sightings;
+    std::vector<std::uint64_t> exited;
+    for (std::uint64_t tick = 1; tick < 1000 && exited.empty(); tick++) {
+        automaton.tick(tick);
+        sightings.insert(sightings.end(), automaton.getSightings().begin(), automaton.getSightings().end());
+        exited = automaton.getExitedSpawnTicks();
+    }
+    BOOST_REQUIRE_EQUAL(1u, sightings.size());
+    BOOST_CHECK_EQUAL(2, sightings[0].first);
+    BOOST_CHECK(sightings[0].second);
+    BOOST_REQUIRE_EQUAL(1u, exited.size());
+    BOOST_CHECK_EQUAL(7u, exited[0]);
+    BOOST_CHECK_EQUAL(0u, automaton.getVehiclesCount());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
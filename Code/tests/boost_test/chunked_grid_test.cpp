@@ -0,0 +1,76 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/cell.hpp"
+#include "../../components/chunked_grid.hpp"
+#include "../../definitions.hpp"
+#include <boost/test/unit_test.hpp>
+
+struct ChunkedGridFixture {
+    ChunkedGridFixture()
+    {
+        grid_ = std::make_unique<zpr::ChunkedGrid>(gridSize_);
+    }
+    std::unique_ptr<zpr::ChunkedGrid> grid_;
+    int gridSize_ = 4096;
+    ~ChunkedGridFixture() = default;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ChunkedGridTest, ChunkedGridFixture)
+
+BOOST_AUTO_TEST_CASE(ChunkedGrid_noChunksAtStart)
+{
+    BOOST_CHECK_EQUAL(4096 / GRID_CHUNK_SIZE, grid_->getChunksPerSide());
+    BOOST_CHECK_EQUAL(0, grid_->getAllocatedChunksCount());
+    BOOST_CHECK(grid_->findCell(100, 100) == nullptr);
+    BOOST_CHECK_EQUAL(false, grid_->containsRoad(100, 100));
+}
+
+BOOST_AUTO_TEST_CASE(ChunkedGrid_writingAllocatesOneChunk)
+{
+    grid_->getCell(4000, 17).containsRoad_ = true;
+    BOOST_CHECK_EQUAL(1, grid_->getAllocatedChunksCount());
+    BOOST_CHECK_EQUAL(true, grid_->containsRoad(4000, 17));
+    BOOST_CHECK_EQUAL(false, grid_->containsRoad(4000, 18));
+    BOOST_CHECK_EQUAL(4000, grid_->getCell(4000, 17).getPosition().x);
+    BOOST_CHECK_EQUAL(17, grid_->getCell(4000, 17).getPosition().y);
+}
+
+BOOST_AUTO_TEST_CASE(ChunkedGrid_occupiedCells)
+{
+    grid_->getCell(0, 4).isStartingCell_ = true;
+    grid_->getCell(1, 4).containsRoad_ = true;
+    grid_->getCell(3000, 3000).containsCamera_ = true;
+    std::vector<zpr::Cell> occupied = grid_->getOccupiedCells();
+    BOOST_CHECK_EQUAL(3, occupied.size());
+    BOOST_CHECK_EQUAL(2, grid_->getAllocatedChunksCount());
+}
+
+BOOST_AUTO_TEST_CASE(ChunkedGrid_buildingFromDenseCells)
+{
+    std::vector<zpr::Cell> cells;
+    for (int i = 0; i < 16 * 16; i++) {
+        cells.push_back(zpr::Cell(i / 16, i % 16));
+    }
+    cells.at(20).containsRoad_ = true;
+    zpr::ChunkedGrid grid(cells, 16);
+    BOOST_CHECK_EQUAL(1, grid.getAllocatedChunksCount());
+    BOOST_CHECK_EQUAL(true, grid.containsRoad(1, 4));
+    BOOST_CHECK_EQUAL(1, grid.getOccupiedCells().size());
+}
+
+BOOST_AUTO_TEST_CASE(ChunkedGrid_releasingEmptyChunks)
+{
+    grid_->getCell(70, 70).containsRoad_ = true;
+    grid_->getCell(200, 200).containsRoad_ = true;
+    grid_->getCell(70, 70).containsRoad_ = false;
+    grid_->releaseEmptyChunks();
+    BOOST_CHECK_EQUAL(1, grid_->getAllocatedChunksCount());
+    BOOST_CHECK(grid_->findCell(70, 70) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ChunkedGrid_outOfRange)
+{
+    BOOST_CHECK_THROW(grid_->getCell(4096, 0), std::out_of_range);
+    BOOST_CHECK(grid_->findCell(-1, 0) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../helpers/city_generator.hpp"
+#include <boost/test/unit_test.hpp>
+#include <queue>
+#include <sstream>
+
+namespace {
+
+    /**
+     * Function counting roads which can be reached from the starting cell.
+     */
+    std::int64_t countReachableRoads(const zpr::CityGenerator& generator, int grid_size)
+    {
+        std::vector<bool> visited(grid_size * grid_size, false);
+        std::queue<sf::Vector2i> queue;
+        queue.push(sf::Vector2i(0, 4));
+        visited[4] = true;
+        std::int64_t count = 0;
+        while (!queue.empty()) {
+            sf::Vector2i cell = queue.front();
+            queue.pop();
+            count++;
+            const sf::Vector2i steps[] = {sf::Vector2i(-1, 0), sf::Vector2i(1, 0), sf::Vector2i(0, -1), sf::Vector2i(0, 1)};
+            for (const sf::Vector2i& step : steps) {
+                sf::Vector2i next = cell + step;
+                if (next.x >= 0 && next.y >= 0 && next.x < grid_size && next.y < grid_size
+                    && !visited[next.x * grid_size + next.y] && generator.containsRoad(next.x, next.y)) {
+                    visited[next.x * grid_size + next.y] = true;
+                    queue.push(next);
+                }
+            }
+        }
+        return count;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(CityGeneratorTest)
+
+BOOST_AUTO_TEST_CASE(CityGenerator_manhattanGrid)
+{
+    zpr::CityGenerator generator(16, 1);
+    generator.addManhattanGrid(3);
+    BOOST_CHECK(generator.containsRoad(0, 0));
+    BOOST_CHECK(generator.containsRoad(4, 7));
+    BOOST_CHECK(generator.containsRoad(9, 8));
+    BOOST_CHECK(!generator.containsRoad(1, 1));
+    BOOST_CHECK(!generator.containsRoad(5, 6));
+    BOOST_CHECK_EQUAL(16 * 16 - 12 * 12, generator.getRoadsCount());
+}
+
+BOOST_AUTO_TEST_CASE(CityGenerator_spanningTreeIsConnectedTree)
+{
+    zpr::CityGenerator generator(33, 7);
+    generator.addSpanningTree(4);
+    generator.connectEntrance();
+    BOOST_CHECK_EQUAL(generator.getRoadsCount(), countReachableRoads(generator, 33));
+    int nodes = 9 * 9;
+    BOOST_CHECK_EQUAL(nodes + (nodes - 1) * 3, generator.getRoadsCount());
+}
+
+BOOST_AUTO_TEST_CASE(CityGenerator_sameSeedSameMap)
+{
+    zpr::CityGenerator first(64, 2021), second(64, 2021), other(64, 2022);
+    for (zpr::CityGenerator* generator : {&first, &second, &other}) {
+        generator->addSpanningTree(3);
+        generator->addRingRoad(10);
+        generator->addArterials(2);
+        generator->connectEntrance();
+        generator->placeCameras(3);
+    }
+    std::ostringstream first_map, second_map, other_map;
+    first.write(first_map);
+    second.write(second_map);
+    other.write(other_map);
+    BOOST_CHECK(first_map.str() == second_map.str());
+    BOOST_CHECK(first_map.str() != other_map.str());
+}
+
+BOOST_AUTO_TEST_CASE(CityGenerator_entranceIsConnected)
+{
+    zpr::CityGenerator generator(32, 3);
+    generator.addRingRoad(2);
+    generator.connectEntrance();
+    BOOST_CHECK(generator.containsRoad(0, 4));
+    BOOST_CHECK(generator.containsRoad(1, 4));
+    BOOST_CHECK(!generator.containsRoad(3, 4));
+    BOOST_CHECK_EQUAL(4 * 27 + 2, generator.getRoadsCount());
+    BOOST_CHECK_EQUAL(generator.getRoadsCount(), countReachableRoads(generator, 32));
+}
+
+BOOST_AUTO_TEST_CASE(CityGenerator_camerasOnDifferentRoads)
+{
+    zpr::CityGenerator generator(32, 5);
+    generator.addManhattanGrid(4);
+    generator.placeCameras(5);
+    std::vector<zpr::Cell> cells = generator.getCells();
+    int cameras = 0;
+    for (const zpr::Cell& cell : cells) {
+        BOOST_CHECK(cell.containsRoad_);
+        if (cell.containsCamera_) {
+            cameras++;
+            BOOST_CHECK(cell.whichCamera_ >= 1 && cell.whichCamera_ <= CAMERAS_COUNT);
+        }
+    }
+    BOOST_CHECK_EQUAL(CAMERAS_COUNT, cameras);
+    BOOST_CHECK_EQUAL(generator.getRoadsCount(), cells.size());
+}
+
+BOOST_AUTO_TEST_CASE(CityGenerator_savedMapFormat)
+{
+    zpr::CityGenerator generator(8, 1);
+    generator.addManhattanGrid(2);
+    std::stringstream stream;
+    generator.write(stream);
+    int grid_size;
+    stream >> grid_size;
+    BOOST_CHECK_EQUAL(8, grid_size);
+    zpr::Cell cell;
+    int cells_count = 0;
+    while (stream >> cell) {
+        BOOST_CHECK_EQUAL(cells_count / 8, cell.getPosition().x);
+        BOOST_CHECK_EQUAL(cells_count % 8, cell.getPosition().y);
+        BOOST_CHECK_EQUAL(generator.containsRoad(cell.getPosition().x, cell.getPosition().y), cell.containsRoad_);
+        cells_count++;
+    }
+    BOOST_CHECK_EQUAL(64, cells_count);
+    std::unique_ptr<zpr::ChunkedGrid> grid = generator.createGrid();
+    BOOST_CHECK(grid->containsRoad(3, 5));
+    BOOST_CHECK(!grid->containsRoad(1, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../helpers/command_line.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+
+struct CommandLineFixture {
+    CommandLineFixture()
+    {
+        unsetenv("ZPR_COMMAND_LINE_TEST");
+    }
+    char program_[21] = "CityTrafficSimulator";
+    char option_[8] = "--trace";
+    char path_[11] = "trace.json";
+    char joined_[19] = "--trace=other.json";
+    ~CommandLineFixture()
+    {
+        unsetenv("ZPR_COMMAND_LINE_TEST");
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(CommandLineTest, CommandLineFixture)
+
+BOOST_AUTO_TEST_CASE(CommandLine_separateValue)
+{
+    char* arguments[] = {program_, option_, path_};
+    BOOST_CHECK_EQUAL("trace.json", zpr::CommandLine::getOptionValue(3, arguments, "--trace", "ZPR_COMMAND_LINE_TEST"));
+}
+
+BOOST_AUTO_TEST_CASE(CommandLine_joinedValue)
+{
+    char* arguments[] = {program_, joined_};
+    BOOST_CHECK_EQUAL("other.json", zpr::CommandLine::getOptionValue(2, arguments, "--trace", "ZPR_COMMAND_LINE_TEST"));
+}
+
+BOOST_AUTO_TEST_CASE(CommandLine_optionWithoutValue)
+{
+    char* arguments[] = {program_, option_};
+    BOOST_CHECK_EQUAL("", zpr::CommandLine::getOptionValue(2, arguments, "--trace", "ZPR_COMMAND_LINE_TEST"));
+}
+
+BOOST_AUTO_TEST_CASE(CommandLine_environmentVariable)
+{
+    char* arguments[] = {program_};
+    setenv("ZPR_COMMAND_LINE_TEST", "env.json", 1);
+    BOOST_CHECK_EQUAL("env.json", zpr::CommandLine::getOptionValue(1, arguments, "--trace", "ZPR_COMMAND_LINE_TEST"));
+    char* with_option[] = {program_, option_, path_};
+    BOOST_CHECK_EQUAL("trace.json", zpr::CommandLine::getOptionValue(3, with_option, "--trace", "ZPR_COMMAND_LINE_TEST"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
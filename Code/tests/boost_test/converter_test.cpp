@@ -66,4 +66,30 @@ BOOST_AUTO_TEST_CASE(ConverterTest_convertingUserCell)
     BOOST_CHECK_EQUAL(283, tempCell_.getPosition().x);
     BOOST_CHECK_EQUAL(35, tempCell_.getPosition().y);
 }
+BOOST_AUTO_TEST_CASE(ConverterTest_worldUnitsForBigGrid)
+{
+    zpr::Converter world_converter(4096, WORLD_CELL_SIZE);
+    BOOST_CHECK_EQUAL(WORLD_CELL_SIZE, world_converter.getCellSize());
+    BOOST_CHECK_EQUAL(0, world_converter.calculatePrefix());
+    tempCell_ = world_converter.convertCellToCenteredRectShape(zpr::Cell(4000, 3), "User");
+    BOOST_CHECK_EQUAL(4000 * WORLD_CELL_SIZE + WORLD_CELL_SIZE / 2, tempCell_.getPosition().x);
+    BOOST_CHECK_EQUAL(3 * WORLD_CELL_SIZE + WORLD_CELL_SIZE / 2, tempCell_.getPosition().y);
+}
+BOOST_AUTO_TEST_CASE(ConverterTest_pixelCellSizeNeverZero)
+{
+    zpr::Converter big_converter(4096);
+    BOOST_CHECK_EQUAL(1, big_converter.getCellSize());
+    BOOST_CHECK_EQUAL(0, big_converter.calculatePrefix());
+}
+BOOST_AUTO_TEST_CASE(ConverterTest_mortonCode)
+{
+    zpr::Converter world_converter(64, WORLD_CELL_SIZE);
+    BOOST_CHECK_EQUAL(0u, world_converter.getMortonCode(sf::Vector2f(0.5f * WORLD_CELL_SIZE, 0.5f * WORLD_CELL_SIZE)));
+    BOOST_CHECK_EQUAL(1u, world_converter.getMortonCode(sf::Vector2f(1.5f * WORLD_CELL_SIZE, 0.5f * WORLD_CELL_SIZE)));
+    BOOST_CHECK_EQUAL(2u, world_converter.getMortonCode(sf::Vector2f(0.5f * WORLD_CELL_SIZE, 1.5f * WORLD_CELL_SIZE)));
+    BOOST_CHECK_EQUAL(3u, world_converter.getMortonCode(sf::Vector2f(1.5f * WORLD_CELL_SIZE, 1.5f * WORLD_CELL_SIZE)));
+    BOOST_CHECK_EQUAL(4u, world_converter.getMortonCode(sf::Vector2f(2.5f * WORLD_CELL_SIZE, 0.5f * WORLD_CELL_SIZE)));
+    BOOST_CHECK_EQUAL(0u, world_converter.getMortonCode(sf::Vector2f(-0.5f * WORLD_CELL_SIZE, -3.0f * WORLD_CELL_SIZE)));
+    BOOST_CHECK_EQUAL(4095u, world_converter.getMortonCode(sf::Vector2f(100.0f * WORLD_CELL_SIZE, 63.5f * WORLD_CELL_SIZE)));
+}
 BOOST_AUTO_TEST_SUITE_END()
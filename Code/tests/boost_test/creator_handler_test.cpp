@@ -0,0 +1,70 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../creator_handler.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Observer remembering cells and cameras it was notified about.
+     */
+    class CellsRecorder : public zpr::CreatorObserver {
+    public:
+        void updateCells(std::vector<zpr::Cell> cells) override
+        {
+            cells_ = cells;
+        }
+        void updateCameraAdded(int /*which_camera*/, int /*row*/, int /*col*/) override
+        {
+            camerasAdded_++;
+        }
+        int countCells(sf::Vector2i position) const
+        {
+            return std::count_if(cells_.begin(), cells_.end(), [&](const zpr::Cell& cell) {
+                return cell.getPosition() == position;
+            });
+        }
+        std::vector<zpr::Cell> cells_;
+        int camerasAdded_ = 0;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(CreatorHandlerTest)
+
+BOOST_AUTO_TEST_CASE(CreatorHandler_deletedRoadIsSentOnceAndLeavesCellEmpty)
+{
+    zpr::CreatorHandler creator(64);
+    std::shared_ptr<CellsRecorder> recorder = std::make_shared<CellsRecorder>();
+    creator.add(recorder);
+    creator.init();
+    creator.updateIsDrawingRoad();
+    creator.handleInput(sf::Vector2i(40, 40));
+    creator.updateIsDeletingRoad();
+    creator.handleInput(sf::Vector2i(40, 40));
+
+    BOOST_REQUIRE_EQUAL(1, recorder->countCells(sf::Vector2i(40, 40)));
+    const zpr::Cell& deleted_cell = recorder->cells_.back();
+    BOOST_CHECK(deleted_cell.toDelete_);
+    BOOST_CHECK(!deleted_cell.containsRoad_);
+
+    creator.updateIsDrawingRoad();
+    creator.handleInput(sf::Vector2i(2, 2));
+
+    BOOST_CHECK_EQUAL(0, recorder->countCells(sf::Vector2i(40, 40)));
+    BOOST_CHECK_EQUAL(1, recorder->countCells(sf::Vector2i(2, 2)));
+}
+
+BOOST_AUTO_TEST_CASE(CreatorHandler_cameraIsNotAddedOnEmptyCell)
+{
+    zpr::CreatorHandler creator(64);
+    std::shared_ptr<CellsRecorder> recorder = std::make_shared<CellsRecorder>();
+    creator.add(recorder);
+    creator.init();
+    creator.updateIsAddingCamera(1);
+    creator.handleInput(sf::Vector2i(50, 50));
+
+    BOOST_CHECK_EQUAL(0, recorder->camerasAdded_);
+    BOOST_CHECK_EQUAL(0, recorder->countCells(sf::Vector2i(50, 50)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,7 +30,7 @@ BOOST_FIXTURE_TEST_SUITE(DeletingHelperTest, DeletingHelperFixture)
 
 BOOST_AUTO_TEST_CASE(DeletingHelperTest_sizeOfRoadsVector)
 {
-    road_.setPosition(sf::Vector2f(97,-89));
+    road_.setPosition(sf::Vector2f(76,-77));
     roads_.push_back(road_);
     BOOST_CHECK_EQUAL(1, roads_.size());
     deletingHelper_->deleteRoad(sf::Vector2i(1, -2), roads_);
@@ -0,0 +1,85 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/executor.hpp"
+#include "../../components/timer.hpp"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(ExecutorTest)
+
+BOOST_AUTO_TEST_CASE(Executor_taskGroupRunsEveryTask)
+{
+    std::atomic<int> count(0);
+    zpr::TaskGroup task_group;
+    for (int i = 0; i < 1000; i++) {
+        task_group.run([&]() {
+            count++;
+        });
+    }
+    task_group.wait();
+    BOOST_CHECK_EQUAL(1000, count.load());
+}
+
+BOOST_AUTO_TEST_CASE(Executor_nestedGroupsDoNotBlockWorkers)
+{
+    std::atomic<int> count(0);
+    zpr::TaskGroup task_group;
+    for (int i = 0; i < 4 * zpr::Executor::instance().getWorkersCount(); i++) {
+        task_group.run([&]() {
+            zpr::TaskGroup inner_group;
+            for (int j = 0; j < 10; j++) {
+                inner_group.run([&]() {
+                    count++;
+                });
+            }
+            inner_group.wait();
+        });
+    }
+    task_group.wait();
+    BOOST_CHECK_EQUAL(40 * zpr::Executor::instance().getWorkersCount(), count.load());
+}
+
+BOOST_AUTO_TEST_CASE(Executor_waitThrowsExceptionOfTask)
+{
+    zpr::TaskGroup task_group;
+    task_group.run([]() {
+        throw std::runtime_error("task failed");
+    });
+    BOOST_CHECK_THROW(task_group.wait(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Executor_stoppedTimerDoesNotRun)
+{
+    std::atomic<int> count(0);
+    zpr::Timer timer, stopped_timer;
+    timer.setTimeout([&]() {
+        count++;
+    }, 1);
+    stopped_timer.setTimeout([&]() {
+        count += 100;
+    }, 20);
+    stopped_timer.stopTimer();
+    for (int i = 0; i < 500 && count.load() == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    BOOST_CHECK_EQUAL(1, count.load());
+}
+
+BOOST_AUTO_TEST_CASE(Executor_stopTimerWaitsForRunningFunction)
+{
+    std::atomic<bool> started(false), finished(false);
+    zpr::Timer timer;
+    timer.setInterval([&]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    }, 1);
+    while (!started.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    timer.stopTimer();
+    BOOST_CHECK(finished.load());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
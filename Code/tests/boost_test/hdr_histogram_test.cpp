@@ -0,0 +1,66 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../profiling/hdr_histogram.hpp"
+#include <boost/test/unit_test.hpp>
+
+struct HdrHistogramFixture {
+    HdrHistogramFixture() = default;
+    zpr::HdrHistogram histogram_;
+    ~HdrHistogramFixture() = default;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HdrHistogramTest, HdrHistogramFixture)
+
+BOOST_AUTO_TEST_CASE(HdrHistogram_emptyAtStart)
+{
+    BOOST_CHECK_EQUAL(0, histogram_.getCount());
+    BOOST_CHECK_EQUAL(0, histogram_.getMin());
+    BOOST_CHECK_EQUAL(0, histogram_.getMax());
+    BOOST_CHECK_EQUAL(0, histogram_.getValueAtPercentile(99.9));
+}
+
+BOOST_AUTO_TEST_CASE(HdrHistogram_smallValuesAreExact)
+{
+    for (int i = 1; i <= 100; i++) {
+        histogram_.record(i);
+    }
+    BOOST_CHECK_EQUAL(100, histogram_.getCount());
+    BOOST_CHECK_EQUAL(1, histogram_.getMin());
+    BOOST_CHECK_EQUAL(100, histogram_.getMax());
+    BOOST_CHECK_CLOSE(50.5, histogram_.getMean(), 0.001);
+    BOOST_CHECK_EQUAL(50, histogram_.getValueAtPercentile(50.0));
+    BOOST_CHECK_EQUAL(99, histogram_.getValueAtPercentile(99.0));
+    BOOST_CHECK_EQUAL(100, histogram_.getValueAtPercentile(100.0));
+}
+
+BOOST_AUTO_TEST_CASE(HdrHistogram_bigValuesWithinRelativeError)
+{
+    for (std::uint64_t i = 1; i <= 10000; i++) {
+        histogram_.record(i * 1000);
+    }
+    double p999 = histogram_.getValueAtPercentile(99.9);
+    BOOST_CHECK(p999 >= 9990000.0);
+    BOOST_CHECK(p999 <= 9990000.0 * (1.0 + 2.0 / zpr::HdrHistogram::SUB_BUCKETS_COUNT));
+    BOOST_CHECK_EQUAL(10000000, histogram_.getValueAtPercentile(100.0));
+}
+
+BOOST_AUTO_TEST_CASE(HdrHistogram_bucketsCoverWholeRange)
+{
+    for (std::uint64_t value : {std::uint64_t(0), std::uint64_t(127), std::uint64_t(128), std::uint64_t(129), std::uint64_t(1000000), zpr::HdrHistogram::MAX_VALUE}) {
+        int index = zpr::HdrHistogram::getBucketIndex(value);
+        BOOST_CHECK(index < zpr::HdrHistogram::BUCKETS_COUNT);
+        BOOST_CHECK(zpr::HdrHistogram::getHighestEquivalentValue(index) >= value);
+        if (index > 0) {
+            BOOST_CHECK(zpr::HdrHistogram::getHighestEquivalentValue(index - 1) < value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(HdrHistogram_valuesAboveRangeAreClamped)
+{
+    histogram_.record(zpr::HdrHistogram::MAX_VALUE * 4);
+    BOOST_CHECK_EQUAL(zpr::HdrHistogram::MAX_VALUE, histogram_.getMax());
+    histogram_.clear();
+    BOOST_CHECK_EQUAL(0, histogram_.getCount());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
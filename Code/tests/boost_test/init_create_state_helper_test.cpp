@@ -29,4 +29,9 @@ BOOST_AUTO_TEST_CASE(InitCreateStateHelperTest_ButtonTextToInt)
     BOOST_CHECK_EQUAL(16, helper_.getGridSizeFromButton(testButton1_));
 }
 
+BOOST_AUTO_TEST_CASE(InitCreateStateHelperTest_LargeGridButtonTextToInt)
+{
+    BOOST_CHECK_EQUAL(512, helper_.getGridSizeFromButton(zpr::Button("512x512")));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,7 +22,15 @@ BOOST_FIXTURE_TEST_SUITE(MapViewTest, MapViewTestFixture)
 
 BOOST_AUTO_TEST_CASE(MapView_CellSizeTest)
 {
-	BOOST_CHECK_EQUAL(SCREEN_HEIGHT / 16, mapView->getCellSize());
+	BOOST_CHECK_EQUAL(WORLD_CELL_SIZE, mapView->getCellSize());
+}
+
+BOOST_AUTO_TEST_CASE(MapView_VisibleAreaTest)
+{
+	zpr::AABB area = mapView->getVisibleArea();
+	BOOST_CHECK_CLOSE(1.4f * 16 * WORLD_CELL_SIZE, area.getSize().x, 0.001);
+	BOOST_CHECK(area.contains(sf::Vector2f(0.f, 0.f)));
+	BOOST_CHECK(area.contains(sf::Vector2f(16 * WORLD_CELL_SIZE - 1.f, 16 * WORLD_CELL_SIZE - 1.f)));
 }
 
 BOOST_AUTO_TEST_CASE(MapView_StartingRowAndColumn)
@@ -0,0 +1,71 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../profiling/metrics.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+struct MetricsFixture {
+    MetricsFixture()
+    {
+        zpr::Metrics::instance().stop();
+        zpr::Metrics::instance().clear();
+    }
+    ~MetricsFixture()
+    {
+        zpr::Metrics::instance().stop();
+        zpr::Metrics::instance().clear();
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(MetricsTest, MetricsFixture)
+
+BOOST_AUTO_TEST_CASE(Metrics_nothingRecordedWhenStopped)
+{
+    {
+        zpr::ScopedMetric metric(zpr::Metric::TickDuration);
+    }
+    zpr::Metrics::instance().record(zpr::Metric::VehicleLifetime, 10);
+    BOOST_CHECK_EQUAL(0, zpr::Metrics::instance().getHistogram(zpr::Metric::TickDuration).getCount());
+    BOOST_CHECK_EQUAL(0, zpr::Metrics::instance().getHistogram(zpr::Metric::VehicleLifetime).getCount());
+}
+
+BOOST_AUTO_TEST_CASE(Metrics_jsonLineWithEveryMetric)
+{
+    zpr::Metrics::instance().start("", METRICS_DUMP_INTERVAL);
+    {
+        zpr::ScopedMetric metric(zpr::Metric::NotifyLatency);
+    }
+    zpr::Metrics::instance().record(zpr::Metric::VehicleLifetime, 120);
+    BOOST_CHECK_EQUAL(1, zpr::Metrics::instance().getHistogram(zpr::Metric::NotifyLatency).getCount());
+
+    std::ostringstream stream;
+    zpr::Metrics::instance().writeJsonLine(stream);
+    std::string line = stream.str();
+    BOOST_CHECK_EQUAL(0, line.find("{\"time_s\":"));
+    BOOST_CHECK_EQUAL(line.size() - 2, line.find("}\n"));
+    BOOST_CHECK(line.find("\"tick_duration_ns\":{\"count\":0") != std::string::npos);
+    BOOST_CHECK(line.find("\"frame_duration_ns\":{\"count\":0") != std::string::npos);
+    BOOST_CHECK(line.find("\"notify_latency_ns\":{\"count\":1") != std::string::npos);
+    BOOST_CHECK(line.find("\"vehicle_lifetime_ticks\":{\"count\":1,\"min\":120") != std::string::npos);
+    BOOST_CHECK(line.find("\"p99_9\":120") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Metrics_stopAppendsLine)
+{
+    std::remove("metrics_test.jsonl");
+    zpr::Metrics::instance().start("metrics_test.jsonl", METRICS_DUMP_INTERVAL);
+    BOOST_CHECK(zpr::Metrics::instance().stop());
+    BOOST_CHECK(zpr::Metrics::instance().dump());
+    std::ifstream file("metrics_test.jsonl");
+    std::string line;
+    int lines = 0;
+    while (std::getline(file, line)) {
+        lines++;
+    }
+    BOOST_CHECK_EQUAL(2, lines);
+    file.close();
+    std::remove("metrics_test.jsonl");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
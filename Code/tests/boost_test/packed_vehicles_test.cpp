@@ -0,0 +1,84 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/packed_vehicles.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <random>
+
+namespace {
+
+    void fillRandom(zpr::PackedVehicles& avx2, zpr::PackedVehicles& scalar, std::size_t count, std::mt19937& engine)
+    {
+        std::uniform_int_distribution<int> coordinate(0, 40);
+        std::uniform_int_distribution<int> direction(0, 3);
+        std::uniform_real_distribution<float> speed(0, 3);
+        avx2.resize(count);
+        scalar.resize(count);
+        for (std::size_t i = 0; i < count; i++) {
+            zpr::AABB shape = zpr::AABB::fromCenter(coordinate(engine) * 1.5f, coordinate(engine) * 1.5f, 6, 13);
+            int vehicle_direction = direction(engine);
+            float vehicle_speed = speed(engine), lane = coordinate(engine) + 0.3f;
+            for (zpr::PackedVehicles* packed : {&avx2, &scalar}) {
+                packed->setShape(i, shape);
+                packed->setMove(i, vehicle_direction, vehicle_speed, lane);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(PackedVehiclesTest)
+
+BOOST_AUTO_TEST_CASE(PackedVehicles_findsFirstCollidingVehicleLikeAABB)
+{
+    zpr::PackedVehicles packed;
+    packed.setAvx2(false);
+    std::vector<zpr::AABB> shapes;
+    for (int i = 0; i < 20; i++) {
+        shapes.push_back(zpr::AABB::fromCenter(10.0f * i, 0, 6, 6));
+    }
+    packed.resize(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        packed.setShape(i, shapes[i]);
+    }
+    BOOST_CHECK_EQUAL(11u, packed.findColision(zpr::AABB(105, -1, 120, 1), sf::Vector2f(0, 0)));
+    BOOST_CHECK_EQUAL(12u, packed.findColision(zpr::AABB(105, -1, 120, 1), shapes[11].getPosition()));
+    BOOST_CHECK_EQUAL(20u, packed.findColision(zpr::AABB(103, -1, 107, 1), sf::Vector2f(0, 0)));
+    BOOST_CHECK_EQUAL(20u, packed.findColision(zpr::AABB(0, 3, 200, 5), sf::Vector2f(0, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(PackedVehicles_avx2CollisionsMatchScalar)
+{
+    std::mt19937 engine(2021);
+    zpr::PackedVehicles avx2, scalar;
+    scalar.setAvx2(false);
+    for (std::size_t count : {0u, 7u, 8u, 13u, 64u, 203u}) {
+        fillRandom(avx2, scalar, count, engine);
+        std::uniform_int_distribution<int> coordinate(0, 40);
+        for (int i = 0; i < 500; i++) {
+            zpr::AABB colision_box = zpr::AABB::fromCenter(coordinate(engine) * 1.5f, coordinate(engine) * 1.5f, 6, 3);
+            sf::Vector2f position = count > 0 && i % 2 ? scalar.getShape(i % count).getPosition() : colision_box.getPosition();
+            std::size_t expected = scalar.findColision(colision_box, position);
+            BOOST_REQUIRE_EQUAL(expected, avx2.findColision(colision_box, position));
+            if (expected < count) {
+                BOOST_REQUIRE(scalar.getShape(expected).intersects(colision_box));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PackedVehicles_avx2MovesAreBitwiseIdenticalToScalar)
+{
+    std::mt19937 engine(2021);
+    zpr::PackedVehicles avx2, scalar;
+    scalar.setAvx2(false);
+    fillRandom(avx2, scalar, 203, engine);
+    for (int i = 0; i < 1000; i++) {
+        avx2.move();
+        scalar.move();
+    }
+    for (std::size_t i = 0; i < scalar.getVehiclesCount(); i++) {
+        zpr::AABB avx2_shape = avx2.getShape(i), scalar_shape = scalar.getShape(i);
+        BOOST_REQUIRE_EQUAL(0, std::memcmp(&avx2_shape, &scalar_shape, sizeof(zpr::AABB)));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,37 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../profiling/perf_counters.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(PerfCountersTest)
+
+BOOST_AUTO_TEST_CASE(PerfCounters_readMatchesAvailability)
+{
+    zpr::PerfCounters& counters = zpr::PerfCounters::forThisThread();
+    zpr::CounterValues values;
+    values.fill(1);
+    BOOST_CHECK_EQUAL(counters.isAvailable(), counters.read(values));
+    BOOST_CHECK_EQUAL(counters.isAvailable(), counters.isAvailable(zpr::PerfCounter::Cycles));
+    if (!counters.isAvailable()) {
+        for (std::uint64_t value : values) {
+            BOOST_CHECK_EQUAL(0, value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PerfCounters_countersGrow)
+{
+    zpr::PerfCounters& counters = zpr::PerfCounters::forThisThread();
+    if (!counters.isAvailable()) {
+        return;
+    }
+    zpr::CounterValues before, after;
+    counters.read(before);
+    volatile int sum = 0;
+    for (int i = 0; i < 100000; i++) {
+        sum = sum + i;
+    }
+    counters.read(after);
+    BOOST_CHECK(after[static_cast<int>(zpr::PerfCounter::Cycles)] > before[static_cast<int>(zpr::PerfCounter::Cycles)]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
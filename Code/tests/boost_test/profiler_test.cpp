@@ -0,0 +1,105 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../profiling/profiler.hpp"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+struct ProfilerFixture {
+    ProfilerFixture()
+    {
+        zpr::Profiler::instance().clear();
+    }
+    ~ProfilerFixture()
+    {
+        zpr::Profiler::instance().clear();
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ProfilerTest, ProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(Profiler_noSamplesAtStart)
+{
+    BOOST_CHECK_EQUAL(0, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Tick).samples_);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_percentiles)
+{
+    for (int i = 1; i <= 100; i++) {
+        zpr::Profiler::instance().accumulate(zpr::ProfilerPhase::Tick, i * 1000);
+        zpr::Profiler::instance().commit(zpr::ProfilerPhase::Tick, zpr::ProfilerPhase::Tick);
+    }
+    zpr::PhaseStats stats = zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Tick);
+    BOOST_CHECK_EQUAL(100, stats.samples_);
+    BOOST_CHECK_CLOSE(50.0, stats.p50_, 0.001);
+    BOOST_CHECK_CLOSE(99.0, stats.p99_, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_accumulatingWithinOneTick)
+{
+    zpr::Profiler::instance().accumulate(zpr::ProfilerPhase::Collision, 1000);
+    zpr::Profiler::instance().accumulate(zpr::ProfilerPhase::Collision, 2000);
+    zpr::Profiler::instance().commit(zpr::ProfilerPhase::Tick, zpr::ProfilerPhase::NotifyVehicles);
+    BOOST_CHECK_EQUAL(1, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Collision).samples_);
+    BOOST_CHECK_CLOSE(3.0, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Collision).p50_, 0.001);
+    BOOST_CHECK_EQUAL(0, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::AddCars).samples_);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_accumulatingFromSeveralThreads)
+{
+    zpr::CounterValues counters = {1, 2, 3, 4};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 10000; j++) {
+                zpr::Profiler::instance().accumulate(zpr::ProfilerPhase::CameraVision, 1000);
+                zpr::Profiler::instance().accumulateCounters(zpr::ProfilerPhase::CameraVision, counters);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    zpr::Profiler::instance().commit(zpr::ProfilerPhase::Tick, zpr::ProfilerPhase::NotifyVehicles);
+    zpr::PhaseStats stats = zpr::Profiler::instance().getStats(zpr::ProfilerPhase::CameraVision);
+    BOOST_CHECK_EQUAL(1, stats.samples_);
+    BOOST_CHECK_CLOSE(40000.0, stats.p50_, 0.001);
+    BOOST_CHECK_EQUAL(1, stats.counterSamples_);
+    BOOST_CHECK_CLOSE(40000.0, stats.counters_[static_cast<int>(zpr::PerfCounter::Cycles)], 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_windowKeepsLastSamples)
+{
+    for (int i = 0; i < PROFILER_WINDOW_SIZE + 10; i++) {
+        zpr::Profiler::instance().accumulate(zpr::ProfilerPhase::Draw, 1000);
+        zpr::Profiler::instance().commit(zpr::ProfilerPhase::Draw, zpr::ProfilerPhase::Draw);
+    }
+    BOOST_CHECK_EQUAL(PROFILER_WINDOW_SIZE, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Draw).samples_);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_meanCountersPerSample)
+{
+    zpr::CounterValues counters = {1000, 2000, 10, 4};
+    zpr::Profiler::instance().accumulateCounters(zpr::ProfilerPhase::MoveVehicles, counters);
+    zpr::Profiler::instance().accumulateCounters(zpr::ProfilerPhase::MoveVehicles, counters);
+    zpr::Profiler::instance().commit(zpr::ProfilerPhase::Tick, zpr::ProfilerPhase::NotifyVehicles);
+    zpr::Profiler::instance().accumulateCounters(zpr::ProfilerPhase::MoveVehicles, counters);
+    zpr::Profiler::instance().commit(zpr::ProfilerPhase::Tick, zpr::ProfilerPhase::NotifyVehicles);
+    zpr::PhaseStats stats = zpr::Profiler::instance().getStats(zpr::ProfilerPhase::MoveVehicles);
+    BOOST_CHECK_EQUAL(2, stats.counterSamples_);
+    BOOST_CHECK_CLOSE(1500.0, stats.counters_[static_cast<int>(zpr::PerfCounter::Cycles)], 0.001);
+    BOOST_CHECK_CLOSE(6.0, stats.counters_[static_cast<int>(zpr::PerfCounter::BranchMisses)], 0.001);
+    BOOST_CHECK_EQUAL(0, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Collision).counterSamples_);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_enablingCountersStartsNewMeans)
+{
+    zpr::CounterValues counters = {1000, 2000, 10, 4};
+    zpr::Profiler::instance().accumulateCounters(zpr::ProfilerPhase::Draw, counters);
+    zpr::Profiler::instance().commit(zpr::ProfilerPhase::Draw, zpr::ProfilerPhase::Draw);
+    zpr::Profiler::instance().setCountersEnabled(true);
+    BOOST_CHECK(zpr::Profiler::instance().isCountersEnabled());
+    BOOST_CHECK_EQUAL(0, zpr::Profiler::instance().getStats(zpr::ProfilerPhase::Draw).counterSamples_);
+    zpr::Profiler::instance().setCountersEnabled(false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
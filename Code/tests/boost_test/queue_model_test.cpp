@@ -0,0 +1,81 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/queue_model.hpp"
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+    std::vector<zpr::AABB> createStraightRoad(int length)
+    {
+        std::vector<zpr::AABB> roads;
+        for (int i = 0; i < length; i++) {
+            roads.push_back(zpr::AABB::fromCenter(WORLD_CELL_SIZE * i + WORLD_CELL_SIZE / 2.f, WORLD_CELL_SIZE / 2.f, WORLD_CELL_SIZE, WORLD_CELL_SIZE));
+        }
+        return roads;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(QueueModelTest)
+
+BOOST_AUTO_TEST_CASE(QueueModel_vehicleDrivesThroughRoadInTravelTime)
+{
+    std::vector<zpr::AABB> roads = createStraightRoad(4);
+    zpr::QueueModel queue_model(roads, WORLD_CELL_SIZE, VEHICLE_SPEED, 10, 0);
+    queue_model.setDetailed(3, true);
+    BOOST_REQUIRE(queue_model.push(0, 2, {1, 0, false}));
+    std::uint64_t promotion_tick = 0;
+    int promoted_road = -1, promoted_from_road = -1;
+    sf::Vector2f promoted_position;
+    for (std::uint64_t tick = 1; tick < 100 && promotion_tick == 0; tick++) {
+        queue_model.tick(tick, [&](const zpr::QueuedVehicle&, int road, int from_road, int, sf::Vector2f position) {
+            promotion_tick = tick;
+            promoted_road = road;
+            promoted_from_road = from_road;
+            promoted_position = position;
+            return true;
+        });
+    }
+    BOOST_CHECK_EQUAL(1u + 2 * queue_model.getTravelTicks(), promotion_tick);
+    BOOST_CHECK_EQUAL(3, promoted_road);
+    BOOST_CHECK_EQUAL(2, promoted_from_road);
+    BOOST_CHECK(roads[3].contains(promoted_position));
+    BOOST_CHECK_EQUAL(0u, queue_model.getVehiclesCount());
+}
+
+BOOST_AUTO_TEST_CASE(QueueModel_fullLinkHoldsVehiclesBack)
+{
+    std::vector<zpr::AABB> roads = createStraightRoad(2);
+    zpr::QueueModel queue_model(roads, WORLD_CELL_SIZE, VEHICLE_SPEED, 10, 0);
+    queue_model.setDetailed(1, true);
+    for (int i = 0; i < QUEUE_LINK_CAPACITY; i++) {
+        BOOST_CHECK(queue_model.push(0, 2, {1, 0, false}));
+    }
+    BOOST_CHECK(!queue_model.push(0, 2, {1, 0, false}));
+    int promoted = 0;
+    for (std::uint64_t tick = 1; tick < 100; tick++) {
+        queue_model.tick(tick, [&](const zpr::QueuedVehicle&, int, int, int, sf::Vector2f) {
+            return ++promoted <= 1;
+        });
+    }
+    BOOST_CHECK_EQUAL(static_cast<std::size_t>(QUEUE_LINK_CAPACITY - 1), queue_model.getVehiclesCount());
+}
+
+BOOST_AUTO_TEST_CASE(QueueModel_vehicleTurnsBackAtDeadEnd)
+{
+    std::vector<zpr::AABB> roads = createStraightRoad(3);
+    zpr::QueueModel queue_model(roads, WORLD_CELL_SIZE, VEHICLE_SPEED, 10, 0);
+    queue_model.setDetailed(0, true);
+    BOOST_REQUIRE(queue_model.push(1, 2, {1, 0, true}));
+    int promoted_direction = -1;
+    bool is_truck = false;
+    for (std::uint64_t tick = 1; tick < 200 && promoted_direction < 0; tick++) {
+        queue_model.tick(tick, [&](const zpr::QueuedVehicle& vehicle, int, int, int direction, sf::Vector2f) {
+            promoted_direction = direction;
+            is_truck = vehicle.isTruck_;
+            return true;
+        });
+    }
+    BOOST_CHECK_EQUAL(3, promoted_direction);
+    BOOST_CHECK(is_truck);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
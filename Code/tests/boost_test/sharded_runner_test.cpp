@@ -0,0 +1,22 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../headless/sharded_runner.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(ShardedRunnerTest)
+
+BOOST_AUTO_TEST_CASE(ShardedRunner_shardedRunIsIdenticalToSingleProcessRun)
+{
+    zpr::Scenario scenario;
+    BOOST_REQUIRE(zpr::ScenarioRunner::loadScenario("demo", "SavedMaps/Demo.txt", scenario));
+    for (int shards : {2, 4}) {
+        zpr::ShardedRunner runner(1000, 2021, shards);
+        zpr::ShardedResult sharded = runner.run(scenario);
+        zpr::ShardedResult single = runner.runSingle(scenario);
+        BOOST_CHECK_EQUAL(shards, sharded.shards_);
+        BOOST_CHECK_GT(single.vehicles_ + single.exitedVehicles_, 0u);
+        BOOST_CHECK_GT(sharded.migrations_, 0u);
+        BOOST_CHECK(zpr::ShardedRunner::isIdentical(sharded, single));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
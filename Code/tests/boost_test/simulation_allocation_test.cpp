@@ -0,0 +1,63 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../simulation_handler.hpp"
+#include "../../profiling/metrics.hpp"
+#include "allocation_counter.hpp"
+#include "simulation_test_helper.hpp"
+#include <boost/test/unit_test.hpp>
+
+struct VehiclesCounter : public zpr::SimulationObserver {
+    void updateVehicles(const std::vector<std::shared_ptr<zpr::Vehicle>>& vehicles) override
+    {
+        maxVehicles_ = std::max(maxVehicles_, vehicles.size());
+    }
+    std::size_t maxVehicles_ = 0;
+};
+
+struct SimulationAllocationFixture {
+    SimulationAllocationFixture()
+    {
+        simulationHandler_ = zpr::test::createDemoSimulation();
+        vehiclesCounter_ = std::make_shared<VehiclesCounter>();
+        simulationHandler_->add(vehiclesCounter_);
+    }
+    std::shared_ptr<zpr::SimulationHandler> simulationHandler_;
+    std::shared_ptr<VehiclesCounter> vehiclesCounter_;
+    ~SimulationAllocationFixture() = default;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SimulationAllocationTest, SimulationAllocationFixture)
+
+BOOST_AUTO_TEST_CASE(SimulationAllocation_steadyStateTicksDoNotAllocate)
+{
+    for (int i = 0; i < 3000; i++) {
+        simulationHandler_->tick();
+    }
+    zpr::test::startCountingAllocations();
+    for (int i = 0; i < 3000; i++) {
+        simulationHandler_->tick();
+    }
+    long allocations_count = zpr::test::stopCountingAllocations();
+    BOOST_CHECK_EQUAL(0, allocations_count);
+    BOOST_CHECK(vehiclesCounter_->maxVehicles_ > 0);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationAllocation_recordingMetricsDoesNotAllocate)
+{
+    zpr::Metrics::instance().clear();
+    zpr::Metrics::instance().start("", METRICS_DUMP_INTERVAL);
+    for (int i = 0; i < 3000; i++) {
+        simulationHandler_->tick();
+    }
+    zpr::test::startCountingAllocations();
+    for (int i = 0; i < 3000; i++) {
+        simulationHandler_->tick();
+    }
+    long allocations_count = zpr::test::stopCountingAllocations();
+    zpr::Metrics::instance().stop();
+    BOOST_CHECK_EQUAL(0, allocations_count);
+    BOOST_CHECK_EQUAL(6000, zpr::Metrics::instance().getHistogram(zpr::Metric::TickDuration).getCount());
+    BOOST_CHECK(zpr::Metrics::instance().getHistogram(zpr::Metric::VehicleLifetime).getCount() > 0);
+    zpr::Metrics::instance().clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
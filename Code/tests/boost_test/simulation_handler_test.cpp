@@ -0,0 +1,272 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../simulation_handler.hpp"
+#include "../../helpers/city_generator.hpp"
+#include "../../helpers/converter.hpp"
+#include "simulation_test_helper.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <set>
+
+namespace {
+
+    struct SnapshotsCounter : public zpr::SimulationObserver {
+        void updateVehicles(const std::vector<std::shared_ptr<zpr::Vehicle>>& vehicles) override
+        {
+            snapshots_++;
+            vehiclesCount_ = vehicles.size();
+        }
+        int snapshots_ = 0;
+        std::size_t vehiclesCount_ = 0;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(SimulationHandlerTest)
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_eventDrivenTicksMatchCheckingEveryTick)
+{
+    std::shared_ptr<zpr::SimulationHandler> ticked = zpr::test::createDemoSimulation();
+    std::shared_ptr<zpr::SimulationHandler> event_driven = zpr::test::createDemoSimulation();
+    event_driven->setEventDriven(true);
+    int skipped_checks = 0;
+    for (std::uint64_t tick = 1; tick <= 3000; tick++) {
+        ticked->tick();
+        event_driven->tick();
+        for (const std::shared_ptr<zpr::Vehicle>& vehicle : event_driven->getVehicles()) {
+            skipped_checks += vehicle->wakeTick_ > tick;
+        }
+    }
+    zpr::test::checkSameVehicles(ticked, event_driven);
+    BOOST_CHECK_GT(skipped_checks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_eventDrivenTicksMatchOnLongStraightRoads)
+{
+    zpr::CityGenerator generator(48, 0);
+    generator.addManhattanGrid(15);
+    generator.connectEntrance();
+    std::shared_ptr<zpr::SimulationHandler> ticked = zpr::test::createSimulation(48, generator.getCells());
+    std::shared_ptr<zpr::SimulationHandler> event_driven = zpr::test::createSimulation(48, generator.getCells());
+    event_driven->setEventDriven(true);
+    for (int i = 0; i < 5000; i++) {
+        ticked->tick();
+        event_driven->tick();
+    }
+    BOOST_CHECK_GT(ticked->getExitedVehiclesCount(), 0u);
+    zpr::test::checkSameVehicles(ticked, event_driven);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_sleepingStoppedVehiclesMatchCheckingEveryTick)
+{
+    zpr::CityGenerator generator(32, 0);
+    generator.addManhattanGrid(1);
+    generator.connectEntrance();
+    std::shared_ptr<zpr::SimulationHandler> ticked = zpr::test::createSimulation(32, generator.getCells());
+    std::shared_ptr<zpr::SimulationHandler> event_driven = zpr::test::createSimulation(32, generator.getCells());
+    event_driven->setEventDriven(true);
+    int sleeping_vehicles = 0;
+    for (std::uint64_t tick = 1; tick <= 5000; tick++) {
+        ticked->tick();
+        event_driven->tick();
+        for (const std::shared_ptr<zpr::Vehicle>& vehicle : event_driven->getVehicles()) {
+            sleeping_vehicles += vehicle->wakeTick_ > tick && vehicle->speed_ == 0;
+            BOOST_REQUIRE(!vehicle->blocker_ || vehicle->wakeTick_ > tick);
+        }
+    }
+    zpr::test::checkSameVehicles(ticked, event_driven);
+    for (std::size_t i = 0; i < ticked->getVehicles().size(); i++) {
+        BOOST_CHECK_EQUAL(ticked->getVehicles()[i]->stopCounter_, event_driven->getVehicles()[i]->stopCounter_);
+    }
+    BOOST_CHECK_GT(sleeping_vehicles, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_hybridSimulationOfVisibleCityMatchesDetailedOne)
+{
+    std::shared_ptr<zpr::SimulationHandler> detailed = zpr::test::createDemoSimulation();
+    std::shared_ptr<zpr::SimulationHandler> hybrid = zpr::test::createDemoSimulation();
+    hybrid->setHybrid(true);
+    hybrid->setDetailedArea(zpr::AABB(-1000, -1000, 100000, 100000));
+    for (int i = 0; i < 3000; i++) {
+        detailed->tick();
+        hybrid->tick();
+    }
+    BOOST_CHECK_EQUAL(0u, hybrid->getQueuedVehiclesCount());
+    zpr::test::checkSameVehicles(detailed, hybrid);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_hybridSimulationKeepsVehiclesOutsideDetailedArea)
+{
+    std::shared_ptr<zpr::SimulationHandler> hybrid = zpr::test::createDemoSimulation();
+    hybrid->setHybrid(true);
+    std::size_t max_queued = 0;
+    for (int i = 0; i < 10000; i++) {
+        hybrid->tick();
+        max_queued = std::max(max_queued, hybrid->getQueuedVehiclesCount());
+        BOOST_REQUIRE_LE(hybrid->getVehicles().size() + hybrid->getQueuedVehiclesCount(), hybrid->getMaxVehicles());
+    }
+    BOOST_CHECK_GT(max_queued, 0u);
+    BOOST_CHECK_GT(hybrid->getExitedVehiclesCount(), 0u);
+    hybrid->setHybrid(false);
+    for (int i = 0; i < 2000 && hybrid->getQueuedVehiclesCount() > 0; i++) {
+        hybrid->tick();
+    }
+    BOOST_CHECK_EQUAL(0u, hybrid->getQueuedVehiclesCount());
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_cellularAutomatonMovesVehiclesThroughCity)
+{
+    std::shared_ptr<zpr::SimulationHandler> simulation = zpr::test::createDemoSimulation();
+    for (int i = 0; i < 1000; i++) {
+        simulation->tick();
+    }
+    BOOST_REQUIRE_GT(simulation->getVehicles().size(), 0u);
+    simulation->setCellularAutomaton(true);
+    for (int i = 0; i < 10000; i++) {
+        simulation->tick();
+        BOOST_REQUIRE_LE(simulation->getVehicles().size() + simulation->getAutomatonVehiclesCount(), simulation->getMaxVehicles());
+    }
+    BOOST_CHECK_GT(simulation->getAutomatonVehiclesCount(), 0u);
+    BOOST_CHECK_GT(simulation->getExitedVehiclesCount(), 0u);
+    simulation->setCellularAutomaton(false);
+    for (int i = 0; i < 2000 && simulation->getAutomatonVehiclesCount() > 0; i++) {
+        simulation->tick();
+    }
+    BOOST_CHECK_EQUAL(0u, simulation->getAutomatonVehiclesCount());
+    BOOST_CHECK_GT(simulation->getVehicles().size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_carFollowingKeepsVehiclesOfLaneApart)
+{
+    for (float time_step : {1.0f, IDM_MAX_TIME_STEP}) {
+        std::shared_ptr<zpr::SimulationHandler> simulation = zpr::test::createDemoSimulation();
+        simulation->setCarFollowing(true);
+        simulation->setTimeStep(time_step);
+        std::set<std::pair<const zpr::Vehicle*, const zpr::Vehicle*>> apart_pairs;
+        for (int i = 0; i < 3000; i++) {
+            simulation->tick();
+            const std::vector<std::shared_ptr<zpr::Vehicle>>& vehicles = simulation->getVehicles();
+            std::set<std::pair<const zpr::Vehicle*, const zpr::Vehicle*>> next_apart_pairs;
+            for (std::size_t j = 0; j < vehicles.size(); j++) {
+                for (std::size_t k = j + 1; k < vehicles.size(); k++) {
+                    if (vehicles[j]->direction_ != vehicles[k]->direction_ || !vehicles[j]->isInLane() || !vehicles[k]->isInLane()
+                        || vehicles[j]->currentRoad_ != vehicles[k]->currentRoad_) {
+                        continue;
+                    }
+                    std::pair<const zpr::Vehicle*, const zpr::Vehicle*> pair(vehicles[j].get(), vehicles[k].get());
+                    if (!vehicles[j]->getShape().intersects(vehicles[k]->getShape())) {
+                        next_apart_pairs.insert(pair);
+                    }
+                    else {
+                        BOOST_REQUIRE(apart_pairs.count(pair) == 0);
+                    }
+                }
+            }
+            apart_pairs = std::move(next_apart_pairs);
+        }
+        BOOST_CHECK_GT(simulation->getExitedVehiclesCount(), 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_longTimeStepDoesNotJumpOverCellsOrCrossingVehicles)
+{
+    std::shared_ptr<zpr::SimulationHandler> simulation = zpr::test::createDemoSimulation();
+    simulation->setCarFollowing(true);
+    simulation->setTimeStep(IDM_MAX_TIME_STEP);
+    std::map<const zpr::Vehicle*, std::pair<sf::Vector2f, std::string>> states;
+    std::set<std::pair<const zpr::Vehicle*, const zpr::Vehicle*>> apart_pairs;
+    for (int i = 0; i < 3000; i++) {
+        simulation->tick();
+        const std::vector<std::shared_ptr<zpr::Vehicle>>& vehicles = simulation->getVehicles();
+        std::map<const zpr::Vehicle*, std::pair<sf::Vector2f, std::string>> next_states;
+        for (const std::shared_ptr<zpr::Vehicle>& vehicle : vehicles) {
+            next_states[vehicle.get()] = std::make_pair(vehicle->currentRoad_->getPosition(), vehicle->direction_);
+            if (states.count(vehicle.get())) {
+                sf::Vector2f shift = vehicle->currentRoad_->getPosition() - states[vehicle.get()].first;
+                BOOST_REQUIRE_LE(std::abs(shift.x) + std::abs(shift.y), WORLD_CELL_SIZE);
+            }
+        }
+        std::set<std::pair<const zpr::Vehicle*, const zpr::Vehicle*>> next_apart_pairs;
+        for (std::size_t j = 0; j < vehicles.size(); j++) {
+            for (std::size_t k = j + 1; k < vehicles.size(); k++) {
+                if ((vehicles[j]->getStep().x == 0) == (vehicles[k]->getStep().x == 0)) {
+                    continue;
+                }
+                std::pair<const zpr::Vehicle*, const zpr::Vehicle*> pair(vehicles[j].get(), vehicles[k].get());
+                if (!vehicles[j]->getShape().intersects(vehicles[k]->getShape())) {
+                    next_apart_pairs.insert(pair);
+                }
+                else if (states[pair.first].second == pair.first->direction_ && states[pair.second].second == pair.second->direction_) {
+                    BOOST_REQUIRE(apart_pairs.count(pair) == 0);
+                }
+            }
+        }
+        states = std::move(next_states);
+        apart_pairs = std::move(next_apart_pairs);
+    }
+    BOOST_CHECK_GT(simulation->getExitedVehiclesCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_mortonOrderSortsVehiclesByCells)
+{
+    zpr::CityGenerator generator(32, 0);
+    generator.addManhattanGrid(3);
+    generator.connectEntrance();
+    std::shared_ptr<zpr::SimulationHandler> simulation = zpr::test::createSimulation(32, generator.getCells());
+    simulation->setMortonOrder(true);
+    zpr::Converter converter(32, WORLD_CELL_SIZE);
+    for (int sort = 0; sort < 20; sort++) {
+        for (int i = 0; i < VEHICLES_SORT_TICKS - 1; i++) {
+            simulation->tick();
+        }
+        std::map<std::uint32_t, std::uint32_t> codes;
+        for (const std::shared_ptr<zpr::Vehicle>& vehicle : simulation->getVehicles()) {
+            codes[vehicle->handle_] = converter.getMortonCode(vehicle->getShape().getPosition());
+        }
+        simulation->tick();
+        std::uint32_t previous_code = 0;
+        std::set<std::uint32_t> sorted;
+        const zpr::Vehicle* previous_car = nullptr;
+        const zpr::Vehicle* previous_truck = nullptr;
+        for (const std::shared_ptr<zpr::Vehicle>& vehicle : simulation->getVehicles()) {
+            BOOST_REQUIRE(sorted.insert(vehicle->handle_).second);
+            BOOST_REQUIRE_EQUAL(vehicle.get(), simulation->getVehicle(vehicle->handle_).get());
+            const zpr::Vehicle*& previous = vehicle->isTruck() ? previous_truck : previous_car;
+            BOOST_REQUIRE(!previous || std::less<const zpr::Vehicle*>()(previous, vehicle.get()));
+            previous = vehicle.get();
+            std::map<std::uint32_t, std::uint32_t>::const_iterator code = codes.find(vehicle->handle_);
+            if (code != codes.end()) {
+                BOOST_REQUIRE_LE(previous_code, code->second);
+                previous_code = code->second;
+            }
+        }
+    }
+    BOOST_CHECK_GT(simulation->getVehicles().size(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_fastForwardNotifiesAboutLastTickOnly)
+{
+    std::shared_ptr<zpr::SimulationHandler> simulation = zpr::test::createDemoSimulation();
+    std::shared_ptr<zpr::SimulationHandler> reference = zpr::test::createDemoSimulation();
+    std::shared_ptr<SnapshotsCounter> counter = std::make_shared<SnapshotsCounter>();
+    simulation->add(counter);
+    simulation->setTimeScale(0);
+    simulation->runTicks();
+    BOOST_REQUIRE_GT(simulation->getTicksCount(), 1u);
+    BOOST_CHECK_EQUAL(1, counter->snapshots_);
+    while (reference->getTicksCount() < simulation->getTicksCount()) {
+        reference->tick();
+    }
+    zpr::test::checkSameVehicles(reference, simulation);
+    BOOST_CHECK_EQUAL(reference->getVehicles().size(), counter->vehiclesCount_);
+}
+
+BOOST_AUTO_TEST_CASE(SimulationHandler_timeScalesCycle)
+{
+    BOOST_CHECK_EQUAL(10, zpr::SimulationHandler::getNextTimeScale(1));
+    BOOST_CHECK_EQUAL(100, zpr::SimulationHandler::getNextTimeScale(10));
+    BOOST_CHECK_EQUAL(0, zpr::SimulationHandler::getNextTimeScale(100));
+    BOOST_CHECK_EQUAL(1, zpr::SimulationHandler::getNextTimeScale(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
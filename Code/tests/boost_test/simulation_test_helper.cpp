@@ -0,0 +1,59 @@
+/**
+ * simulation_test_helper.cpp
+ * Implementation of functions shared by tests of the simulation.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include "simulation_test_helper.hpp"
+#include "../../headless/scenario_runner.hpp"
+#include <boost/test/unit_test.hpp>
+
+namespace zpr {
+    namespace test {
+
+        /**
+         * Function creating prepared simulation of the city, the same way headless scenarios are created.
+         * @param grid_size - Size of the grid.
+         * @param cells - Cells of the city.
+         * @param threads - Number of threads moving vehicles.
+         * @return - Prepared simulation with seed 2021.
+         */
+        std::shared_ptr<SimulationHandler> createSimulation(int grid_size, const std::vector<Cell>& cells, int threads)
+        {
+            std::shared_ptr<SimulationHandler> simulation_handler = ScenarioRunner::createSimulation(Scenario{"", grid_size, cells}, 2021);
+            simulation_handler->setThreadsCount(threads);
+            return simulation_handler;
+        }
+
+        /**
+         * Function creating prepared simulation of the demo map.
+         * @param threads - Number of threads moving vehicles.
+         * @return - Prepared simulation with seed 2021.
+         */
+        std::shared_ptr<SimulationHandler> createDemoSimulation(int threads)
+        {
+            Scenario scenario;
+            BOOST_REQUIRE(ScenarioRunner::loadScenario("demo", "SavedMaps/Demo.txt", scenario));
+            return createSimulation(scenario.gridSize_, scenario.cells_, threads);
+        }
+
+        /**
+         * Function checking that both simulations have the same vehicles in the same places, and exited the same vehicles.
+         * @param expected - Reference simulation.
+         * @param actual - Checked simulation.
+         */
+        void checkSameVehicles(const std::shared_ptr<SimulationHandler>& expected, const std::shared_ptr<SimulationHandler>& actual)
+        {
+            BOOST_CHECK_EQUAL(expected->getExitedVehiclesCount(), actual->getExitedVehiclesCount());
+            BOOST_CHECK_EQUAL(expected->getExitedVehiclesTicks(), actual->getExitedVehiclesTicks());
+            BOOST_REQUIRE_EQUAL(expected->getVehicles().size(), actual->getVehicles().size());
+            for (std::size_t i = 0; i < expected->getVehicles().size(); i++) {
+                BOOST_CHECK(expected->getVehicles()[i]->getShape() == actual->getVehicles()[i]->getShape());
+                BOOST_CHECK_EQUAL(expected->getVehicles()[i]->direction_, actual->getVehicles()[i]->direction_);
+                for (int j = 0; j < CAMERAS_COUNT; j++) {
+                    BOOST_CHECK_EQUAL(expected->getVehicles()[i]->seenByCamera_[j], actual->getVehicles()[i]->seenByCamera_[j]);
+                }
+            }
+        }
+    }
+}
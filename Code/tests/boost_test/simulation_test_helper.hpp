@@ -0,0 +1,18 @@
+/**
+ * simulation_test_helper.hpp
+ * Header of functions shared by tests of the simulation.
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+#include "../../simulation_handler.hpp"
+#include "../../components/cell.hpp"
+
+namespace zpr {
+    namespace test {
+        std::shared_ptr<SimulationHandler> createSimulation(int grid_size, const std::vector<Cell>& cells, int threads = 1);
+        std::shared_ptr<SimulationHandler> createDemoSimulation(int threads = 1);
+        void checkSameVehicles(const std::shared_ptr<SimulationHandler>& expected, const std::shared_ptr<SimulationHandler>& actual);
+    }
+}
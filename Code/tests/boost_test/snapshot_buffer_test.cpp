@@ -0,0 +1,50 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../components/snapshot_buffer.hpp"
+#include "../../vehicles/car.hpp"
+#include "../../vehicles/truck.hpp"
+#include <boost/test/unit_test.hpp>
+
+struct SnapshotBufferFixture {
+    SnapshotBufferFixture()
+    {
+        roads_.push_back(zpr::AABB::fromCenter(25, 25, 51, 51));
+        vehicles_.push_back(std::make_shared<zpr::Car>(20, 20, 51, roads_, "South"));
+        vehicles_.push_back(std::make_shared<zpr::Truck>(30, 30, 51, roads_, "East"));
+    }
+    std::vector<zpr::AABB> roads_;
+    std::vector<std::shared_ptr<zpr::Vehicle>> vehicles_;
+    zpr::SnapshotBuffer buffer_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SnapshotBufferTest, SnapshotBufferFixture)
+
+BOOST_AUTO_TEST_CASE(SnapshotBuffer_emptyBeforeWrite)
+{
+    BOOST_CHECK(buffer_.read().empty());
+}
+
+BOOST_AUTO_TEST_CASE(SnapshotBuffer_readKeepsStateOfWrite)
+{
+    sf::Vector2f car_position = vehicles_[0]->getShape().getPosition();
+    buffer_.write(vehicles_);
+    vehicles_[0]->reset(40, 40, "North", 0);
+    const std::vector<zpr::VehicleSnapshot>& snapshots = buffer_.read();
+    BOOST_REQUIRE_EQUAL(2u, snapshots.size());
+    BOOST_CHECK(car_position == snapshots[0].position_);
+    BOOST_CHECK_EQUAL(vehicles_[0]->color_.r, snapshots[0].color_.r);
+    BOOST_CHECK_EQUAL(vehicles_[1]->color_.b, snapshots[1].color_.b);
+    BOOST_CHECK(vehicles_[1]->size_ == snapshots[1].size_);
+}
+
+BOOST_AUTO_TEST_CASE(SnapshotBuffer_drawnSnapshotChangesOnlyOnRead)
+{
+    buffer_.write(vehicles_);
+    const std::vector<zpr::VehicleSnapshot>& snapshots = buffer_.read();
+    vehicles_.pop_back();
+    buffer_.write(vehicles_);
+    BOOST_CHECK_EQUAL(2u, snapshots.size());
+    BOOST_CHECK_EQUAL(1u, buffer_.read().size());
+    BOOST_CHECK_EQUAL(1u, buffer_.read().size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
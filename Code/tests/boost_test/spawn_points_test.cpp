@@ -17,8 +17,8 @@ struct SpawnPointsFixture {
     std::unique_ptr<zpr::SpawnPoints> spawnPoints32_;
     int gridSize_= 16;
     int gridSize32_= 32;
-    std::vector<sf::RectangleShape> roads_;
-    std::vector<sf::RectangleShape> exitSites_;
+    std::vector<zpr::AABB> roads_;
+    std::vector<zpr::AABB> exitSites_;
 	~SpawnPointsFixture() = default;
     
 };
@@ -0,0 +1,33 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../simulation_handler.hpp"
+#include "../../components/tile_scheduler.hpp"
+#include "simulation_test_helper.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(TileSchedulerTest)
+
+BOOST_AUTO_TEST_CASE(TileScheduler_tilesSplitEquallyBeforeMeasuring)
+{
+    zpr::TileScheduler tile_scheduler(4 * TILE_CELLS, WORLD_CELL_SIZE, 0, 2);
+    BOOST_CHECK_EQUAL(4, tile_scheduler.getTilesPerSide());
+    int first_worker_tiles = 0;
+    for (int i = 0; i < 16; i++) {
+        first_worker_tiles += tile_scheduler.getOwner(i) == 0;
+    }
+    BOOST_CHECK_EQUAL(8, first_worker_tiles);
+    BOOST_CHECK_EQUAL(0, tile_scheduler.getOwner(0));
+    BOOST_CHECK_EQUAL(1, tile_scheduler.getOwner(15));
+}
+
+BOOST_AUTO_TEST_CASE(TileScheduler_threadedTicksMatchSingleThread)
+{
+    std::shared_ptr<zpr::SimulationHandler> single = zpr::test::createDemoSimulation(1);
+    std::shared_ptr<zpr::SimulationHandler> tiled = zpr::test::createDemoSimulation(3);
+    for (int i = 0; i < 3000; i++) {
+        single->tick();
+        tiled->tick();
+    }
+    zpr::test::checkSameVehicles(single, tiled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../profiling/tracer.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+struct TracerFixture {
+    TracerFixture()
+    {
+        zpr::Tracer::instance().stop();
+        zpr::Tracer::instance().clear();
+    }
+    ~TracerFixture()
+    {
+        zpr::Tracer::instance().stop();
+        zpr::Tracer::instance().clear();
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TracerTest, TracerFixture)
+
+BOOST_AUTO_TEST_CASE(Tracer_nothingRecordedWhenStopped)
+{
+    {
+        zpr::TraceScope scope("Stopped");
+    }
+    BOOST_CHECK_EQUAL(0, zpr::Tracer::instance().getEventsCount());
+}
+
+BOOST_AUTO_TEST_CASE(Tracer_eventsOfEveryThread)
+{
+    zpr::Tracer::instance().start("");
+    zpr::Tracer::instance().setThreadName("Test main");
+    {
+        zpr::TraceScope scope("Main event");
+    }
+    std::thread worker([]() {
+        zpr::Tracer::instance().setThreadName("Test worker");
+        zpr::TraceScope scope("Worker event");
+    });
+    worker.join();
+    BOOST_CHECK_EQUAL(2, zpr::Tracer::instance().getEventsCount());
+
+    std::ostringstream stream;
+    zpr::Tracer::instance().writeJson(stream);
+    std::string json = stream.str();
+    BOOST_CHECK_EQUAL(0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    BOOST_CHECK(json.find("\"name\":\"Main event\",\"ph\":\"X\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"name\":\"Worker event\",\"ph\":\"X\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"args\":{\"name\":\"Test main\"}") != std::string::npos);
+    BOOST_CHECK(json.find("\"args\":{\"name\":\"Test worker\"}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Tracer_fullBufferDropsEvents)
+{
+    zpr::Tracer::instance().start("");
+    std::thread worker([]() {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        for (int i = 0; i < TRACER_BUFFER_SIZE + 5; i++) {
+            zpr::Tracer::instance().record("Event", now, now);
+        }
+    });
+    worker.join();
+    BOOST_CHECK_EQUAL(TRACER_BUFFER_SIZE, zpr::Tracer::instance().getEventsCount());
+    BOOST_CHECK_EQUAL(5, zpr::Tracer::instance().getDroppedCount());
+}
+
+BOOST_AUTO_TEST_CASE(Tracer_stopWritesFile)
+{
+    zpr::Tracer::instance().start("tracer_test.json");
+    {
+        zpr::TraceScope scope("Written event");
+    }
+    BOOST_CHECK(zpr::Tracer::instance().stop());
+    std::ifstream file("tracer_test.json");
+    std::stringstream content;
+    content << file.rdbuf();
+    BOOST_CHECK(content.str().find("Written event") != std::string::npos);
+    file.close();
+    std::remove("tracer_test.json");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+#define BOOST_TEST_DYN_LINK
+#include "../../vehicles/vehicle_store.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(VehicleStoreTest)
+
+BOOST_AUTO_TEST_CASE(VehicleStore_reorderMovesVehiclesToSlotsInOrderAndKeepsHandles)
+{
+    std::vector<zpr::AABB> roads;
+    std::shared_ptr<zpr::VehicleStore> store = zpr::VehicleStore::create(4, 2, WORLD_CELL_SIZE, roads);
+    std::vector<std::shared_ptr<zpr::Vehicle>> cars_pool, trucks_pool, vehicles;
+    store->fillPools(cars_pool, trucks_pool);
+    BOOST_REQUIRE_EQUAL(4u, cars_pool.size());
+    BOOST_REQUIRE_EQUAL(2u, trucks_pool.size());
+    for (int i = 0; i < 3; i++) {
+        vehicles.push_back(cars_pool.back());
+        cars_pool.pop_back();
+        vehicles.back()->x_ = 10 + i;
+    }
+    vehicles.push_back(trucks_pool.back());
+    trucks_pool.pop_back();
+    vehicles.back()->x_ = 20;
+    std::vector<std::uint32_t> handles;
+    for (const std::shared_ptr<zpr::Vehicle>& vehicle : vehicles) {
+        handles.push_back(vehicle->handle_);
+    }
+    const zpr::Vehicle* first_car = cars_pool.front().get();
+
+    BOOST_REQUIRE(store->reorder(vehicles, cars_pool, trucks_pool));
+
+    BOOST_CHECK_EQUAL(first_car, vehicles[0].get());
+    BOOST_CHECK_EQUAL(first_car + 1, vehicles[1].get());
+    BOOST_CHECK_EQUAL(first_car + 2, vehicles[2].get());
+    for (std::size_t i = 0; i < vehicles.size(); i++) {
+        BOOST_CHECK_EQUAL(handles[i], vehicles[i]->handle_);
+        BOOST_CHECK_EQUAL(vehicles[i].get(), store->getVehicle(handles[i]).get());
+    }
+    BOOST_CHECK_EQUAL(10, vehicles[0]->x_);
+    BOOST_CHECK_EQUAL(12, vehicles[2]->x_);
+    BOOST_CHECK_EQUAL(20, vehicles[3]->x_);
+    BOOST_CHECK(vehicles[3]->isTruck());
+    BOOST_CHECK(!vehicles[0]->isTruck());
+    BOOST_CHECK_EQUAL(first_car + 3, cars_pool[0].get());
+}
+
+BOOST_AUTO_TEST_CASE(VehicleStore_reorderWithoutEveryVehicleMovesNothing)
+{
+    std::vector<zpr::AABB> roads;
+    std::shared_ptr<zpr::VehicleStore> store = zpr::VehicleStore::create(2, 1, WORLD_CELL_SIZE, roads);
+    std::vector<std::shared_ptr<zpr::Vehicle>> cars_pool, trucks_pool, vehicles;
+    store->fillPools(cars_pool, trucks_pool);
+    vehicles.push_back(cars_pool.back());
+    cars_pool.clear();
+    const zpr::Vehicle* vehicle = vehicles[0].get();
+
+    BOOST_CHECK(!store->reorder(vehicles, cars_pool, trucks_pool));
+
+    BOOST_CHECK_EQUAL(vehicle, vehicles[0].get());
+    BOOST_CHECK_EQUAL(1u, vehicles[0]->handle_);
+}
+
+BOOST_AUTO_TEST_CASE(VehicleStore_vehiclesKeepStoreAlive)
+{
+    std::vector<zpr::AABB> roads;
+    std::shared_ptr<zpr::VehicleStore> store = zpr::VehicleStore::create(1, 0, WORLD_CELL_SIZE, roads);
+    std::vector<std::shared_ptr<zpr::Vehicle>> cars_pool, trucks_pool;
+    store->fillPools(cars_pool, trucks_pool);
+    std::weak_ptr<zpr::VehicleStore> weak_store = store;
+    store.reset();
+
+    BOOST_CHECK(!weak_store.expired());
+    cars_pool.clear();
+    BOOST_CHECK(weak_store.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,19 +12,18 @@ struct VehicleTestFixture {
 		initRoads();
 		car_ = std::make_unique <zpr::Car>(20, 20, 51, roads, "South");
 		truck_ = std::make_unique <zpr::Truck>(20, 20, 51, roads, "South");
-		car_->currentRoad_ = std::make_shared<sf::RectangleShape>(roads.at(0));
-		truck_->currentRoad_ = std::make_shared<sf::RectangleShape>(roads.at(0));
+		car_->currentRoad_ = &roads.at(0);
+		truck_->currentRoad_ = &roads.at(0);
 	}
 	void initRoads() {
+		// Vehicles take position of a road as its center, so roads are centered at the positions of the original
+		// sf::RectangleShape roads, which lanes of these tests are computed from.
 		for (int i = 0; i < 20; i++) {
-			sf::RectangleShape road;
-			road.setPosition(sf::Vector2f(i % 4 * 51, i / 5 * 51));
-			road.setSize(sf::Vector2f(51, 51));
-			roads.push_back(road);
+			roads.push_back(zpr::AABB::fromCenter(i % 4 * 51, i / 5 * 51, 51, 51));
 		}
 	}
 	~VehicleTestFixture() = default;
-	std::vector<sf::RectangleShape> roads;
+	std::vector<zpr::AABB> roads;
 	std::shared_ptr<zpr::Vehicle> car_;
 	std::shared_ptr<zpr::Vehicle> truck_;
 };
@@ -48,8 +47,8 @@ BOOST_AUTO_TEST_CASE(Vehicle_speedTest) {
 }
 
 BOOST_AUTO_TEST_CASE(Vehicle_roadsTest) {
-	BOOST_CHECK_EQUAL(20, car_->roads_.size());
-	BOOST_CHECK_EQUAL(20, truck_->roads_.size());
+	BOOST_CHECK_EQUAL(20, car_->roads_->size());
+	BOOST_CHECK_EQUAL(20, truck_->roads_->size());
 }
 
 BOOST_AUTO_TEST_CASE(Vehicle_cellSizeTest) {
@@ -178,12 +177,40 @@ BOOST_AUTO_TEST_CASE(Vehicle_checkVehicleStoppedTest) {
 }
 
 BOOST_AUTO_TEST_CASE(Vehicle_colisionTest) {
-	truck_->shape_.setPosition(20, 40);
+	truck_->shape_.moveCenterTo(20, 40);
 	BOOST_CHECK_EQUAL(true, car_->checkColision(truck_));
-	truck_->shape_.setPosition(100, 100);
+	truck_->shape_.moveCenterTo(100, 100);
 	BOOST_CHECK_EQUAL(false, car_->checkColision(truck_));
 }
 
+BOOST_AUTO_TEST_CASE(Vehicle_boxRotatesWithDirection) {
+	truck_->direction_ = "East";
+	truck_->move();
+	BOOST_CHECK_EQUAL(20, truck_->getShape().getSize().x);
+	BOOST_CHECK_EQUAL(14, truck_->getShape().getSize().y);
+	BOOST_CHECK_EQUAL(truck_->x_, truck_->getShape().getPosition().x);
+	BOOST_CHECK_EQUAL(truck_->y_, truck_->getShape().getPosition().y);
+}
+
+BOOST_AUTO_TEST_CASE(Vehicle_cellExitDistanceTest) {
+	for (const char* direction : {"North", "South", "East", "West"}) {
+		car_->direction_ = direction;
+		car_->x_ = 20;
+		car_->y_ = 20;
+		car_->stopVehicle();
+		car_->move();
+		int distance = car_->getCellExitDistance();
+		BOOST_CHECK_GE(distance, 1);
+		car_->speed_ = distance - 1;
+		car_->move();
+		BOOST_CHECK(car_->currentRoad_->contains(car_->getShape().getPosition()));
+		BOOST_CHECK_EQUAL(1, car_->getCellExitDistance());
+		car_->speed_ = 1;
+		car_->move();
+		BOOST_CHECK(!car_->currentRoad_->contains(car_->getShape().getPosition()));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(Vehicle_noColisionTest) {
 	car_->stopVehicle();
 	BOOST_CHECK_EQUAL(0, car_->speed_);
@@ -192,7 +219,7 @@ BOOST_AUTO_TEST_CASE(Vehicle_noColisionTest) {
 }
 
 BOOST_AUTO_TEST_CASE(Vehicle_unblockVehicleTest) {
-	car_->currentRoad_ = std::make_shared<sf::RectangleShape>(roads.at(6));
+	car_->currentRoad_ = &roads.at(6);
 	car_->stopCounter_ = 200;
 	car_->speed_ = 0;
 	BOOST_CHECK_EQUAL("South", car_->direction_);
@@ -201,4 +228,23 @@ BOOST_AUTO_TEST_CASE(Vehicle_unblockVehicleTest) {
 	BOOST_CHECK_EQUAL(0, car_->stopCounter_);
 }
 
+BOOST_AUTO_TEST_CASE(Vehicle_unblockThresholdTest) {
+	car_->currentRoad_ = &roads.at(6);
+	car_->unblockTicks_ = 300;
+	car_->stopCounter_ = 200;
+	car_->speed_ = 0;
+	car_->unblockVehicle();
+	BOOST_CHECK_EQUAL("South", car_->direction_);
+	BOOST_CHECK_EQUAL(200, car_->stopCounter_);
+}
+
+BOOST_AUTO_TEST_CASE(Vehicle_maxSpeedTest) {
+	car_->maxSpeed_ = 5;
+	car_->stopVehicle();
+	car_->noColision();
+	BOOST_CHECK_EQUAL(5, car_->speed_);
+	car_->reset(20, 20, "South", 1);
+	BOOST_CHECK_EQUAL(5, car_->speed_);
+}
+
 BOOST_AUTO_TEST_SUITE_END()